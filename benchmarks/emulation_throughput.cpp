@@ -0,0 +1,131 @@
+/* *****************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2013 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details.
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ *  emulation_throughput.cpp
+ *
+ *  Measures raw emulation throughput (frames/sec and emulated MIPS) for one
+ *  or more ROMs and CPU cores.
+ *
+ *  Usage: ale-benchmark [--cpu low|high|both] [--frames N] [--seed S] rom...
+ *
+ **************************************************************************** */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "ale/ale_interface.hpp"
+
+namespace {
+
+struct Result {
+  uint64_t frames;
+  uint64_t instructions;
+  uint64_t cycles;
+  int scanlines;
+  double seconds;
+};
+
+// Plays uniformly random minimal-set actions for `num_frames` emulated frames.
+Result run(const std::string& rom, const std::string& cpu, uint64_t num_frames,
+           int seed) {
+  ale::ALEInterface ale;
+  ale.setString("cpu", cpu);
+  ale.setInt("random_seed", seed);
+  ale.setFloat("repeat_action_probability", 0.0);
+  ale.loadROM(rom);
+
+  const ale::ActionVect actions = ale.getMinimalActionSet();
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<size_t> pick(0, actions.size() - 1);
+
+  const uint64_t frames0 = ale.getEmulatedFrameCount();
+  const uint64_t instructions0 = ale.getInstructionCount();
+  const uint64_t cycles0 = ale.getCycleCount();
+
+  const auto start = std::chrono::steady_clock::now();
+  while (ale.getEmulatedFrameCount() - frames0 < num_frames) {
+    ale.act(actions[pick(rng)]);
+    if (ale.game_over()) ale.reset_game();
+  }
+  const auto stop = std::chrono::steady_clock::now();
+
+  return {ale.getEmulatedFrameCount() - frames0,
+          ale.getInstructionCount() - instructions0,
+          ale.getCycleCount() - cycles0, ale.getScanlinesPerFrame(),
+          std::chrono::duration<double>(stop - start).count()};
+}
+
+void usage(const char* argv0) {
+  std::cerr << "Usage: " << argv0
+            << " [--cpu low|high|both] [--frames N] [--seed S] rom..."
+            << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::vector<std::string> cpus = {"low", "high"};
+  std::vector<std::string> roms;
+  uint64_t num_frames = 20000;
+  int seed = 0;
+
+  for (int i = 1; i < argc; i++) {
+    const std::string arg = argv[i];
+    if ((arg == "--cpu" || arg == "--frames" || arg == "--seed") && i + 1 < argc) {
+      const std::string value = argv[++i];
+      if (arg == "--cpu")
+        cpus = value == "both" ? std::vector<std::string>{"low", "high"}
+                               : std::vector<std::string>{value};
+      else if (arg == "--frames")
+        num_frames = std::strtoull(value.c_str(), nullptr, 10);
+      else
+        seed = std::atoi(value.c_str());
+    } else if (arg.rfind("--", 0) == 0) {
+      usage(argv[0]);
+      return 1;
+    } else {
+      roms.push_back(arg);
+    }
+  }
+  if (roms.empty()) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  ale::Logger::setMode(ale::Logger::Error);
+
+  std::cout << std::left << std::setw(24) << "rom" << std::setw(6) << "cpu"
+            << std::right << std::setw(10) << "frames" << std::setw(12)
+            << "fps" << std::setw(10) << "MIPS" << std::setw(14)
+            << "cycles/frame" << std::setw(11) << "scanlines" << std::endl;
+
+  for (const std::string& rom : roms) {
+    for (const std::string& cpu : cpus) {
+      const Result r = run(rom, cpu, num_frames, seed);
+      std::string name = rom.substr(rom.find_last_of("/\\") + 1);
+      std::cout << std::left << std::setw(24) << name << std::setw(6) << cpu
+                << std::right << std::setw(10) << r.frames << std::fixed
+                << std::setprecision(1) << std::setw(12)
+                << r.frames / r.seconds << std::setprecision(2)
+                << std::setw(10) << r.instructions / r.seconds / 1e6
+                << std::setprecision(0) << std::setw(14)
+                << double(r.cycles) / r.frames << std::setw(11)
+                << r.scanlines << std::endl;
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,164 @@
+/* *****************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2013 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details.
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ *  idle_loop_check.cpp
+ *
+ *  Checks that fast-forwarding RIOT timer polling loops ("skip_idle_loops")
+ *  is bit-exact: each ROM is played with the setting on and off under the
+ *  same random actions, and the two runs are compared after every step.
+ *  Also reports the speed-up of the fast-forwarded run.
+ *
+ *  Usage: ale-idle-loop-check [--frames N] [--seed S] rom...
+ *
+ **************************************************************************** */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "ale/ale_interface.hpp"
+
+namespace {
+
+void configure(ale::ALEInterface& ale, bool skip_idle_loops, int seed) {
+  ale.setString("cpu", "low");
+  ale.setBool("skip_idle_loops", skip_idle_loops);
+  ale.setInt("random_seed", seed);
+  ale.setFloat("repeat_action_probability", 0.0);
+}
+
+// Returns the first difference between the two environments, or an empty
+// string if they are in the same state.
+std::string compare(ale::ALEInterface& fast, ale::ALEInterface& exact) {
+  if (fast.getCycleCount() != exact.getCycleCount()) return "cycle count";
+  if (fast.getInstructionCount() != exact.getInstructionCount())
+    return "instruction count";
+  if (fast.game_over() != exact.game_over()) return "terminal";
+  if (!fast.getRAM().equals(exact.getRAM())) return "RAM";
+  if (!fast.getScreen().equals(exact.getScreen())) return "screen";
+  if (fast.stateHash() != exact.stateHash()) return "state hash";
+  return "";
+}
+
+// Plays both environments in lockstep and returns the first divergence.
+std::string check(const std::string& rom, uint64_t num_frames, int seed,
+                  uint64_t* frames) {
+  ale::ALEInterface fast, exact;
+  configure(fast, true, seed);
+  configure(exact, false, seed);
+  fast.loadROM(rom);
+  exact.loadROM(rom);
+
+  const ale::ActionVect actions = fast.getMinimalActionSet();
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<size_t> pick(0, actions.size() - 1);
+
+  std::string diff = compare(fast, exact);
+  for (*frames = 0; diff.empty() && *frames < num_frames; ++*frames) {
+    const ale::Action action = actions[pick(rng)];
+    if (fast.act(action) != exact.act(action)) {
+      diff = "reward";
+    } else {
+      diff = compare(fast, exact);
+    }
+    if (diff.empty() && fast.game_over()) {
+      fast.reset_game();
+      exact.reset_game();
+      diff = compare(fast, exact);
+    }
+  }
+  // The serialized states also cover the TIA and cartridge internals
+  if (diff.empty() &&
+      fast.cloneSystemState().serialize() != exact.cloneSystemState().serialize())
+    diff = "serialized state";
+  return diff;
+}
+
+// Returns the time taken to play num_frames random actions.
+double elapsed(const std::string& rom, bool skip_idle_loops, uint64_t num_frames,
+            int seed) {
+  ale::ALEInterface ale;
+  configure(ale, skip_idle_loops, seed);
+  ale.loadROM(rom);
+
+  const ale::ActionVect actions = ale.getMinimalActionSet();
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<size_t> pick(0, actions.size() - 1);
+
+  const auto start = std::chrono::steady_clock::now();
+  for (uint64_t i = 0; i < num_frames; i++) {
+    ale.act(actions[pick(rng)]);
+    if (ale.game_over()) ale.reset_game();
+  }
+  const auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(stop - start).count();
+}
+
+void usage(const char* argv0) {
+  std::cerr << "Usage: " << argv0 << " [--frames N] [--seed S] rom..."
+            << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::vector<std::string> roms;
+  uint64_t num_frames = 20000;
+  int seed = 0;
+
+  for (int i = 1; i < argc; i++) {
+    const std::string arg = argv[i];
+    if ((arg == "--frames" || arg == "--seed") && i + 1 < argc) {
+      const std::string value = argv[++i];
+      if (arg == "--frames")
+        num_frames = std::strtoull(value.c_str(), nullptr, 10);
+      else
+        seed = std::atoi(value.c_str());
+    } else if (arg.rfind("--", 0) == 0) {
+      usage(argv[0]);
+      return 1;
+    } else {
+      roms.push_back(arg);
+    }
+  }
+  if (roms.empty()) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  ale::Logger::setMode(ale::Logger::Error);
+
+  std::cout << std::left << std::setw(24) << "rom" << std::right
+            << std::setw(10) << "frames" << std::setw(24) << "result"
+            << std::setw(10) << "speedup" << std::endl;
+
+  int failures = 0;
+  for (const std::string& rom : roms) {
+    uint64_t frames = 0;
+    const std::string diff = check(rom, num_frames, seed, &frames);
+    const double speedup = elapsed(rom, false, num_frames, seed) /
+                           elapsed(rom, true, num_frames, seed);
+
+    std::string name = rom.substr(rom.find_last_of("/\\") + 1);
+    std::cout << std::left << std::setw(24) << name << std::right
+              << std::setw(10) << frames << std::setw(24)
+              << (diff.empty() ? "bit-exact" : "differs: " + diff)
+              << std::fixed << std::setprecision(2) << std::setw(9) << speedup
+              << "x" << std::endl;
+    if (!diff.empty()) failures++;
+  }
+
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,121 @@
+/* *****************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2013 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details.
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ *  ale_async_batch.cpp
+ *
+ *  Steps an ALEBatch on worker threads.
+ *
+ **************************************************************************** */
+
+#include "ale/ale_async_batch.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace ale {
+
+ALEAsyncBatch::ALEAsyncBatch(std::vector<ALEInterface*> envs, ObsType obs_type,
+                             bool autoreset, size_t num_threads)
+    : m_batch(std::move(envs), obs_type, autoreset),
+      m_write(0),
+      m_actions(m_batch.size(), PLAYER_A_NOOP),
+      m_pending(false),
+      m_remaining(0) {
+  for (Buffers& buffers : m_buffers) {
+    buffers.obs.resize(m_batch.size() * m_batch.observationSize());
+    buffers.rewards.resize(m_batch.size());
+    buffers.dones.reset(new bool[m_batch.size()]());
+  }
+
+  if (num_threads == 0) {
+    num_threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  m_pool.reset(new ThreadPool(std::min(num_threads, m_batch.size())));
+}
+
+ALEAsyncBatch::~ALEAsyncBatch() {
+  if (m_pending) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done_cv.wait(lock, [this] { return m_remaining == 0; });
+  }
+}
+
+ALEAsyncBatch::Result ALEAsyncBatch::reset() {
+  if (m_pending) {
+    throw std::runtime_error("ALEAsyncBatch::reset called while a step is pending.");
+  }
+  dispatch([this](size_t i, Buffers& buffers) {
+    m_batch.reset(i, buffers.obs.data() + i * m_batch.observationSize());
+    buffers.rewards[i] = 0;
+    buffers.dones[i] = false;
+  });
+  return collect();
+}
+
+void ALEAsyncBatch::stepAsync(const Action* actions) {
+  if (m_pending) {
+    throw std::runtime_error("ALEAsyncBatch::stepAsync called while a step is pending.");
+  }
+  std::copy(actions, actions + m_batch.size(), m_actions.begin());
+  dispatch([this](size_t i, Buffers& buffers) {
+    m_batch.step(i, m_actions[i],
+                 buffers.obs.data() + i * m_batch.observationSize(),
+                 &buffers.rewards[i], &buffers.dones[i]);
+  });
+}
+
+ALEAsyncBatch::Result ALEAsyncBatch::stepWait() {
+  if (!m_pending) {
+    throw std::runtime_error("ALEAsyncBatch::stepWait called without a pending step.");
+  }
+  return collect();
+}
+
+void ALEAsyncBatch::dispatch(std::function<void(size_t, Buffers&)> job) {
+  m_job = std::move(job);
+  m_error = nullptr;
+  m_remaining = m_batch.size();
+  m_pending = true;
+
+  Buffers& buffers = m_buffers[m_write];
+  for (size_t i = 0; i < m_batch.size(); i++) {
+    m_pool->submit([this, i, &buffers] {
+      std::exception_ptr error;
+      try {
+        m_job(i, buffers);
+      } catch (...) {
+        error = std::current_exception();
+      }
+
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (error && !m_error) m_error = error;
+      if (--m_remaining == 0) m_done_cv.notify_all();
+    });
+  }
+}
+
+ALEAsyncBatch::Result ALEAsyncBatch::collect() {
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done_cv.wait(lock, [this] { return m_remaining == 0; });
+  }
+  m_pending = false;
+  if (m_error) {
+    std::rethrow_exception(std::exchange(m_error, nullptr));
+  }
+
+  const Buffers& buffers = m_buffers[m_write];
+  m_write ^= 1;
+  return {buffers.obs.data(), buffers.rewards.data(), buffers.dones.get()};
+}
+
+}  // namespace ale
@@ -0,0 +1,120 @@
+/* *****************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2013 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details.
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ *  ale_async_batch.hpp
+ *
+ *  Steps an ALEBatch on worker threads so that the caller can overlap
+ *  emulation with other work (e.g. inference on the previous observations).
+ *
+ **************************************************************************** */
+
+#ifndef __ALE_ASYNC_BATCH_HPP__
+#define __ALE_ASYNC_BATCH_HPP__
+
+#include "ale/ale_batch.hpp"
+#include "ale/common/ThreadPool.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace ale {
+
+/**
+   An ALEBatch stepped asynchronously on a thread pool. Results are
+   double-buffered: the buffers returned by stepWait() stay untouched while
+   the next step runs, and are only overwritten by the step issued after
+   that. A typical loop is therefore
+
+     Result r = batch.reset();
+     for (;;) {
+       batch.stepAsync(policy(r.obs));   // emulate step k+1 ...
+       learn(r);                         // ... while consuming step k
+       r = batch.stepWait();
+     }
+
+   Only one step may be in flight at a time, and the methods must be called
+   from a single thread.
+ */
+class ALEAsyncBatch {
+ public:
+  /** Pointers into one of the two internal buffer sets, laid out as in
+   *  ALEBatch. */
+  struct Result {
+    const uint8_t* obs;
+    const reward_t* rewards;
+    const bool* dones;
+  };
+
+  /** num_threads = 0 uses the number of hardware threads (at most one per
+   *  environment). */
+  ALEAsyncBatch(std::vector<ALEInterface*> envs,
+                ObsType obs_type = ObsType::RGB, bool autoreset = false,
+                size_t num_threads = 0);
+
+  /** Waits for an outstanding step before tearing down the workers. */
+  ~ALEAsyncBatch();
+
+  ALEBatch& batch() { return m_batch; }
+  const ALEBatch& batch() const { return m_batch; }
+  size_t size() const { return m_batch.size(); }
+
+  // Resets every environment in parallel and returns the initial
+  // observations (rewards are 0 and dones false).
+  Result reset();
+
+  // Starts stepping environment i with actions[i]; returns immediately.
+  // The actions are copied, so the array may be reused right away.
+  void stepAsync(const Action* actions);
+
+  // Blocks until the step started by stepAsync() is complete and returns
+  // its results. Rethrows the first exception raised by an environment.
+  Result stepWait();
+
+  // Whether a step has been started and not yet collected by stepWait().
+  bool pending() const { return m_pending; }
+
+ private:
+  struct Buffers {
+    std::vector<uint8_t> obs;
+    std::vector<reward_t> rewards;
+    std::unique_ptr<bool[]> dones;
+  };
+
+  // Runs job(i, buffers) for every environment on the pool.
+  void dispatch(std::function<void(size_t, Buffers&)> job);
+
+  // Waits for the dispatched jobs and flips the write buffer.
+  Result collect();
+
+  ALEBatch m_batch;
+  Buffers m_buffers[2];
+  int m_write;  // Index of the buffer set written by the current step
+  std::vector<Action> m_actions;
+  bool m_pending;
+
+  std::mutex m_mutex;
+  std::condition_variable m_done_cv;
+  size_t m_remaining;
+  std::exception_ptr m_error;
+  std::function<void(size_t, Buffers&)> m_job;
+
+  // Declared last so that it is destroyed (and drained) first.
+  std::unique_ptr<ThreadPool> m_pool;
+};
+
+}  // namespace ale
+
+#endif  // __ALE_ASYNC_BATCH_HPP__
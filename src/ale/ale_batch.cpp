@@ -0,0 +1,140 @@
+/* *****************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2013 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details.
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ *  ale_batch.cpp
+ *
+ *  Steps a group of ALEInterface instances with a single call.
+ *
+ **************************************************************************** */
+
+#include "ale/ale_batch.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+#include "ale/common/ColourPalette.hpp"
+
+namespace ale {
+
+ALEBatch::ALEBatch(std::vector<ALEInterface*> envs, ObsType obs_type,
+                   bool autoreset)
+    : m_envs(std::move(envs)), m_obs_type(obs_type), m_autoreset(autoreset) {
+  if (m_envs.empty()) {
+    throw std::runtime_error("ALEBatch requires at least one environment.");
+  }
+  for (ALEInterface* env : m_envs) {
+    if (env == nullptr || env->environment == nullptr) {
+      throw std::runtime_error("ALEBatch requires environments with a loaded ROM.");
+    }
+  }
+
+  // Environments are stepped concurrently by the asynchronous wrappers, and
+  // an environment listed twice would have its buffers written twice.
+  std::vector<ALEInterface*> sorted(m_envs);
+  std::sort(sorted.begin(), sorted.end());
+  if (std::adjacent_find(sorted.begin(), sorted.end()) != sorted.end()) {
+    throw std::runtime_error("ALEBatch requires distinct environments.");
+  }
+
+  const ALEScreen& screen = m_envs[0]->getScreen();
+  for (ALEInterface* env : m_envs) {
+    if (env->getScreen().height() != screen.height() ||
+        env->getScreen().width() != screen.width()) {
+      throw std::runtime_error("ALEBatch environments must share the same screen size.");
+    }
+  }
+
+  switch (m_obs_type) {
+    case ObsType::RGB:
+      m_obs_shape = {screen.height(), screen.width(), 3};
+      break;
+    case ObsType::Grayscale:
+      m_obs_shape = {screen.height(), screen.width()};
+      break;
+    case ObsType::RAM:
+      m_obs_shape = {m_envs[0]->getRAM().size()};
+      break;
+    case ObsType::Indexed:
+      m_obs_shape = {screen.height(), screen.width()};
+      break;
+  }
+  m_obs_size = std::accumulate(m_obs_shape.begin(), m_obs_shape.end(),
+                               size_t(1), std::multiplies<size_t>());
+
+  m_envs[0]->getPaletteRGB(m_palette);
+  if (m_obs_type == ObsType::Indexed) {
+    std::vector<uint8_t> palette;
+    for (ALEInterface* env : m_envs) {
+      env->getPaletteRGB(palette);
+      if (palette != m_palette) {
+        throw std::runtime_error(
+            "ALEBatch indexed observations require environments with the same palette.");
+      }
+    }
+  }
+}
+
+void ALEBatch::step(const Action* actions, uint8_t* obs, reward_t* rewards,
+                    bool* dones) {
+  for (size_t i = 0; i < m_envs.size(); i++) {
+    step(i, actions[i], obs + i * m_obs_size, rewards + i, dones + i);
+  }
+}
+
+void ALEBatch::step(size_t i, Action action, uint8_t* obs, reward_t* reward,
+                    bool* done) {
+  ALEInterface& env = *m_envs[i];
+  if (m_autoreset && env.game_over()) {
+    env.reset_game();
+    *reward = 0;
+  } else {
+    *reward = env.act(action);
+  }
+  *done = env.game_over();
+  getObservation(i, obs);
+}
+
+void ALEBatch::reset(uint8_t* obs) {
+  for (size_t i = 0; i < m_envs.size(); i++) {
+    reset(i, obs + i * m_obs_size);
+  }
+}
+
+void ALEBatch::reset(size_t i, uint8_t* obs) {
+  m_envs[i]->reset_game();
+  getObservation(i, obs);
+}
+
+void ALEBatch::getObservation(size_t i, uint8_t* obs) const {
+  ALEInterface& env = *m_envs[i];
+  const ALEScreen& screen = env.getScreen();
+
+  switch (m_obs_type) {
+    case ObsType::RGB:
+      env.theOSystem->colourPalette().applyPaletteRGB(
+          obs, screen.getArray(), screen.height() * screen.width());
+      break;
+    case ObsType::Grayscale:
+      env.theOSystem->colourPalette().applyPaletteGrayscale(
+          obs, screen.getArray(), screen.height() * screen.width());
+      break;
+    case ObsType::RAM:
+      std::copy(env.getRAM().array(), env.getRAM().array() + m_obs_size, obs);
+      break;
+    case ObsType::Indexed:
+      std::copy(screen.getArray(), screen.getArray() + m_obs_size, obs);
+      break;
+  }
+}
+
+}  // namespace ale
@@ -0,0 +1,110 @@
+/* *****************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2013 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details.
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ *  ale_batch.hpp
+ *
+ *  Steps a group of ALEInterface instances with a single call, writing
+ *  observations, rewards and terminal flags into caller-provided buffers.
+ *
+ **************************************************************************** */
+
+#ifndef __ALE_BATCH_HPP__
+#define __ALE_BATCH_HPP__
+
+#include "ale/ale_interface.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ale {
+
+/** The observation ALEBatch writes for each environment. */
+enum class ObsType {
+  RGB,        // (height, width, 3) colours
+  Grayscale,  // (height, width) luminance
+  RAM,        // (128,) console RAM
+  Indexed,    // (height, width) palette indices, see ALEBatch::palette()
+};
+
+/**
+   A fixed group of environments stepped together. Buffers are laid out
+   environment-major, i.e. environment i owns bytes
+   [i * observationSize(), (i + 1) * observationSize()) of the observation
+   buffer. The environments are not owned by the batch and must outlive it;
+   the batch itself is not thread-safe.
+ */
+class ALEBatch {
+ public:
+  /** The environments must be distinct, have a ROM loaded and share the
+   *  same screen size.
+   *  With autoreset, an environment whose game is over is reset by the next
+   *  step instead of acting: its action is ignored, the reward is 0 and the
+   *  observation is the first one of the new episode. */
+  ALEBatch(std::vector<ALEInterface*> envs, ObsType obs_type = ObsType::RGB,
+           bool autoreset = false);
+
+  // Number of environments in the batch.
+  size_t size() const { return m_envs.size(); }
+
+  // The kind of observation written by step() and reset().
+  ObsType obsType() const { return m_obs_type; }
+
+  // Shape of the observation of a single environment.
+  const std::vector<size_t>& observationShape() const { return m_obs_shape; }
+
+  // Number of bytes in the observation of a single environment.
+  size_t observationSize() const { return m_obs_size; }
+
+  // RGB colours of the 256 palette indices, three bytes each, which turn
+  // Indexed observations into RGB ones. With Indexed observations all the
+  // environments must share this palette.
+  const std::vector<uint8_t>& palette() const { return m_palette; }
+
+  // Returns environment i.
+  ALEInterface& env(size_t i) { return *m_envs[i]; }
+
+  // Whether finished environments are reset by the next step.
+  bool autoreset() const { return m_autoreset; }
+
+  // Applies actions[i] to environment i, then stores its observation, the
+  // reward and whether the game is over. Without autoreset, finished
+  // environments are left to the caller to reset().
+  void step(const Action* actions, uint8_t* obs, reward_t* rewards,
+            bool* dones);
+
+  // Steps environment i alone; obs points to that environment's slot.
+  // Distinct environments may be stepped concurrently from different threads.
+  void step(size_t i, Action action, uint8_t* obs, reward_t* reward,
+            bool* done);
+
+  // Resets every environment and stores its initial observation.
+  void reset(uint8_t* obs);
+
+  // Resets environment i and stores its initial observation at obs, which
+  // points to that environment's slot.
+  void reset(size_t i, uint8_t* obs);
+
+  // Stores the current observation of environment i at obs, which points to
+  // that environment's slot.
+  void getObservation(size_t i, uint8_t* obs) const;
+
+ private:
+  std::vector<ALEInterface*> m_envs;
+  ObsType m_obs_type;
+  bool m_autoreset;
+  std::vector<size_t> m_obs_shape;
+  size_t m_obs_size;
+  std::vector<uint8_t> m_palette;
+};
+
+}  // namespace ale
+
+#endif  // __ALE_BATCH_HPP__
@@ -0,0 +1,156 @@
+/* *****************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2013 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details.
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ *  ale_env_pool.cpp
+ *
+ *  Steps environments independently and returns the first ones to finish.
+ *
+ **************************************************************************** */
+
+#include "ale/ale_env_pool.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+
+namespace ale {
+
+ALEEnvPool::ALEEnvPool(std::vector<ALEInterface*> envs, size_t batch_size,
+                       ObsType obs_type, bool autoreset, size_t num_threads)
+    : m_batch(std::move(envs), obs_type, autoreset),
+      m_batch_size(batch_size == 0 ? m_batch.size() : batch_size),
+      m_in_flight(0) {
+  if (m_batch_size > m_batch.size()) {
+    throw std::runtime_error("ALEEnvPool batch size exceeds the number of environments.");
+  }
+
+  const size_t n = m_batch.size();
+  m_env_obs.resize(n * m_batch.observationSize());
+  m_env_rewards.resize(n);
+  m_env_dones.reset(new bool[n]());
+  m_env_errors.resize(n);
+
+  m_out_obs.resize(m_batch_size * m_batch.observationSize());
+  m_out_rewards.resize(m_batch_size);
+  m_out_dones.reset(new bool[m_batch_size]());
+  m_out_ids.resize(m_batch_size);
+
+  m_states.resize(n, EnvState::Idle);
+
+  if (num_threads == 0) {
+    num_threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  m_pool.reset(new ThreadPool(std::min(num_threads, n)));
+}
+
+ALEEnvPool::~ALEEnvPool() {
+  // The queued tasks reference the environments and buffers; finish them
+  // before anything else, including a derived class, is torn down.
+  m_pool.reset();
+}
+
+void ALEEnvPool::asyncReset() {
+  for (EnvState state : m_states) {
+    if (state != EnvState::Idle) {
+      throw std::runtime_error("ALEEnvPool::asyncReset called with environments in flight.");
+    }
+  }
+  for (size_t i = 0; i < m_batch.size(); i++) {
+    start(i, PLAYER_A_NOOP, true);
+  }
+}
+
+void ALEEnvPool::send(const Action* actions, const int* env_ids, size_t n) {
+  // Validate everything first so that a bad id does not leave a partial send.
+  for (size_t k = 0; k < n; k++) {
+    int id = env_ids[k];
+    if (id < 0 || (size_t)id >= m_batch.size()) {
+      throw std::runtime_error("ALEEnvPool::send: invalid environment id " +
+                               std::to_string(id) + ".");
+    }
+    if (m_states[id] != EnvState::Idle) {
+      throw std::runtime_error("ALEEnvPool::send: environment " +
+                               std::to_string(id) + " is still in flight.");
+    }
+  }
+  for (size_t k = 0; k < n; k++) {
+    start(env_ids[k], actions[k], false);
+  }
+}
+
+void ALEEnvPool::start(size_t i, Action action, bool reset) {
+  m_states[i] = EnvState::Running;
+  m_in_flight++;
+
+  m_pool->submit([this, i, action, reset] {
+    uint8_t* obs = m_env_obs.data() + i * m_batch.observationSize();
+    try {
+      if (reset) {
+        m_batch.reset(i, obs);
+        m_env_rewards[i] = 0;
+        m_env_dones[i] = false;
+      } else {
+        m_batch.step(i, action, obs, &m_env_rewards[i], &m_env_dones[i]);
+      }
+    } catch (...) {
+      m_env_errors[i] = std::current_exception();
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_ready.push_back(i);
+    m_ready_cv.notify_one();
+  });
+}
+
+ALEEnvPool::Result ALEEnvPool::recv() {
+  if (m_in_flight < m_batch_size) {
+    throw std::runtime_error("ALEEnvPool::recv: fewer environments in flight "
+                             "than the batch size.");
+  }
+
+  std::vector<size_t> ids;
+  ids.reserve(m_batch_size);
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_ready_cv.wait(lock, [this] { return m_ready.size() >= m_batch_size; });
+    for (size_t k = 0; k < m_batch_size; k++) {
+      ids.push_back(m_ready.front());
+      m_ready.pop_front();
+    }
+  }
+
+  const size_t obs_size = m_batch.observationSize();
+  std::exception_ptr error;
+  for (size_t k = 0; k < m_batch_size; k++) {
+    size_t i = ids[k];
+    m_states[i] = EnvState::Idle;
+    m_in_flight--;
+    if (m_env_errors[i] && !error) {
+      error = std::exchange(m_env_errors[i], nullptr);
+    }
+
+    std::copy(m_env_obs.begin() + i * obs_size,
+              m_env_obs.begin() + (i + 1) * obs_size,
+              m_out_obs.begin() + k * obs_size);
+    m_out_rewards[k] = m_env_rewards[i];
+    m_out_dones[k] = m_env_dones[i];
+    m_out_ids[k] = (int)i;
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+
+  return {m_out_obs.data(), m_out_rewards.data(), m_out_dones.get(),
+          m_out_ids.data(), m_batch_size};
+}
+
+}  // namespace ale
@@ -0,0 +1,131 @@
+/* *****************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2013 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details.
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ *  ale_env_pool.hpp
+ *
+ *  Steps environments independently on worker threads and hands back
+ *  whichever ones finish first, so that slow resets or slow games do not
+ *  hold up the rest of the batch.
+ *
+ **************************************************************************** */
+
+#ifndef __ALE_ENV_POOL_HPP__
+#define __ALE_ENV_POOL_HPP__
+
+#include "ale/ale_batch.hpp"
+#include "ale/common/ThreadPool.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace ale {
+
+/**
+   A pool of environments that are stepped individually on a thread pool.
+   Unlike ALEAsyncBatch, recv() does not wait for every environment: it
+   returns as soon as batchSize() of them have finished, tagged with their
+   environment ids. The caller then sends actions for exactly those ids:
+
+     pool.asyncReset();
+     for (;;) {
+       Result r = pool.recv();                        // batchSize() results
+       pool.send(policy(r.obs), r.env_ids, r.size);
+     }
+
+   With batchSize() == size() this behaves like a synchronous batch (in
+   completion order). An environment may only be sent again once its
+   previous result has been received. All methods must be called from a
+   single thread.
+ */
+class ALEEnvPool {
+ public:
+  /** Pointers into the pool's output buffers, valid until the next call to
+   *  recv(). Entry k belongs to environment env_ids[k]. */
+  struct Result {
+    const uint8_t* obs;
+    const reward_t* rewards;
+    const bool* dones;
+    const int* env_ids;
+    size_t size;
+  };
+
+  /** batch_size = 0 uses the number of environments; num_threads = 0 uses
+   *  the number of hardware threads (at most one per environment). */
+  ALEEnvPool(std::vector<ALEInterface*> envs, size_t batch_size = 0,
+             ObsType obs_type = ObsType::RGB, bool autoreset = true,
+             size_t num_threads = 0);
+
+  /** Finishes the environments in flight and joins the workers. */
+  ~ALEEnvPool();
+
+  ALEBatch& batch() { return m_batch; }
+  const ALEBatch& batch() const { return m_batch; }
+  size_t size() const { return m_batch.size(); }
+
+  // Number of results returned by each recv().
+  size_t batchSize() const { return m_batch_size; }
+
+  // Starts resetting every environment. Their initial observations are
+  // returned by the following recv() calls (rewards 0, dones false).
+  void asyncReset();
+
+  // Starts stepping environment env_ids[k] with actions[k], k < n; returns
+  // immediately. Throws if an environment is still in flight or its last
+  // result has not been received.
+  void send(const Action* actions, const int* env_ids, size_t n);
+
+  // Blocks until batchSize() environments have finished and returns their
+  // results in completion order. Rethrows the exception raised by an
+  // environment when its result is collected.
+  Result recv();
+
+ private:
+  // Running lasts from send() until the result is returned by recv().
+  enum class EnvState { Idle, Running };
+
+  // Queues a step (or a reset when reset is true) of environment i.
+  void start(size_t i, Action action, bool reset);
+
+  ALEBatch m_batch;
+  size_t m_batch_size;
+
+  // Per-environment results, written by the workers.
+  std::vector<uint8_t> m_env_obs;
+  std::vector<reward_t> m_env_rewards;
+  std::unique_ptr<bool[]> m_env_dones;
+  std::vector<std::exception_ptr> m_env_errors;
+
+  // Results handed to the caller by recv().
+  std::vector<uint8_t> m_out_obs;
+  std::vector<reward_t> m_out_rewards;
+  std::unique_ptr<bool[]> m_out_dones;
+  std::vector<int> m_out_ids;
+
+  // Only touched by the calling thread, except for the queue below.
+  std::vector<EnvState> m_states;
+  size_t m_in_flight;
+
+  std::mutex m_mutex;
+  std::condition_variable m_ready_cv;
+  std::deque<size_t> m_ready;  // Finished environments, in completion order
+
+  // Declared last so that it is destroyed (and drained) first.
+  std::unique_ptr<ThreadPool> m_pool;
+};
+
+}  // namespace ale
+
+#endif  // __ALE_ENV_POOL_HPP__
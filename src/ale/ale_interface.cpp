@@ -47,6 +47,8 @@
 #include "ale/common/ColourPalette.hpp"
 #include "ale/common/Constants.h"
 #include "ale/emucore/Console.hxx"
+#include "ale/emucore/M6502.hxx"
+#include "ale/emucore/TIA.hxx"
 #include "ale/emucore/Props.hxx"
 #include "ale/emucore/MD5.hxx"
 #include "ale/environment/ale_screen.hpp"
@@ -264,6 +266,33 @@ reward_t ALEInterface::act(Action action, float paddle_strength) {
   return environment->act(action, PLAYER_B_NOOP, paddle_strength, 0.0);
 }
 
+// Applies one action per player and returns the reward of each player.
+std::vector<reward_t> ALEInterface::act(const ActionVect& actions,
+                                        const std::vector<float>& paddle_strengths) {
+  if (!paddle_strengths.empty() && paddle_strengths.size() != actions.size()) {
+    throw std::runtime_error("Expected one paddle strength per player");
+  }
+  std::vector<reward_t> rewards(actions.size());
+  environment->act(actions.data(),
+                   paddle_strengths.empty() ? nullptr : paddle_strengths.data(),
+                   actions.size(), rewards.data());
+  return rewards;
+}
+
+int ALEInterface::getMaxPlayers() const {
+  if (environment == nullptr) {
+    throw std::runtime_error("ROM not set");
+  }
+  return environment->getMaxPlayers();
+}
+
+int ALEInterface::getNumPlayers() const {
+  if (romSettings == nullptr) {
+    throw std::runtime_error("ROM not set");
+  }
+  return romSettings->numPlayers();
+}
+
 // Returns the vector of modes available for the current game.
 // This should be called only after the rom is loaded.
 ModeVect ALEInterface::getAvailableModes() const {
@@ -329,6 +358,26 @@ int ALEInterface::getEpisodeFrameNumber() const {
   return environment->getEpisodeFrameNumber();
 }
 
+// Returns the number of 6502 instructions executed since the ROM was loaded
+uint64_t ALEInterface::getInstructionCount() const {
+  return theOSystem->console().system().m6502().totalInstructionCount();
+}
+
+// Returns the number of CPU cycles executed since the ROM was loaded
+uint64_t ALEInterface::getCycleCount() const {
+  return theOSystem->console().system().totalCycles();
+}
+
+// Returns the number of frames emulated since the ROM was loaded
+uint64_t ALEInterface::getEmulatedFrameCount() const {
+  return theOSystem->console().system().tia().frameCount();
+}
+
+// Returns the number of scanlines the last emulated frame consisted of
+int ALEInterface::getScanlinesPerFrame() const {
+  return theOSystem->console().mediaSource().scanlines();
+}
+
 // Returns the current game screen
 const ALEScreen& ALEInterface::getScreen() const { return environment->getScreen(); }
 
@@ -359,9 +408,39 @@ void ALEInterface::getScreenRGB(std::vector<unsigned char>& output_rgb_buffer) c
                                               ale_screen_data, screen_size);
 }
 
+// This method should receive a vector to fill it with the RGB colours of
+// the 256 palette indices, three bytes per index
+void ALEInterface::getPaletteRGB(std::vector<unsigned char>& output_rgb_buffer) const {
+  if (environment == nullptr) {
+    throw std::runtime_error("ROM not set");
+  }
+  pixel_t indices[256];
+  for (int i = 0; i < 256; i++) {
+    indices[i] = pixel_t(i);
+  }
+  theOSystem->colourPalette().applyPaletteRGB(output_rgb_buffer, indices, 256);
+}
+
 // Returns the current RAM content
 const ALERAM& ALEInterface::getRAM() const { return environment->getRAM(); }
 
+// Returns the most recent captured audio samples
+const std::vector<uint8_t>& ALEInterface::getAudio() const {
+  if (environment == nullptr) {
+    throw std::runtime_error("ROM not set");
+  }
+  return environment->getAudio();
+}
+
+// Returns a number that changes whenever the screen, audio or RAM may have
+// changed
+uint64_t ALEInterface::getObservationGeneration() const {
+  if (environment == nullptr) {
+    throw std::runtime_error("ROM not set");
+  }
+  return environment->getObservationGeneration();
+}
+
 // Set byte at memory address
 void ALEInterface::setRAM(size_t memory_index, byte_t value) {
   if (memory_index < 0 || memory_index >= 128){
@@ -378,6 +457,39 @@ void ALEInterface::restoreState(const ALEState& state) {
   return environment->restoreState(state);
 }
 
+uint64_t ALEInterface::stateHash() {
+  if (environment == nullptr) {
+    throw std::runtime_error("ROM not set");
+  }
+  return environment->stateHash();
+}
+
+RolloutResult ALEInterface::rollout(const ALEState& state,
+                                    const Action* actions, size_t num_actions,
+                                    const RolloutOptions& options) {
+  if (environment == nullptr) {
+    throw std::runtime_error("ROM not set");
+  }
+  RolloutResult result;
+  result.rewards.resize(num_actions);
+  size_t steps = environment->rollout(state, actions, num_actions,
+                                      options.paddle_strength,
+                                      options.stop_on_terminal,
+                                      result.rewards.data());
+  result.rewards.resize(steps);
+  result.terminal = game_over();
+  if (options.clone_final_state) {
+    result.state = cloneState(options.include_rng);
+  }
+  return result;
+}
+
+RolloutResult ALEInterface::rollout(const ALEState& state,
+                                    const ActionVect& actions,
+                                    const RolloutOptions& options) {
+  return rollout(state, actions.data(), actions.size(), options);
+}
+
 ALEState ALEInterface::cloneSystemState() {
   return cloneState(true);
 }
@@ -391,6 +503,12 @@ void ALEInterface::saveScreenPNG(const std::string& filename) {
   exporter.save(environment->getScreen(), filename);
 }
 
+const PerfStats& ALEInterface::getPerfStats() const {
+  return theOSystem->perfStats();
+}
+
+void ALEInterface::resetPerfStats() { theOSystem->perfStats().reset(); }
+
 ScreenExporter*
 ALEInterface::createScreenExporter(const std::string& filename) const {
   return new ScreenExporter(theOSystem->colourPalette(), filename);
@@ -36,17 +36,37 @@
 #include "ale/environment/stella_environment.hpp"
 #include "ale/common/ScreenExporter.hpp"
 #include "ale/common/Log.hpp"
+#include "ale/common/PerfStats.hpp"
 #include "version.hpp"
 
 #include <string>
 #include <optional>
 #include <memory>
 #include <filesystem>
+#include <vector>
 
 namespace fs = std::filesystem;
 
 namespace ale {
 
+/** Options for ALEInterface::rollout(). */
+struct RolloutOptions {
+  // Stop as soon as the game is over instead of playing out all actions.
+  bool stop_on_terminal = true;
+  // Whether to clone the final state into RolloutResult::state.
+  bool clone_final_state = true;
+  // Whether the cloned final state includes the RNG (see cloneState()).
+  bool include_rng = false;
+  float paddle_strength = 1.0;
+};
+
+/** Outcome of a rollout. */
+struct RolloutResult {
+  std::vector<reward_t> rewards;  // One entry per step actually taken
+  bool terminal = false;          // Whether the game is over at the end
+  ALEState state;                 // Final state, if requested
+};
+
 /**
    This class interfaces ALE with external code for controlling agents.
  */
@@ -88,6 +108,22 @@ class ALEInterface {
   // game over screen.
   reward_t act(Action action, float paddle_strength = 1.0);
 
+  // Applies one action per player, each from player A's action set
+  // (PLAYER_A_NOOP to PLAYER_A_DOWNLEFTFIRE), and returns each player's
+  // reward. Player B uses the second joystick or paddle, players C and D
+  // the paddles of the right controller port; see getMaxPlayers(). Rewards
+  // are reported for the players the game scores (getNumPlayers()); the
+  // others get 0. paddle_strengths defaults to 1.0 for every player.
+  std::vector<reward_t> act(const ActionVect& actions,
+                            const std::vector<float>& paddle_strengths = {});
+
+  // Number of players act() accepts actions for: 4 in games with paddles
+  // on both controller ports, otherwise 2.
+  int getMaxPlayers() const;
+
+  // Number of players the game reports rewards for.
+  int getNumPlayers() const;
+
   // Indicates if the game has ended.
   bool game_over(bool with_truncation = true) const;
 
@@ -149,6 +185,22 @@ class ALEInterface {
   // Returns the frame number since the start of the current episode
   int getEpisodeFrameNumber() const;
 
+  // Returns the number of 6502 instructions executed since the ROM was loaded.
+  // Iterations skipped by "skip_idle_loops" count as executed, so this does
+  // not depend on that setting, but with it on fewer instructions are
+  // actually interpreted.
+  uint64_t getInstructionCount() const;
+
+  // Returns the number of CPU cycles executed since the ROM was loaded.
+  uint64_t getCycleCount() const;
+
+  // Returns the number of frames emulated since the ROM was loaded. Unlike
+  // getFrameNumber() this also counts the frames emulated during resets.
+  uint64_t getEmulatedFrameCount() const;
+
+  // Returns the number of scanlines the last emulated frame consisted of.
+  int getScanlinesPerFrame() const;
+
   // Returns the current game screen
   const ALEScreen& getScreen() const;
 
@@ -161,9 +213,25 @@ class ALEInterface {
   //followed by the green colours and then the blue colours
   void getScreenRGB(std::vector<unsigned char>& output_rgb_buffer) const;
 
+  // This method should receive a vector to fill it with the RGB colours of
+  // the 256 palette indices, three bytes per index. Looking up the indices
+  // of getScreen() in it gives the colours of getScreenRGB().
+  void getPaletteRGB(std::vector<unsigned char>& output_rgb_buffer) const;
+
   // Returns the current RAM content
   const ALERAM& getRAM() const;
 
+  // Returns the most recent audio samples, oldest first, as unsigned 8-bit
+  // mono. They are only captured if the boolean option sound_capture is set
+  // (and sound is not); otherwise there are none. By default they cover the
+  // frames of the last act(); see SoundCapture for the other options.
+  const std::vector<uint8_t>& getAudio() const;
+
+  // Returns a number that changes whenever the contents of getScreen(),
+  // getAudio() or getRAM() may have changed, e.g. by act(), reset_game(),
+  // restoreState() or loadROM(). It is never repeated within the process.
+  uint64_t getObservationGeneration() const;
+
   // Set byte at memory address. This can be useful to change the environment
   // for example if you were trying to learn a causal model of RAM locations.
   void setRAM(size_t memory_index, byte_t value);
@@ -183,6 +251,32 @@ class ALEInterface {
   // This is equivalent to calling cloneState(true) but is maintained for backwards compatibility.
   ALEState cloneSystemState();
 
+  // Returns a 64-bit hash of the current emulator state, for detecting
+  // duplicate states in transposition tables or novelty archives. It is
+  // computed in place (only the game's bookkeeping is serialized) over the
+  // RIOT RAM and timer, the CPU registers, the TIA registers and beam
+  // position, the cartridge bank and RAM, the state saved by the game's
+  // settings (reward, score, terminal flag, lives and the like), the last
+  // actions if sticky actions may repeat them, and the paddle, mode and
+  // difficulty settings. Left out are everything that does
+  // not change the future of the emulation: absolute cycle and frame
+  // counters, the RNG, the frame buffers (so colour-averaged observations
+  // may differ) and sound. Equal states always hash equally; two distinct
+  // states collide with probability about 2^-64, i.e. an archive of n states
+  // contains a collision with probability about n^2 / 2^65 (below 1e-6 for
+  // n = 6 million).
+  uint64_t stateHash();
+
+  // Restores `state` and applies the given actions in order, as a sequence of
+  // act() calls would, but without processing the intermediate screens. The
+  // interface is left in the final state. Meant for planners that evaluate
+  // many open-loop action sequences from the same node.
+  RolloutResult rollout(const ALEState& state, const Action* actions,
+                        size_t num_actions,
+                        const RolloutOptions& options = RolloutOptions());
+  RolloutResult rollout(const ALEState& state, const ActionVect& actions,
+                        const RolloutOptions& options = RolloutOptions());
+
   // Reverse operation of cloneSystemState.
   // This is maintained for backwards compatability and is equivalent to calling restoreState(state).
   void restoreSystemState(const ALEState& state);
@@ -190,6 +284,14 @@ class ALEInterface {
   // Save the current screen as a png file
   void saveScreenPNG(const std::string& filename);
 
+  // Returns the per-stage timing counters accumulated since the ROM was loaded
+  // or since the last call to resetPerfStats(). The counters are only updated
+  // when ALE is built with ALE_PERF_STATS (see PerfStats::enabled).
+  const PerfStats& getPerfStats() const;
+
+  // Zeroes the per-stage timing counters.
+  void resetPerfStats();
+
   // Creates a ScreenExporter object which can be used to save a sequence of frames. Ownership
   // said object is passed to the caller. Frames are saved in the directory 'path', which needs
   // to exists.
@@ -199,7 +301,8 @@ class ALEInterface {
   std::unique_ptr<stella::OSystem> theOSystem;
   std::unique_ptr<stella::Settings> theSettings;
   std::unique_ptr<RomSettings> romSettings;
-  std::unique_ptr<StellaEnvironment> environment;
+  // Shared so that views of its screen and RAM can keep it alive
+  std::shared_ptr<StellaEnvironment> environment;
   int max_num_frames; // Maximum number of frames for each episode
 
  public:
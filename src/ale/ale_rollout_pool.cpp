@@ -0,0 +1,99 @@
+/* *****************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2013 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details.
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ *  ale_rollout_pool.cpp
+ *
+ *  Evaluates many action sequences from the same state in parallel.
+ *
+ **************************************************************************** */
+
+#include "ale/ale_rollout_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace ale {
+
+ALERolloutPool::ALERolloutPool(std::vector<ALEInterface*> envs,
+                               size_t num_threads)
+    : m_envs(std::move(envs)) {
+  if (m_envs.empty()) {
+    throw std::runtime_error("ALERolloutPool requires at least one environment.");
+  }
+  for (ALEInterface* env : m_envs) {
+    if (env == nullptr || env->environment == nullptr) {
+      throw std::runtime_error("ALERolloutPool requires environments with a loaded ROM.");
+    }
+  }
+
+  // Each environment runs on its own worker
+  std::vector<ALEInterface*> sorted(m_envs);
+  std::sort(sorted.begin(), sorted.end());
+  if (std::adjacent_find(sorted.begin(), sorted.end()) != sorted.end()) {
+    throw std::runtime_error("ALERolloutPool requires distinct environments.");
+  }
+
+  if (num_threads == 0) {
+    num_threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  m_pool.reset(new ThreadPool(std::min(num_threads, m_envs.size())));
+}
+
+std::vector<RolloutResult> ALERolloutPool::rollout(
+    const ALEState& root, const std::vector<ActionVect>& sequences,
+    const RolloutOptions& options) {
+  std::vector<RolloutResult> results(sequences.size());
+  if (sequences.empty()) {
+    return results;
+  }
+
+  // Each environment keeps taking the next unclaimed sequence, so that long
+  // and short rollouts balance out across workers.
+  std::atomic<size_t> next(0);
+  std::mutex mutex;
+  std::condition_variable done_cv;
+  size_t remaining = std::min(m_envs.size(), sequences.size());
+  std::exception_ptr error;
+
+  const size_t num_jobs = remaining;
+  for (size_t i = 0; i < num_jobs; i++) {
+    m_pool->submit([&, i] {
+      std::exception_ptr job_error;
+      try {
+        for (size_t k = next++; k < sequences.size(); k = next++) {
+          results[k] = m_envs[i]->rollout(root, sequences[k], options);
+        }
+      } catch (...) {
+        job_error = std::current_exception();
+      }
+
+      std::lock_guard<std::mutex> lock(mutex);
+      if (job_error && !error) error = job_error;
+      if (--remaining == 0) done_cv.notify_all();
+    });
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    done_cv.wait(lock, [&] { return remaining == 0; });
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+  return results;
+}
+
+}  // namespace ale
@@ -0,0 +1,70 @@
+/* *****************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2013 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details.
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ *  ale_rollout_pool.hpp
+ *
+ *  Evaluates many open-loop action sequences from the same state in
+ *  parallel, one emulator per worker thread.
+ *
+ **************************************************************************** */
+
+#ifndef __ALE_ROLLOUT_POOL_HPP__
+#define __ALE_ROLLOUT_POOL_HPP__
+
+#include "ale/ale_interface.hpp"
+#include "ale/common/ThreadPool.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace ale {
+
+/**
+   Fans rollouts out over a set of environments, e.g. for expanding all
+   children of a search node at once:
+
+     ALEState root = envs[0]->cloneState();
+     std::vector<RolloutResult> results = pool.rollout(root, sequences);
+
+   The environments must be distinct and have the same ROM and settings
+   loaded (so that any of them can restore the root state). They are not
+   owned by the pool. Each rollout leaves the environment that ran it in its
+   final state. All methods must be called from a single thread.
+ */
+class ALERolloutPool {
+ public:
+  /** num_threads = 0 uses the number of hardware threads (at most one per
+   *  environment). */
+  ALERolloutPool(std::vector<ALEInterface*> envs, size_t num_threads = 0);
+
+  // Number of environments, i.e. the most rollouts run at the same time.
+  size_t size() const { return m_envs.size(); }
+
+  // Returns environment i.
+  ALEInterface& env(size_t i) { return *m_envs[i]; }
+
+  // Runs one rollout per action sequence, all starting from `root`, and
+  // blocks until they are done. Result k belongs to sequences[k]. Rethrows
+  // the first exception raised by a rollout.
+  std::vector<RolloutResult> rollout(
+      const ALEState& root, const std::vector<ActionVect>& sequences,
+      const RolloutOptions& options = RolloutOptions());
+
+ private:
+  std::vector<ALEInterface*> m_envs;
+
+  // Declared last so that it is destroyed (and drained) first.
+  std::unique_ptr<ThreadPool> m_pool;
+};
+
+}  // namespace ale
+
+#endif  // __ALE_ROLLOUT_POOL_HPP__
@@ -72,6 +72,10 @@ enum Action {
 #define PLAYER_A_MAX (18)
 #define PLAYER_B_MAX (36)
 
+// Maximum number of players: two joysticks or paddles on the left port, plus
+// two more paddles on the right port
+#define MAX_PLAYERS (4)
+
 std::string action_to_string(Action a);
 
 //  Define datatypes
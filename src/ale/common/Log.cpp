@@ -4,12 +4,14 @@
 
 namespace ale {
 
-Logger::mode Logger::current_mode = Info;
+std::atomic<Logger::mode> Logger::current_mode(Info);
 
-void Logger::setMode(Logger::mode m) { current_mode = m; }
+void Logger::setMode(Logger::mode m) {
+  current_mode.store(m, std::memory_order_relaxed);
+}
 
 Logger::mode operator<<(Logger::mode log, std::ostream& (*manip)(std::ostream&)) {
-  if (log >= Logger::current_mode) {
+  if (log >= Logger::current_mode.load(std::memory_order_relaxed)) {
     manip(std::cerr);
   }
   return log;
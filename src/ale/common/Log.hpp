@@ -1,6 +1,7 @@
 #ifndef __LOG_HPP__
 #define __LOG_HPP__
 
+#include <atomic>
 #include <iostream>
 
 namespace ale {
@@ -15,7 +16,8 @@ class Logger {
   static void setMode(mode m);
 
  private:
-  static mode current_mode;
+  // Atomic, since environments may log from several threads at once
+  static std::atomic<mode> current_mode;
   friend mode operator<<(mode, std::ostream& (*manip)(std::ostream&));
   template <typename T> friend mode operator<<(mode, const T&);
 };
@@ -24,7 +26,7 @@ Logger::mode operator<<(Logger::mode log,
                         std::ostream& (*manip)(std::ostream&));
 
 template <typename T> Logger::mode operator<<(Logger::mode log, const T& val) {
-  if (log >= Logger::current_mode) std::cerr << val;
+  if (log >= Logger::current_mode.load(std::memory_order_relaxed)) std::cerr << val;
   return log;
 }
 
@@ -0,0 +1,104 @@
+/* *****************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2013 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details.
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ *  PerfStats.hpp
+ *
+ *  Optional per-stage timing counters. Instrumentation is only compiled in
+ *  when ALE_PERF_STATS is defined (cmake -DALE_PERF_STATS=ON); otherwise the
+ *  macros below expand to nothing and all counters stay at zero.
+ *
+ **************************************************************************** */
+
+#ifndef __PERF_STATS_HPP__
+#define __PERF_STATS_HPP__
+
+#include <chrono>
+#include <cstdint>
+
+namespace ale {
+
+/** Accumulated counters for one emulator instance. Times are in nanoseconds
+ *  of wall-clock time; stages nest as follows:
+ *
+ *    act_ns
+ *     +- hooks_ns        sound recording, screen rendering, screen exporter
+ *     +- emulate_ns      MediaSource::update(), i.e. CPU + TIA
+ *     +- rom_step_ns     RomSettings::step()
+ *     +- screen_ns       processScreen() (memcpy or phosphor blending)
+ *     +- ram_ns          processRAM()
+ *
+ *  reset_ns covers StellaEnvironment::reset() as a whole; the frames it
+ *  emulates are also counted by the nested stages.
+ *
+ *  The TIA rasterizes in small steps from within the CPU loop, on every
+ *  register access, so its share of emulate_ns is not timed; tia_clocks
+ *  counts the colour clocks it drew instead. */
+struct PerfStats {
+  /** Whether the counters are compiled in. */
+#ifdef ALE_PERF_STATS
+  static constexpr bool enabled = true;
+#else
+  static constexpr bool enabled = false;
+#endif
+
+  uint64_t act_ns = 0;
+  uint64_t reset_ns = 0;
+  uint64_t hooks_ns = 0;
+  uint64_t emulate_ns = 0;
+  uint64_t rom_step_ns = 0;
+  uint64_t screen_ns = 0;
+  uint64_t ram_ns = 0;
+
+  uint64_t frames = 0;        // Emulated frames (MediaSource::update() calls)
+  uint64_t instructions = 0;  // 6502 instructions executed, including the
+                              // iterations skipped by "skip_idle_loops"
+  uint64_t tia_pokes = 0;     // Writes to TIA registers
+  uint64_t tia_clocks = 0;    // Colour clocks rasterized by the TIA
+
+  void reset() { *this = PerfStats(); }
+};
+
+#ifdef ALE_PERF_STATS
+
+/** Adds the lifetime of the object to the given counter. */
+class PerfTimer {
+ public:
+  explicit PerfTimer(uint64_t& counter)
+      : m_counter(counter), m_start(std::chrono::steady_clock::now()) {}
+
+  ~PerfTimer() {
+    m_counter += std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - m_start).count();
+  }
+
+  PerfTimer(const PerfTimer&) = delete;
+  PerfTimer& operator=(const PerfTimer&) = delete;
+
+ private:
+  uint64_t& m_counter;
+  std::chrono::steady_clock::time_point m_start;
+};
+
+#define ALE_PERF_CONCAT_(a, b) a##b
+#define ALE_PERF_CONCAT(a, b) ALE_PERF_CONCAT_(a, b)
+#define ALE_PERF_SCOPE(counter) \
+  ::ale::PerfTimer ALE_PERF_CONCAT(ale_perf_timer_, __LINE__)(counter)
+#define ALE_PERF_ADD(counter, value) ((counter) += (value))
+
+#else
+
+#define ALE_PERF_SCOPE(counter) ((void)0)
+#define ALE_PERF_ADD(counter, value) ((void)0)
+
+#endif  // ALE_PERF_STATS
+
+}  // namespace ale
+
+#endif  // __PERF_STATS_HPP__
@@ -18,6 +18,7 @@
 
 #include <zlib.h>
 #include <cassert>
+#include <cstring>
 #include <fstream>
 #include <sstream>
 #include <string>
@@ -88,44 +89,70 @@ static void writePNGHeader(std::ofstream& out, const ALEScreen& screen,
   writePNGChunk(out, "IHDR", ihdr, sizeof(ihdr));
 }
 
-static void writePNGData(std::ofstream& out, const ALEScreen& screen,
-                         const ColourPalette& palette,
-                         bool doubleWidth = true) {
-  int dataWidth = screen.width();
-  int width = doubleWidth ? dataWidth * 2 : dataWidth;
-  int height = screen.height();
-
-  // If so desired, double the width
-
-  // Fill the buffer with scanline data
-  int rowbytes = width * 3;
+static void writePNGRow(uint8_t* buf_ptr, const uint8_t* pixels,
+                        int dataWidth, const ColourPalette& palette,
+                        bool doubleWidth) {
+  *buf_ptr++ = 0; // first byte of row is filter type
+  for (int j = 0; j < dataWidth; j++) {
+    int r, g, b;
 
-  std::vector<uint8_t> buffer((rowbytes + 1) * height, 0);
-  uint8_t* buf_ptr = &buffer[0];
+    palette.getRGB(pixels[j], r, g, b);
+    // Double the pixel width, if so desired
+    int jj = doubleWidth ? 2 * j : j;
 
-  for (int i = 0; i < height; i++) {
-    *buf_ptr++ = 0; // first byte of row is filter type
-    for (int j = 0; j < dataWidth; j++) {
-      int r, g, b;
+    buf_ptr[jj * 3 + 0] = r;
+    buf_ptr[jj * 3 + 1] = g;
+    buf_ptr[jj * 3 + 2] = b;
 
-      palette.getRGB(screen.getArray()[i * dataWidth + j], r, g, b);
-      // Double the pixel width, if so desired
-      int jj = doubleWidth ? 2 * j : j;
+    if (doubleWidth) {
+      jj = jj + 1;
 
       buf_ptr[jj * 3 + 0] = r;
       buf_ptr[jj * 3 + 1] = g;
       buf_ptr[jj * 3 + 2] = b;
+    }
+  }
+}
+
+// Fills buffer with the scanline data of the given screen. The buffer and
+// last_screen hold the previously converted screen, if any, and only the
+// rows that differ from it are converted again.
+static void fillPNGRows(std::vector<uint8_t>& buffer,
+                        std::vector<uint8_t>& last_screen,
+                        const ALEScreen& screen, const ColourPalette& palette,
+                        bool doubleWidth = true) {
+  int dataWidth = screen.width();
+  int width = doubleWidth ? dataWidth * 2 : dataWidth;
+  int height = screen.height();
 
-      if (doubleWidth) {
-        jj = jj + 1;
+  // Fill the buffer with scanline data
+  int rowbytes = width * 3;
+
+  size_t size = screen.arraySize();
+  bool fresh = buffer.size() != size_t(rowbytes + 1) * height ||
+               last_screen.size() != size;
+  if (fresh) {
+    buffer.assign((rowbytes + 1) * height, 0);
+    last_screen.assign(size, 0);
+  }
 
-        buf_ptr[jj * 3 + 0] = r;
-        buf_ptr[jj * 3 + 1] = g;
-        buf_ptr[jj * 3 + 2] = b;
-      }
+  for (int i = 0; i < height; i++) {
+    const uint8_t* pixels = screen.getArray() + i * dataWidth;
+    uint8_t* last = &last_screen[i * dataWidth];
+    if (!fresh && std::memcmp(pixels, last, dataWidth) == 0) {
+      continue;
     }
-    buf_ptr += rowbytes; // add pitch
+    writePNGRow(&buffer[i * (rowbytes + 1)], pixels, dataWidth, palette,
+                doubleWidth);
+    std::memcpy(last, pixels, dataWidth);
   }
+}
+
+static void writePNGData(std::ofstream& out, const ALEScreen& screen,
+                         std::vector<uint8_t>& buffer,
+                         bool doubleWidth = true) {
+  int width = doubleWidth ? screen.width() * 2 : screen.width();
+  int height = screen.height();
 
   // Compress the data with zlib
   uLongf compmemsize = (uLongf)((height * (width + 1) * 3 + 1) + 12);
@@ -166,7 +193,8 @@ void ScreenExporter::save(const ALEScreen& screen,
 
   // Now write the PNG proper
   writePNGHeader(out, screen, true);
-  writePNGData(out, screen, m_palette, true);
+  fillPNGRows(m_rows, m_last_screen, screen, m_palette, true);
+  writePNGData(out, screen, m_rows, true);
   writePNGEnd(out);
 
   out.close();
@@ -18,6 +18,7 @@
 #define __SCREEN_EXPORTER_HPP__
 
 #include <string>
+#include <vector>
 
 #include "ale/common/Constants.h"
 #include "ale/common/ColourPalette.hpp"
@@ -51,6 +52,11 @@ class ScreenExporter {
 
   /** The directory where we save successive frames. */
   std::string m_path;
+
+  /** PNG scanline data of the last screen saved, and its pixels. Saving a
+   *  screen only converts the rows that differ from the last one. */
+  mutable std::vector<uint8_t> m_rows;
+  mutable std::vector<uint8_t> m_last_screen;
 };
 
 }  // namespace ale
@@ -35,6 +35,9 @@ public:
 
     // Displays the current frame buffer from the mediasource.
     void render();
+
+    // The screen is displayed, so render() has to be called every frame.
+    bool isNull() const { return false; }
 private:
     // Poll for SDL events.
     void poll();
@@ -0,0 +1,221 @@
+/******************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2013 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details.
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ *  SoundCapture.cxx
+ *
+ *  A sound object that synthesizes the TIA's audio into memory, without SDL.
+ **************************************************************************** */
+
+#include <algorithm>
+#include <cmath>
+
+#include "ale/emucore/Serializer.hxx"
+#include "ale/emucore/Deserializer.hxx"
+#include "ale/emucore/Settings.hxx"
+
+#include "ale/common/SoundCapture.hxx"
+
+namespace ale {
+using namespace stella;   // Settings, Serializer, Deserializer
+
+// The rate at which the system cycles of the NTSC console run
+static const double CyclesPerSecond = 1193191.66666667;
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+SoundCapture::SoundCapture(Settings* settings)
+  : Sound(settings),
+    myRate(31400),
+    myDownsample(1),
+    mySize(0),
+    myPosition(0),
+    myLastCycle(0),
+    myPendingSamples(0.0),
+    myDownsampleSum(0),
+    myDownsampleCount(0),
+    myVolume(100)
+{
+  if(mySettings->getInt("sound_capture_rate") > 0)
+    myRate = mySettings->getInt("sound_capture_rate");
+  if(mySettings->getInt("sound_capture_downsample") > 0)
+    myDownsample = mySettings->getInt("sound_capture_downsample");
+
+  // By default, keep the samples of one act()
+  int samples = mySettings->getInt("sound_capture_samples");
+  if(samples <= 0)
+  {
+    int frames = std::max(1, mySettings->getInt("frame_skip"));
+    samples = (int)std::ceil(sampleRate() / 60.0) * frames;
+  }
+  mySize = samples;
+
+  myTIASound.outputFrequency(myRate);
+  myTIASound.tiaFrequency(mySettings->getInt("tiafreq"));
+  myTIASound.channels(1);
+  myTIASound.clipVolume(mySettings->getBool("clipvol"));
+  setVolume(mySettings->getInt("volume"));
+
+  // Start out silent
+  uint8_t silence = mySettings->getBool("clipvol") ? 128 : 0;
+  myRing.assign(2 * mySize, silence);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+SoundCapture::~SoundCapture()
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundCapture::reset()
+{
+  myTIASound.reset();
+  myLastCycle = 0;
+  myPendingSamples = 0.0;
+  myDownsampleSum = 0;
+  myDownsampleCount = 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundCapture::adjustCycleCounter(int amount)
+{
+  // The samples since myLastCycle are synthesized by the next update()
+  myLastCycle += amount;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundCapture::set(uint16_t addr, uint8_t value, int cycle)
+{
+  // Synthesize the samples before the write with the old register values
+  update(cycle);
+  myTIASound.set(addr, value);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundCapture::setVolume(int percent)
+{
+  if((percent >= 0) && (percent <= 100))
+  {
+    myVolume = percent;
+    myTIASound.volume(percent);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundCapture::adjustVolume(int8_t direction)
+{
+  int percent = myVolume;
+
+  if(direction == -1)
+    percent -= 2;
+  else if(direction == 1)
+    percent += 2;
+
+  setVolume(percent);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundCapture::update(int cycle)
+{
+  // A restored state may be behind the samples; start again from there
+  if(cycle <= myLastCycle)
+  {
+    myLastCycle = cycle;
+    return;
+  }
+
+  myPendingSamples += (cycle - myLastCycle) * (myRate / CyclesPerSecond);
+  myLastCycle = cycle;
+
+  uint32_t count = (uint32_t)myPendingSamples;
+  myPendingSamples -= count;
+  if(count == 0)
+    return;
+
+  if(myScratch.size() < count)
+    myScratch.resize(count);
+  myTIASound.process(myScratch.data(), count);
+
+  if(myDownsample == 1)
+  {
+    for(uint32_t i = 0; i < count; ++i)
+      push(myScratch[i]);
+    return;
+  }
+
+  for(uint32_t i = 0; i < count; ++i)
+  {
+    myDownsampleSum += myScratch[i];
+    if(++myDownsampleCount == myDownsample)
+    {
+      push((myDownsampleSum + myDownsample / 2) / myDownsample);
+      myDownsampleSum = 0;
+      myDownsampleCount = 0;
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+inline void SoundCapture::push(uint8_t sample)
+{
+  myRing[myPosition] = sample;
+  myRing[myPosition + mySize] = sample;
+  if(++myPosition == mySize)
+    myPosition = 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+double SoundCapture::sampleRate() const
+{
+  return (double)myRate / myDownsample;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool SoundCapture::load(Deserializer& in)
+{
+  if(in.getString() != "TIASound")
+    return false;
+
+  uint8_t reg1 = (uint8_t) in.getInt();
+  uint8_t reg2 = (uint8_t) in.getInt();
+  uint8_t reg3 = (uint8_t) in.getInt();
+  uint8_t reg4 = (uint8_t) in.getInt();
+  uint8_t reg5 = (uint8_t) in.getInt();
+  uint8_t reg6 = (uint8_t) in.getInt();
+
+  myTIASound.set(0x15, reg1);
+  myTIASound.set(0x16, reg2);
+  myTIASound.set(0x17, reg3);
+  myTIASound.set(0x18, reg4);
+  myTIASound.set(0x19, reg5);
+  myTIASound.set(0x1a, reg6);
+
+  myLastCycle = (int) in.getInt();
+  myPendingSamples = 0.0;
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool SoundCapture::save(Serializer& out)
+{
+  out.putString("TIASound");
+
+  out.putInt(myTIASound.get(0x15));
+  out.putInt(myTIASound.get(0x16));
+  out.putInt(myTIASound.get(0x17));
+  out.putInt(myTIASound.get(0x18));
+  out.putInt(myTIASound.get(0x19));
+  out.putInt(myTIASound.get(0x1a));
+
+  out.putInt(myLastCycle);
+
+  return true;
+}
+
+}  // namespace ale
@@ -0,0 +1,237 @@
+/******************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2013 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details.
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ *  SoundCapture.hxx
+ *
+ *  A sound object that synthesizes the TIA's audio into memory, without SDL.
+ **************************************************************************** */
+
+#ifndef SOUND_CAPTURE_HXX
+#define SOUND_CAPTURE_HXX
+
+namespace ale {
+namespace stella {
+
+class Settings;
+class Serializer;
+class Deserializer;
+
+}  // namespace stella
+}  // namespace ale
+
+#include <cstdint>
+#include <vector>
+
+#include "ale/emucore/Sound.hxx"
+#include "ale/emucore/TIASnd.hxx"
+
+namespace ale {
+
+/**
+  This class implements a headless sound object, which synthesizes the
+  samples of the TIA's audio registers as the emulation runs and keeps the
+  most recent ones in a ring buffer.  Register writes are applied at the
+  sample they fall on, timed by the system cycle of the write, so the
+  samples do not depend on how often they are read.
+
+  The samples are unsigned 8-bit mono, synthesized at "sound_capture_rate"
+  Hz and averaged over groups of "sound_capture_downsample" samples.  The
+  ring buffer holds "sound_capture_samples" of them, or one act()'s worth
+  of frames (at 60 Hz) if that is not positive.  It is mirrored, so the
+  whole window is always contiguous in memory.
+*/
+class SoundCapture : public stella::Sound
+{
+  public:
+    /**
+      Create a new sound object, configured from the given settings
+    */
+    SoundCapture(stella::Settings* settings);
+
+    /**
+      Destructor
+    */
+    virtual ~SoundCapture();
+
+  public:
+    /**
+      Enables/disables the sound subsystem.  Capture is always enabled.
+    */
+    void setEnabled(bool) { }
+
+    /**
+      The system cycle counter is being adjusting by the specified amount.
+      Any members using the system cycle counter should be adjusted as needed.
+
+      @param amount The amount the cycle counter is being adjusted by
+    */
+    void adjustCycleCounter(int amount);
+
+    /**
+      Sets the number of channels.  Capture is always mono.
+    */
+    void setChannels(uint32_t) { }
+
+    /**
+      Sets the display framerate.  Samples are timed by system cycles, so
+      the framerate does not matter.
+    */
+    void setFrameRate(uint32_t) { }
+
+    /**
+      Initializes the sound device.  There is nothing to initialize.
+    */
+    void initialize() { }
+
+    /**
+      Should be called to close the sound device.  There is nothing to close.
+    */
+    void close() { }
+
+    /**
+      Return true iff the sound device was successfully initialized.
+
+      @return Always true
+    */
+    bool isSuccessfullyInitialized() const { return true; }
+
+    /**
+      Set the mute state of the sound object.  Capture is never muted.
+    */
+    void mute(bool) { }
+
+    /**
+      Reset the sound device.  The samples captured so far are kept.
+    */
+    void reset();
+
+    /**
+      Sets the sound register to a given value.
+
+      @param addr  The register address
+      @param value The value to save into the register
+      @param cycle The system cycle at which the register is being updated
+    */
+    void set(uint16_t addr, uint8_t value, int cycle);
+
+    /**
+      Sets the volume of the sound device to the specified level.  The
+      volume is given as a percentage from 0 to 100.  Values outside
+      this range indicate that the volume shouldn't be changed at all.
+
+      @param percent The new volume percentage level for the sound device
+    */
+    void setVolume(int percent);
+
+    /**
+      Adjusts the volume of the sound device based on the given direction.
+
+      @param direction  Increase or decrease the current volume by a predefined
+                        amount based on the direction (1 = increase, -1 =decrease)
+    */
+    void adjustVolume(int8_t direction);
+
+    /**
+      Tells the sound engine to record one frame's worth of sound.  The
+      samples are captured whether or not this is called.
+    */
+    void recordNextFrame() { }
+
+  public:
+    /**
+      Synthesizes the samples up to the given system cycle.
+
+      @param cycle The current system cycle
+    */
+    void update(int cycle);
+
+    /**
+      Answers the most recent samples, oldest first
+
+      @return Pointer to size() samples
+    */
+    const uint8_t* samples() const { return &myRing[myPosition]; }
+
+    /**
+      Answers the number of samples in the ring buffer
+
+      @return The number of samples
+    */
+    uint32_t size() const { return mySize; }
+
+    /**
+      Answers the rate of the captured samples, after downsampling
+
+      @return The sample rate in Hz
+    */
+    double sampleRate() const;
+
+  public:
+    /**
+      Loads the current state of this device from the given Deserializer.
+
+      @param in The deserializer device to load from.
+      @return The result of the load.  True on success, false on failure.
+    */
+    bool load(stella::Deserializer& in);
+
+    /**
+      Saves the current state of this device to the given Serializer.
+
+      @param out The serializer device to save to.
+      @return The result of the save.  True on success, false on failure.
+    */
+    bool save(stella::Serializer& out);
+
+  private:
+    // Appends a downsampled sample to the ring buffer
+    void push(uint8_t sample);
+
+  private:
+    // TIASound emulation object
+    stella::TIASound myTIASound;
+
+    // Sample rate of the TIASound object
+    uint32_t myRate;
+
+    // Number of synthesized samples averaged into each captured sample
+    uint32_t myDownsample;
+
+    // Number of samples in the ring buffer
+    uint32_t mySize;
+
+    // The ring buffer, twice mySize long: each sample is written at
+    // myPosition and myPosition + mySize, so that the window starting at
+    // myPosition holds the last mySize samples in order
+    std::vector<uint8_t> myRing;
+
+    // Index of the oldest sample in the ring buffer
+    uint32_t myPosition;
+
+    // The system cycle up to which samples have been synthesized
+    int myLastCycle;
+
+    // Fraction of a sample synthesized up to myLastCycle but not yet output
+    double myPendingSamples;
+
+    // Sum and number of synthesized samples not yet averaged
+    uint32_t myDownsampleSum;
+    uint32_t myDownsampleCount;
+
+    // Scratch space for synthesized samples
+    std::vector<uint8_t> myScratch;
+
+    // Volume percentage level
+    int myVolume;
+};
+
+}  // namespace ale
+
+#endif
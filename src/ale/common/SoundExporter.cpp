@@ -1,7 +1,10 @@
 #include "ale/common/SoundExporter.hpp"
 
+#include <algorithm>
 #include <cassert>
 
+#include "ale/common/Log.hpp"
+
 namespace ale {
 namespace sound {
 
@@ -9,56 +12,136 @@ namespace sound {
 // TODO(mgb): in reality this should be 31,400 Hz, but currently we are just short of this
 static const unsigned int SampleRate = 60 * SoundExporter::SamplesPerFrame;
 
-// Save wav file every 30 seconds
+// Patch the wav header every 30 seconds
 static const unsigned int WriteInterval = SampleRate * 30;
 
-SoundExporter::SoundExporter(const std::string& filename, int channels)
-    : m_filename(filename), m_channels(channels), m_samples_since_write(0) {}
+// Hand samples over to be written once a second's worth is buffered
+static const size_t BufferSize = SampleRate;
+
+SoundExporter::SoundExporter(const std::string& filename, int channels,
+                             bool background_writer)
+    : m_filename(filename),
+      m_stream(filename.c_str(), std::ios::binary),
+      m_channels(channels),
+      m_data_size(0),
+      m_samples_since_write(0),
+      m_has_pending(false),
+      m_stop(false) {
+  if (!m_stream) {
+    Logger::Warning << "Could not open " << m_filename << " to record sound."
+                    << std::endl;
+  }
+  m_buffer.reserve(BufferSize);
+  writeWAVHeader();
 
-SoundExporter::~SoundExporter() { writeWAVData(); }
+  if (background_writer) {
+    m_pending.reserve(BufferSize);
+    m_writer = std::thread(&SoundExporter::writerLoop, this);
+  }
+}
+
+SoundExporter::~SoundExporter() {
+  flushBuffer();
+  if (m_writer.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stop = true;
+    }
+    m_cv.notify_all();
+    m_writer.join();
+  }
+  writeWAVHeader();
+}
 
 void SoundExporter::addSamples(SampleType* s, int len) {
   // @todo -- currently we only support mono recording
   assert(m_channels == 1);
 
-  for (int i = 0; i < len; i++)
-    m_data.push_back(s[i]);
+  while (len > 0) {
+    int count = std::min<size_t>(len, BufferSize - m_buffer.size());
+    m_buffer.insert(m_buffer.end(), s, s + count);
+    s += count;
+    len -= count;
+
+    if (m_buffer.size() == BufferSize) flushBuffer();
+  }
+}
+
+void SoundExporter::flushBuffer() {
+  if (m_buffer.empty()) return;
+
+  if (!m_writer.joinable()) {
+    writeWAVData(m_buffer);
+    m_buffer.clear();
+    return;
+  }
+
+  // Wait for the writer to take the previous buffer, then swap in this one
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_cv.wait(lock, [this] { return !m_has_pending; });
+  m_buffer.swap(m_pending);
+  m_buffer.clear();
+  m_has_pending = true;
+  lock.unlock();
+  m_cv.notify_all();
+}
+
+void SoundExporter::writerLoop() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  for (;;) {
+    m_cv.wait(lock, [this] { return m_has_pending || m_stop; });
+    if (!m_has_pending) return;
 
-  // Periodically flush to disk (to avoid cases where the destructor is not called)
-  m_samples_since_write += len;
+    // The producer does not touch m_pending until it is marked as written
+    lock.unlock();
+    writeWAVData(m_pending);
+    lock.lock();
+    m_has_pending = false;
+    m_cv.notify_all();
+  }
+}
+
+void SoundExporter::writeWAVData(const std::vector<SampleType>& samples) {
+  m_stream.write((const char*)samples.data(), samples.size());  // The samples DATA!!!
+  m_data_size += samples.size();
+
+  // Periodically patch the header (to avoid cases where the destructor is not called)
+  m_samples_since_write += samples.size();
   if (m_samples_since_write >= WriteInterval) {
-    writeWAVData();
+    writeWAVHeader();
     m_samples_since_write = 0;
   }
 }
 
-void SoundExporter::writeWAVData() {
+void SoundExporter::writeWAVHeader() {
   // Taken from http://stackoverflow.com/questions/22226872/two-problems-when-writing-to-wav-c
-  // Open file stream
-  std::ofstream stream(m_filename.c_str(), std::ios::binary);
+  // The header is rewritten in place, and the stream left at the end of the data
+  m_stream.seekp(0, std::ios::beg);
 
   // Cast size into a 32-bit integer
-  int bufSize = m_data.size();
+  int bufSize = m_data_size;
 
   // Header
-  stream.write("RIFF", 4);          // sGroupID (RIFF = Resource Interchange File Format)
-  write<int>(stream, 36 + bufSize); // dwFileLength
-  stream.write("WAVE", 4);          // sRiffType
+  m_stream.write("RIFF", 4);          // sGroupID (RIFF = Resource Interchange File Format)
+  write<int>(m_stream, 36 + bufSize); // dwFileLength
+  m_stream.write("WAVE", 4);          // sRiffType
 
   // Format chunk
-  stream.write("fmt ", 4);          // sGroupID (fmt = format)
-  write<int>(stream, 16);           // Chunk size (of Format Chunk)
-  write<short>(stream, 1);          // Format (1 = PCM)
-  write<short>(stream, m_channels); // Channels
-  write<int>(stream, SampleRate);   // Sample Rate
-  write<int>(stream, SampleRate * m_channels * sizeof(SampleType));  // Byterate
-  write<short>(stream, m_channels * sizeof(SampleType));             // Frame size aka Block align
-  write<short>(stream, 8 * sizeof(SampleType));                      // Bits per sample
+  m_stream.write("fmt ", 4);          // sGroupID (fmt = format)
+  write<int>(m_stream, 16);           // Chunk size (of Format Chunk)
+  write<short>(m_stream, 1);          // Format (1 = PCM)
+  write<short>(m_stream, m_channels); // Channels
+  write<int>(m_stream, SampleRate);   // Sample Rate
+  write<int>(m_stream, SampleRate * m_channels * sizeof(SampleType));  // Byterate
+  write<short>(m_stream, m_channels * sizeof(SampleType));             // Frame size aka Block align
+  write<short>(m_stream, 8 * sizeof(SampleType));                      // Bits per sample
 
   // Data chunk
-  stream.write("data", 4);                         // sGroupID (data)
-  stream.write((const char*)&bufSize, 4);          // Chunk size (of Data, and thus of bufferSize)
-  stream.write((const char*)&m_data[0], bufSize);  // The samples DATA!!!
+  m_stream.write("data", 4);                 // sGroupID (data)
+  m_stream.write((const char*)&bufSize, 4);  // Chunk size (of Data, and thus of bufferSize)
+
+  m_stream.seekp(0, std::ios::end);
+  m_stream.flush();
 }
 
 }  // namespace sound
@@ -11,7 +11,7 @@
  * *****************************************************************************
  *  SoundExporter.hpp
  *
- *  A class for writing Atari 2600 sound to a WAV file.
+ *  A class for streaming Atari 2600 sound to a WAV file.
  *
  *  Parts of this code were taken from
  *
@@ -22,7 +22,11 @@
 #ifndef __SOUND_EXPORTER_HPP__
 #define __SOUND_EXPORTER_HPP__
 
+#include <condition_variable>
 #include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
 #include <vector>
 #include <cstdint>
 
@@ -40,28 +44,53 @@ class SoundExporter {
 
   using SampleType = uint8_t;
 
-  /** Create a new sound exporter which, on program termination, will write out a wav file. */
-  SoundExporter(const std::string& filename, int channels);
+  /** Create a new sound exporter which streams a wav file to disk as samples are added.
+   *  The header is patched with the current length every 30 seconds of audio, so the
+   *  file stays playable if the program never terminates cleanly. With
+   *  background_writer, a separate thread does the disk writes, and addSamples() only
+   *  waits for it when a whole buffer is still waiting to be written. */
+  SoundExporter(const std::string& filename, int channels, bool background_writer = false);
   ~SoundExporter();
 
   /** Adds a buffer of samples. */
   void addSamples(SampleType* s, int len);
 
  private:
-  /** Writes the data to disk. */
-  void writeWAVData();
+  /** Writes the header, with the length of the data written so far. */
+  void writeWAVHeader();
+
+  /** Hands the buffered samples over to be written to disk. */
+  void flushBuffer();
+
+  /** Appends samples to the file, patching the header periodically. */
+  void writeWAVData(const std::vector<SampleType>& samples);
+
+  /** The body of the background writer thread. */
+  void writerLoop();
 
   /** The file to save our audio to. */
   std::string m_filename;
+  std::ofstream m_stream;
 
   /** Number of channels. */
   int m_channels;
 
-  /** The sound data. */
-  std::vector<SampleType> m_data;
+  /** Samples not yet handed over to be written, at most BufferSize of them. */
+  std::vector<SampleType> m_buffer;
 
-  /** Keep track of how many samples have been written since the last write to disk */
+  /** Number of bytes of sample data written to the file. */
+  uint32_t m_data_size;
+
+  /** Keep track of how many samples have been written since the header was patched */
   size_t m_samples_since_write;
+
+  /** The background writer, if any, and the full buffer it is to write next. */
+  std::thread m_writer;
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  std::vector<SampleType> m_pending;
+  bool m_has_pending;
+  bool m_stop;
 };
 
 }  // namespace sound
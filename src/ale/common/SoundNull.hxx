@@ -148,6 +148,11 @@ class SoundNull : public stella::Sound
       */
     virtual void recordNextFrame() { }
 
+    /**
+      This sound object ignores everything it is given.
+    */
+    bool isNull() const { return true; }
+
 public:
     /**
       Loads the current state of this device from the given Deserializer.
@@ -52,8 +52,10 @@ SoundSDL::SoundSDL(Settings* settings)
 
     if (mySettings->getString("record_sound_filename").size() > 0) {
 
+        // Samples are added from the audio callback, so keep disk writes off
+        // its thread
         std::string filename = mySettings->getString("record_sound_filename");
-        mySoundExporter.reset(new ale::sound::SoundExporter(filename, myNumChannels));
+        mySoundExporter.reset(new ale::sound::SoundExporter(filename, myNumChannels, true));
     }
 }
 
@@ -0,0 +1,94 @@
+/* *****************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2013 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details.
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ *  StateHash.hpp
+ *
+ *  Incremental 64-bit hash used by ALEInterface::stateHash(). Devices feed
+ *  their registers and memory straight into it, without serializing.
+ *
+ **************************************************************************** */
+
+#ifndef __STATE_HASH_HPP__
+#define __STATE_HASH_HPP__
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace ale {
+
+/** An xxHash64-style hash over a stream of 64-bit words. Words are spread
+ *  round-robin over four independent accumulators so that consecutive
+ *  multiplies do not wait on each other, and the accumulators are merged and
+ *  avalanched by value(). Not suitable for cryptographic purposes. */
+class StateHash {
+ public:
+  explicit StateHash(uint64_t seed = 0)
+      : m_acc{seed + Prime1 + Prime2, seed + Prime2, seed, seed - Prime1},
+        m_words(0) {}
+
+  /** Mixes in a single value. */
+  void update(uint64_t value) {
+    uint64_t& acc = m_acc[m_words++ & 3];
+    acc = round(acc, value);
+  }
+
+  /** Mixes in a block of memory, eight bytes at a time. The length is
+   *  included, so blocks differing only in trailing zeros hash differently. */
+  void update(const void* data, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (; size >= 8; bytes += 8, size -= 8) {
+      uint64_t word;
+      std::memcpy(&word, bytes, 8);
+      update(word);
+    }
+    uint64_t tail = uint64_t(size) << 56;
+    std::memcpy(&tail, bytes, size);
+    update(tail);
+  }
+
+  /** Returns the hash of everything mixed in so far. */
+  uint64_t value() const {
+    uint64_t h = rotl(m_acc[0], 1) + rotl(m_acc[1], 7) + rotl(m_acc[2], 12) +
+                 rotl(m_acc[3], 18);
+    for (uint64_t acc : m_acc) {
+      h = (h ^ round(0, acc)) * Prime1 + Prime4;
+    }
+    h += m_words * 8;
+
+    h ^= h >> 33;
+    h *= Prime2;
+    h ^= h >> 29;
+    h *= Prime3;
+    h ^= h >> 32;
+    return h;
+  }
+
+ private:
+  static constexpr uint64_t Prime1 = 0x9E3779B185EBCA87ULL;
+  static constexpr uint64_t Prime2 = 0xC2B2AE3D27D4EB4FULL;
+  static constexpr uint64_t Prime3 = 0x165667B19E3779F9ULL;
+  static constexpr uint64_t Prime4 = 0x85EBCA77C2B2AE63ULL;
+
+  static uint64_t rotl(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+  static uint64_t round(uint64_t acc, uint64_t value) {
+    acc += value * Prime2;
+    acc = rotl(acc, 31);
+    return acc * Prime1;
+  }
+
+  uint64_t m_acc[4];
+  uint64_t m_words;  // Number of words mixed in
+};
+
+}  // namespace ale
+
+#endif  // __STATE_HASH_HPP__
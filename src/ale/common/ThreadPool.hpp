@@ -0,0 +1,60 @@
+/* *****************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2013 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details.
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ *  ThreadPool.hpp
+ *
+ *  A fixed-size pool of worker threads consuming a FIFO of tasks.
+ *
+ **************************************************************************** */
+
+#ifndef __THREAD_POOL_HPP__
+#define __THREAD_POOL_HPP__
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ale {
+
+class ThreadPool {
+ public:
+  /** Starts num_threads workers; 0 uses the number of hardware threads. */
+  explicit ThreadPool(size_t num_threads = 0);
+
+  /** Finishes the queued tasks, then joins the workers. */
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  /** Queues a task. Tasks must not throw; callers that need to report
+   *  errors should capture them inside the task. */
+  void submit(std::function<void()> task);
+
+  /** Number of worker threads. */
+  size_t size() const { return m_workers.size(); }
+
+ private:
+  void workerLoop();
+
+  std::vector<std::thread> m_workers;
+  std::deque<std::function<void()>> m_tasks;
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  bool m_stop;
+};
+
+}  // namespace ale
+
+#endif  // __THREAD_POOL_HPP__
@@ -16,10 +16,13 @@
 // $Id: Cart.cxx,v 1.34 2007/06/14 13:47:50 stephena Exp $
 //============================================================================
 
+#include <algorithm>
 #include <string>
+#include <vector>
 #include <cstring>
 
 #include <cassert>
+#include <random>
 #include <sstream>
 
 #include "ale/emucore/Cart.hxx"
@@ -45,9 +48,13 @@
 #include "ale/emucore/CartMB.hxx"
 #include "ale/emucore/CartCV.hxx"
 #include "ale/emucore/CartUA.hxx"
+#include "ale/emucore/Deserializer.hxx"
 #include "ale/emucore/MD5.hxx"
 #include "ale/emucore/Props.hxx"
+#include "ale/emucore/Random.hxx"
+#include "ale/emucore/Serializer.hxx"
 #include "ale/emucore/Settings.hxx"
+#include "ale/common/StateHash.hpp"
 
 namespace ale {
 namespace stella {
@@ -175,6 +182,12 @@ bool Cartridge::save(std::ofstream& out)
   return true;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Cartridge::hash(StateHash& out)
+{
+  out.update(uint64_t(bank()));
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 std::string Cartridge::autodetectType(const uint8_t* image, uint32_t size)
 {
@@ -462,6 +475,70 @@ bool Cartridge::isProbablyFE(const uint8_t* image, uint32_t size)
   return false;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uint32_t Cartridge::drawRAMSeed(Random& rng, uint32_t size)
+{
+  uint32_t seed = rng.next();
+  for(uint32_t i = 1; i < size; ++i)
+    rng.next();
+
+  return seed;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Cartridge::randomizeRAM(uint8_t* ram, uint32_t size, uint32_t seed)
+{
+  std::mt19937 generator(seed);
+  for(uint32_t i = 0; i < size; ++i)
+    ram[i] = (uint8_t) generator();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Cartridge::saveRAMPages(Serializer& out, const uint8_t* ram,
+                             const uint8_t* baseline, uint32_t size)
+{
+  uint32_t pages = (size + RAMPageSize - 1) / RAMPageSize;
+  std::vector<uint32_t> dirty;
+  for(uint32_t page = 0; page < pages; ++page)
+  {
+    uint32_t offset = page * RAMPageSize;
+    uint32_t length = std::min<uint32_t>(RAMPageSize, size - offset);
+    if(std::memcmp(ram + offset, baseline + offset, length) != 0)
+      dirty.push_back(page);
+  }
+
+  out.putInt(size);
+  out.putInt(dirty.size());
+  for(uint32_t page : dirty)
+  {
+    uint32_t offset = page * RAMPageSize;
+    out.putInt(page);
+    out.putByteArray(ram + offset, std::min<uint32_t>(RAMPageSize, size - offset));
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Cartridge::loadRAMPages(Deserializer& in, uint8_t* ram,
+                             const uint8_t* baseline, uint32_t size)
+{
+  if((uint32_t) in.getInt() != size)
+    throw "Cartridge: RAM size mismatch";
+
+  std::memcpy(ram, baseline, size);
+
+  uint32_t pages = (size + RAMPageSize - 1) / RAMPageSize;
+  uint32_t dirty = (uint32_t) in.getInt();
+  for(uint32_t i = 0; i < dirty; ++i)
+  {
+    uint32_t page = (uint32_t) in.getInt();
+    if(page >= pages)
+      throw "Cartridge: RAM page out of range";
+
+    uint32_t offset = page * RAMPageSize;
+    in.getByteArray(ram + offset, std::min<uint32_t>(RAMPageSize, size - offset));
+  }
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Cartridge::Cartridge(const Cartridge&)
 {
@@ -25,6 +25,7 @@ namespace stella {
 class Cartridge;
 class System;
 class Properties;
+class Random;
 class Settings;
 
 }  // namespace stella
@@ -85,6 +86,14 @@ class Cartridge : public Device
     /** MGB: Added to drop warning on overloaded save() method. */
     virtual bool save(Serializer& out) = 0;
 
+    /**
+      Mixes the current bank into the given hash.  Cartridges with RAM or
+      other registers extend this.
+
+      @param out The hash to update
+    */
+    virtual void hash(StateHash& out);
+
     /**
       Lock/unlock bankswitching capability.
     */
@@ -131,6 +140,52 @@ class Cartridge : public Device
     virtual uint8_t* getImage(int& size) = 0;
 
   protected:
+    /**
+      Draws the seed of the power-on pattern of extended cartridge RAM
+      from the system RNG.  The RNG is advanced by one draw per byte of
+      RAM, as when every byte was drawn from it, so that the values seen
+      by the rest of the console on reset do not depend on the seeding.
+
+      @param rng   The system RNG
+      @param size  The size of the RAM in bytes
+      @return      The seed of the pattern
+    */
+    static uint32_t drawRAMSeed(Random& rng, uint32_t size);
+
+    /**
+      Fills extended cartridge RAM with the pseudo-random power-on pattern
+      derived from the given seed.  Cartridges draw a single seed from the
+      system RNG on reset, so the pattern can be rebuilt when a state is
+      loaded and only the pages modified since then need to be saved.
+
+      @param ram   The RAM to fill
+      @param size  The size of the RAM in bytes
+      @param seed  The seed of the pattern
+    */
+    static void randomizeRAM(uint8_t* ram, uint32_t size, uint32_t seed);
+
+    /**
+      Saves the RAM pages (of RAMPageSize bytes) which differ from the
+      given baseline, packed one byte per value.
+
+      @param out       The serializer to write to
+      @param ram       The current RAM contents
+      @param baseline  The RAM contents after reset
+      @param size      The size of the RAM in bytes
+    */
+    static void saveRAMPages(Serializer& out, const uint8_t* ram,
+                             const uint8_t* baseline, uint32_t size);
+
+    /**
+      Restores RAM saved by saveRAMPages: the baseline, overwritten with
+      the saved pages.  Throws if the saved size does not match.
+    */
+    static void loadRAMPages(Deserializer& in, uint8_t* ram,
+                             const uint8_t* baseline, uint32_t size);
+
+    // Granularity of the dirty page comparison in saveRAMPages
+    enum { RAMPageSize = 256 };
+
     // If bankLocked is true, ignore attempts at bankswitching. This is used
     // by the debugger, when disassembling/dumping ROM.
     bool bankLocked;
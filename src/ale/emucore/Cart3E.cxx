@@ -17,11 +17,13 @@
 //============================================================================
 
 #include <cassert>
+#include <cstring>
 
 #include "ale/emucore/System.hxx"
 #include "ale/emucore/TIA.hxx"
 #include "ale/emucore/Serializer.hxx"
 #include "ale/emucore/Deserializer.hxx"
+#include "ale/common/StateHash.hpp"
 #include "ale/emucore/Cart3E.hxx"
 
 namespace ale {
@@ -57,8 +59,9 @@ const char* Cartridge3E::name() const
 void Cartridge3E::reset()
 {
   // Initialize RAM with random values
-  for(uint32_t i = 0; i < 32768; ++i)
-    myRam[i] = mySystem->rng().next();
+  myRamSeed = drawRAMSeed(mySystem->rng(), 32768);
+  randomizeRAM(myInitialRam, 32768, myRamSeed);
+  std::memcpy(myRam, myInitialRam, 32768);
 
   // We'll map bank 0 into the first segment upon reset
   bank(0);
@@ -150,10 +153,9 @@ bool Cartridge3E::save(Serializer& out)
     out.putString(cart);
     out.putInt(myCurrentBank);
 
-    // Output RAM
-    out.putInt(32768);
-    for(uint32_t addr = 0; addr < 32768; ++addr)
-      out.putInt(myRam[addr]);
+    // Output the RAM pages modified since reset
+    out.putInt(myRamSeed);
+    saveRAMPages(out, myRam, myInitialRam, 32768);
   }
   catch(const char* msg)
   {
@@ -181,10 +183,14 @@ bool Cartridge3E::load(Deserializer& in)
 
     myCurrentBank = (uint16_t) in.getInt();
 
-    // Input RAM
-    uint32_t limit = (uint32_t) in.getInt();
-    for(uint32_t addr = 0; addr < limit; ++addr)
-      myRam[addr] = (uint8_t) in.getInt();
+    // Input RAM, rebuilding the power-on pattern if it came from another reset
+    uint32_t seed = (uint32_t) in.getInt();
+    if(seed != myRamSeed)
+    {
+      myRamSeed = seed;
+      randomizeRAM(myInitialRam, 32768, myRamSeed);
+    }
+    loadRAMPages(in, myRam, myInitialRam, 32768);
   }
   catch(const char* msg)
   {
@@ -203,6 +209,13 @@ bool Cartridge3E::load(Deserializer& in)
   return true;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Cartridge3E::hash(StateHash& out)
+{
+  Cartridge::hash(out);
+  out.update(myRam, sizeof(myRam));
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Cartridge3E::bank(uint16_t bank)
 {
@@ -123,6 +123,13 @@ class Cartridge3E : public Cartridge
     */
     virtual bool load(Deserializer& in);
 
+    /**
+      Mixes the state of this device into the given hash.
+
+      @param out The hash to update
+    */
+    virtual void hash(StateHash& out);
+
     /**
       Install pages for the specified bank in the system.
 
@@ -185,6 +192,10 @@ class Cartridge3E : public Cartridge
     // RAM contents. For now every ROM gets all 32K of potential RAM
     uint8_t myRam[32768];
 
+    // Seed of the power-on RAM pattern and the pattern itself
+    uint32_t myRamSeed;
+    uint8_t myInitialRam[32768];
+
     // Size of the ROM image
     uint32_t mySize;
 };
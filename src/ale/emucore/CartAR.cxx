@@ -24,6 +24,7 @@
 #include "ale/emucore/System.hxx"
 #include "ale/emucore/Serializer.hxx"
 #include "ale/emucore/Deserializer.hxx"
+#include "ale/common/StateHash.hpp"
 #include "ale/emucore/CartAR.hxx"
 
 namespace ale {
@@ -58,8 +59,9 @@ const char* CartridgeAR::name() const
 void CartridgeAR::reset()
 {
   // Initialize RAM with random values
-  for(uint32_t i = 0; i < 6 * 1024; ++i)
-    myImage[i] = mySystem->rng().next();
+  myRAMSeed = drawRAMSeed(mySystem->rng(), 6 * 1024);
+  randomizeRAM(myInitialRAM, 6 * 1024, myRAMSeed);
+  std::memcpy(myImage, myInitialRAM, 6 * 1024);
 
   myPower = true;
   myPowerRomCycle = mySystem->cycles();
@@ -291,7 +293,7 @@ void CartridgeAR::bankConfiguration(uint8_t configuration)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void CartridgeAR::initializeROM(bool fastbios)
 {
-  static uint8_t dummyROMCode[] = {
+  static const uint8_t dummyROMCode[] = {
     0xa5, 0xfa, 0x85, 0x80, 0x4c, 0x18, 0xf8, 0xff,
     0xff, 0xff, 0x78, 0xd8, 0xa0, 0x0, 0xa2, 0x0,
     0x94, 0x0, 0xe8, 0xd0, 0xfb, 0x4c, 0x50, 0xf8,
@@ -331,11 +333,6 @@ void CartridgeAR::initializeROM(bool fastbios)
     0x4c
   };
 
-  // If fastbios is enabled, set the wait time between vertical bars
-  // to 0 (default is 8), which is stored at address 189 of the bios
-  if(fastbios)
-    dummyROMCode[189] = 0x0;
-
   uint32_t size = sizeof(dummyROMCode);
 
   // Initialize ROM with illegal 6502 opcode that causes a real 6502 to jam
@@ -350,6 +347,12 @@ void CartridgeAR::initializeROM(bool fastbios)
     myImage[3 * 2048 + j] = dummyROMCode[j];
   }
 
+  // If fastbios is enabled, set the wait time between vertical bars
+  // to 0 (default is 8), which is stored at address 189 of the bios.
+  // This is patched in the copy, since the code is shared by every cartridge.
+  if(fastbios)
+    myImage[3 * 2048 + 189] = 0x0;
+
   // Finally set 6502 vectors to point to initial load code at 0xF80A of BIOS
   myImage[3 * 2048 + 2044] = 0x0A;
   myImage[3 * 2048 + 2045] = 0xF8;
@@ -443,24 +446,13 @@ bool CartridgeAR::save(Serializer& out)
     for(i = 0; i < 2; ++i)
       out.putInt(myImageOffset[i]);
 
-    // The 6K of RAM and 2K of ROM contained in the Supercharger
-    out.putInt(8192);
-    for(i = 0; i < 8192; ++i)
-      out.putInt(myImage[i]);
+    // The pages of the 6K of RAM modified since reset. The 2K of ROM and
+    // the load images never change, so they are not saved.
+    out.putInt(myRAMSeed);
+    saveRAMPages(out, myImage, myInitialRAM, 6 * 1024);
 
     // The 256 byte header for the current 8448 byte load
-    out.putInt(256);
-    for(i = 0; i < 256; ++i)
-      out.putInt(myHeader[i]);
-
-    // All of the 8448 byte loads associated with the game
-    // Note that the size of this array is myNumberOfLoadImages * 8448
-    out.putInt(myNumberOfLoadImages * 8448);
-    for(i = 0; i < (uint32_t) myNumberOfLoadImages * 8448; ++i)
-      out.putInt(myLoadImages[i]);
-
-    // Indicates how many 8448 loads there are
-    out.putInt(myNumberOfLoadImages);
+    out.putByteArray(myHeader, 256);
 
     // Indicates if the RAM is write enabled
     out.putBool(myWriteEnabled);
@@ -511,24 +503,17 @@ bool CartridgeAR::load(Deserializer& in)
     for(i = 0; i < limit; ++i)
       myImageOffset[i] = (uint32_t) in.getInt();
 
-    // The 6K of RAM and 2K of ROM contained in the Supercharger
-    limit = (uint32_t) in.getInt();
-    for(i = 0; i < limit; ++i)
-      myImage[i] = (uint8_t) in.getInt();
+    // The 6K of RAM, rebuilding the power-on pattern if needed
+    uint32_t seed = (uint32_t) in.getInt();
+    if(seed != myRAMSeed)
+    {
+      myRAMSeed = seed;
+      randomizeRAM(myInitialRAM, 6 * 1024, myRAMSeed);
+    }
+    loadRAMPages(in, myImage, myInitialRAM, 6 * 1024);
 
     // The 256 byte header for the current 8448 byte load
-    limit = (uint32_t) in.getInt();
-    for(i = 0; i < limit; ++i)
-      myHeader[i] = (uint8_t) in.getInt();
-
-    // All of the 8448 byte loads associated with the game
-    // Note that the size of this array is myNumberOfLoadImages * 8448
-    limit = (uint32_t) in.getInt();
-    for(i = 0; i < limit; ++i)
-      myLoadImages[i] = (uint8_t) in.getInt();
-
-    // Indicates how many 8448 loads there are
-    myNumberOfLoadImages = (uint8_t) in.getInt();
+    in.getByteArray(myHeader, 256);
 
     // Indicates if the RAM is write enabled
     myWriteEnabled = in.getBool();
@@ -562,6 +547,21 @@ bool CartridgeAR::load(Deserializer& in)
   return true;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CartridgeAR::hash(StateHash& out)
+{
+  Cartridge::hash(out);
+  out.update(myImageOffset[0]);
+  out.update(myImageOffset[1]);
+
+  // The 6K of RAM; the BIOS ROM that follows never changes
+  out.update(myImage, 6 * 1024);
+  out.update(myWriteEnabled);
+  out.update(myPower);
+  out.update(myDataHoldRegister);
+  out.update(myWritePending);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void CartridgeAR::bank(uint16_t bank)
 {
@@ -108,6 +108,13 @@ class CartridgeAR : public Cartridge
     */
     virtual bool load(Deserializer& in);
 
+    /**
+      Mixes the state of this device into the given hash.
+
+      @param out The hash to update
+    */
+    virtual void hash(StateHash& out);
+
     /**
       Install pages for the specified bank in the system.
 
@@ -183,6 +190,10 @@ class CartridgeAR : public Cartridge
     // The 6K of RAM and 2K of ROM contained in the Supercharger
     uint8_t myImage[8192];
 
+    // Seed of the power-on pattern of the 6K of RAM and the pattern itself
+    uint32_t myRAMSeed;
+    uint8_t myInitialRAM[6 * 1024];
+
     // The 256 byte header for the current 8448 byte load
     uint8_t myHeader[256];
 
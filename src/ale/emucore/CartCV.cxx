@@ -22,6 +22,7 @@
 #include "ale/emucore/System.hxx"
 #include "ale/emucore/Serializer.hxx"
 #include "ale/emucore/Deserializer.hxx"
+#include "ale/common/StateHash.hpp"
 #include "ale/emucore/CartCV.hxx"
 
 namespace ale {
@@ -29,6 +30,7 @@ namespace stella {
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 CartridgeCV::CartridgeCV(const uint8_t* image, uint32_t size)
+  : myInitialRAM(0)
 {
   uint32_t addr;
   if(size == 2048)
@@ -58,6 +60,7 @@ CartridgeCV::CartridgeCV(const uint8_t* image, uint32_t size)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 CartridgeCV::~CartridgeCV()
 {
+  delete[] myInitialRAM;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -142,8 +145,7 @@ bool CartridgeCV::save(Serializer& out)
 
     // Output RAM
     out.putInt(1024);
-    for(uint32_t addr = 0; addr < 1024; ++addr)
-      out.putInt(myRAM[addr]);
+    out.putByteArray(myRAM, 1024);
   }
   catch(const char* msg)
   {
@@ -170,9 +172,9 @@ bool CartridgeCV::load(Deserializer& in)
       return false;
 
     // Input RAM
-    uint32_t limit = (uint32_t) in.getInt();
-    for(uint32_t addr = 0; addr < limit; ++addr)
-      myRAM[addr] = (uint8_t) in.getInt();
+    if((uint32_t) in.getInt() != 1024)
+      return false;
+    in.getByteArray(myRAM, 1024);
   }
   catch(const char* msg)
   {
@@ -188,6 +190,12 @@ bool CartridgeCV::load(Deserializer& in)
   return true;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CartridgeCV::hash(StateHash& out)
+{
+  out.update(myRAM, sizeof(myRAM));
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void CartridgeCV::bank(uint16_t bank)
 {
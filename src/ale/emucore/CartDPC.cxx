@@ -22,6 +22,7 @@
 #include "ale/emucore/System.hxx"
 #include "ale/emucore/Serializer.hxx"
 #include "ale/emucore/Deserializer.hxx"
+#include "ale/common/StateHash.hpp"
 
 namespace ale {
 namespace stella {
@@ -553,6 +554,22 @@ bool CartridgeDPC::load(Deserializer& in)
   return true;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CartridgeDPC::hash(StateHash& out)
+{
+  Cartridge::hash(out);
+  out.update(myTops, 8);
+  out.update(myBottoms, 8);
+  out.update(myCounters, sizeof(myCounters));
+  out.update(myFlags, 8);
+  for(uint32_t i = 0; i < 3; ++i)
+    out.update(myMusicMode[i]);
+  out.update(myRandomNumber);
+
+  // Music clocks not yet applied to the counters
+  out.update(uint64_t(mySystem->cycles() - mySystemCycles));
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void CartridgeDPC::bank(uint16_t bank)
 {
@@ -21,6 +21,7 @@
 #include "ale/emucore/System.hxx"
 #include "ale/emucore/Serializer.hxx"
 #include "ale/emucore/Deserializer.hxx"
+#include "ale/common/StateHash.hpp"
 #include "ale/emucore/CartE0.hxx"
 
 namespace ale {
@@ -254,6 +255,13 @@ bool CartridgeE0::load(Deserializer& in)
   return true;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CartridgeE0::hash(StateHash& out)
+{
+  for(uint32_t i = 0; i < 4; ++i)
+    out.update(myCurrentSlice[i]);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void CartridgeE0::bank(uint16_t bank)
 {
@@ -98,6 +98,13 @@ class CartridgeE0 : public Cartridge
     */
     virtual bool load(Deserializer& in);
 
+    /**
+      Mixes the state of this device into the given hash.
+
+      @param out The hash to update
+    */
+    virtual void hash(StateHash& out);
+
     /**
       Install pages for the specified bank in the system.
 
@@ -17,10 +17,12 @@
 //============================================================================
 
 #include <cassert>
+#include <cstring>
 
 #include "ale/emucore/System.hxx"
 #include "ale/emucore/Serializer.hxx"
 #include "ale/emucore/Deserializer.hxx"
+#include "ale/common/StateHash.hpp"
 #include "ale/emucore/CartE7.hxx"
 
 namespace ale {
@@ -51,8 +53,9 @@ const char* CartridgeE7::name() const
 void CartridgeE7::reset()
 {
   // Initialize RAM with random values
-  for(uint32_t i = 0; i < 2048; ++i)
-    myRAM[i] = mySystem->rng().next();
+  myRAMSeed = drawRAMSeed(mySystem->rng(), 2048);
+  randomizeRAM(myInitialRAM, 2048, myRAMSeed);
+  std::memcpy(myRAM, myInitialRAM, 2048);
 
   // Install some default banks for the RAM and first segment
   bankRAM(0);
@@ -184,10 +187,9 @@ bool CartridgeE7::save(Serializer& out)
 
     out.putInt(myCurrentRAM);
 
-    // The 2048 bytes of RAM
-    out.putInt(2048);
-    for(i = 0; i < 2048; ++i)
-      out.putInt(myRAM[i]);
+    // The pages of the 2048 bytes of RAM modified since reset
+    out.putInt(myRAMSeed);
+    saveRAMPages(out, myRAM, myInitialRAM, 2048);
   }
   catch(const char* msg)
   {
@@ -221,10 +223,14 @@ bool CartridgeE7::load(Deserializer& in)
 
     myCurrentRAM = (uint16_t) in.getInt();
 
-    // The 2048 bytes of RAM
-    limit = (uint32_t) in.getInt();
-    for(i = 0; i < limit; ++i)
-      myRAM[i] = (uint8_t) in.getInt();
+    // The 2048 bytes of RAM, rebuilding the power-on pattern if needed
+    uint32_t seed = (uint32_t) in.getInt();
+    if(seed != myRAMSeed)
+    {
+      myRAMSeed = seed;
+      randomizeRAM(myInitialRAM, 2048, myRAMSeed);
+    }
+    loadRAMPages(in, myRAM, myInitialRAM, 2048);
   }
   catch(const char* msg)
   {
@@ -244,6 +250,15 @@ bool CartridgeE7::load(Deserializer& in)
   return true;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CartridgeE7::hash(StateHash& out)
+{
+  out.update(myCurrentSlice[0]);
+  out.update(myCurrentSlice[1]);
+  out.update(myCurrentRAM);
+  out.update(myRAM, sizeof(myRAM));
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void CartridgeE7::bank(uint16_t slice)
 {
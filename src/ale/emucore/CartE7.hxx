@@ -115,6 +115,13 @@ class CartridgeE7 : public Cartridge
     */
     virtual bool load(Deserializer& in);
 
+    /**
+      Mixes the state of this device into the given hash.
+
+      @param out The hash to update
+    */
+    virtual void hash(StateHash& out);
+
     /**
       Install pages for the specified bank in the system.
 
@@ -187,6 +194,10 @@ class CartridgeE7 : public Cartridge
 
     // The 2048 bytes of RAM
     uint8_t myRAM[2048];
+
+    // Seed of the power-on RAM pattern and the pattern itself
+    uint32_t myRAMSeed;
+    uint8_t myInitialRAM[2048];
 };
 
 }  // namespace stella
@@ -22,6 +22,7 @@
 #include "ale/emucore/System.hxx"
 #include "ale/emucore/Serializer.hxx"
 #include "ale/emucore/Deserializer.hxx"
+#include "ale/common/StateHash.hpp"
 #include "ale/emucore/CartF4SC.hxx"
 
 namespace ale {
@@ -195,6 +196,13 @@ bool CartridgeF4SC::load(Deserializer& in)
   return true;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CartridgeF4SC::hash(StateHash& out)
+{
+  Cartridge::hash(out);
+  out.update(myRAM, sizeof(myRAM));
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void CartridgeF4SC::bank(uint16_t bank)
 {
@@ -21,6 +21,7 @@
 #include "ale/emucore/System.hxx"
 #include "ale/emucore/Serializer.hxx"
 #include "ale/emucore/Deserializer.hxx"
+#include "ale/common/StateHash.hpp"
 #include "ale/emucore/CartF6SC.hxx"
 
 namespace ale {
@@ -240,6 +241,13 @@ bool CartridgeF6SC::load(Deserializer& in)
   return true;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CartridgeF6SC::hash(StateHash& out)
+{
+  Cartridge::hash(out);
+  out.update(myRAM, sizeof(myRAM));
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void CartridgeF6SC::bank(uint16_t bank)
 {
@@ -21,6 +21,7 @@
 #include "ale/emucore/System.hxx"
 #include "ale/emucore/Serializer.hxx"
 #include "ale/emucore/Deserializer.hxx"
+#include "ale/common/StateHash.hpp"
 #include "ale/emucore/CartF8SC.hxx"
 
 namespace ale {
@@ -172,8 +173,7 @@ bool CartridgeF8SC::save(Serializer& out)
 
     // The 128 bytes of RAM
     out.putInt(128);
-    for(uint32_t i = 0; i < 128; ++i)
-      out.putInt(myRAM[i]);
+    out.putByteArray(myRAM, 128);
   }
   catch(const char* msg)
   {
@@ -201,9 +201,9 @@ bool CartridgeF8SC::load(Deserializer& in)
 
     myCurrentBank = (uint16_t) in.getInt();
 
-    uint32_t limit = (uint32_t) in.getInt();
-    for(uint32_t i = 0; i < limit; ++i)
-      myRAM[i] = (uint8_t) in.getInt();
+    if((uint32_t) in.getInt() != 128)
+      return false;
+    in.getByteArray(myRAM, 128);
   }
   catch(const char* msg)
   {
@@ -222,6 +222,13 @@ bool CartridgeF8SC::load(Deserializer& in)
   return true;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CartridgeF8SC::hash(StateHash& out)
+{
+  Cartridge::hash(out);
+  out.update(myRAM, sizeof(myRAM));
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void CartridgeF8SC::bank(uint16_t bank)
 {
@@ -17,10 +17,12 @@
 //============================================================================
 
 #include <cassert>
+#include <cstring>
 
 #include "ale/emucore/System.hxx"
 #include "ale/emucore/Serializer.hxx"
 #include "ale/emucore/Deserializer.hxx"
+#include "ale/common/StateHash.hpp"
 #include "ale/emucore/CartMC.hxx"
 
 namespace ale {
@@ -35,6 +37,7 @@ CartridgeMC::CartridgeMC(const uint8_t* image, uint32_t size)
 
   // Allocate array for the cart's RAM
   myRAM = new uint8_t[32 * 1024];
+  myInitialRAM = new uint8_t[32 * 1024];
 
   // Allocate array for the ROM image
   myImage = new uint8_t[128 * 1024];
@@ -56,6 +59,7 @@ CartridgeMC::CartridgeMC(const uint8_t* image, uint32_t size)
 CartridgeMC::~CartridgeMC()
 {
   delete[] myRAM;
+  delete[] myInitialRAM;
   delete[] myImage;
 }
 
@@ -69,8 +73,9 @@ const char* CartridgeMC::name() const
 void CartridgeMC::reset()
 {
   // Initialize RAM with random values
-  for(uint32_t i = 0; i < 32 * 1024; ++i)
-    myRAM[i] = mySystem->rng().next();
+  myRAMSeed = drawRAMSeed(mySystem->rng(), 32 * 1024);
+  randomizeRAM(myInitialRAM, 32 * 1024, myRAMSeed);
+  std::memcpy(myRAM, myInitialRAM, 32 * 1024);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -230,10 +235,9 @@ bool CartridgeMC::save(Serializer& out)
     for(i = 0; i < 4; ++i)
       out.putInt(myCurrentBlock[i]);
 
-    // The 32K of RAM
-    out.putInt(32 * 1024);
-    for(i = 0; i < 32 * 1024; ++i)
-      out.putInt(myRAM[i]);
+    // The pages of the 32K of RAM modified since reset
+    out.putInt(myRAMSeed);
+    saveRAMPages(out, myRAM, myInitialRAM, 32 * 1024);
   }
   catch(const char* msg)
   {
@@ -267,10 +271,14 @@ bool CartridgeMC::load(Deserializer& in)
     for(i = 0; i < limit; ++i)
       myCurrentBlock[i] = (uint8_t) in.getInt();
 
-    // The 32K of RAM
-    limit = (uint32_t) in.getInt();
-    for(i = 0; i < limit; ++i)
-      myRAM[i] = (uint8_t) in.getInt();
+    // The 32K of RAM, rebuilding the power-on pattern if needed
+    uint32_t seed = (uint32_t) in.getInt();
+    if(seed != myRAMSeed)
+    {
+      myRAMSeed = seed;
+      randomizeRAM(myInitialRAM, 32 * 1024, myRAMSeed);
+    }
+    loadRAMPages(in, myRAM, myInitialRAM, 32 * 1024);
   }
   catch(const char* msg)
   {
@@ -286,6 +294,14 @@ bool CartridgeMC::load(Deserializer& in)
   return true;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CartridgeMC::hash(StateHash& out)
+{
+  out.update(myCurrentBlock, 4);
+  out.update(mySlot3Locked);
+  out.update(myRAM, 32 * 1024);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void CartridgeMC::bank(uint16_t b)
 {
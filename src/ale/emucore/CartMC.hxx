@@ -200,6 +200,13 @@ class CartridgeMC : public Cartridge
     */
     virtual bool load(Deserializer& in);
 
+    /**
+      Mixes the state of this device into the given hash.
+
+      @param out The hash to update
+    */
+    virtual void hash(StateHash& out);
+
     /**
       Install pages for the specified bank in the system.
 
@@ -262,6 +269,10 @@ class CartridgeMC : public Cartridge
     // Pointer to the 32K bytes of RAM for the cartridge
     uint8_t* myRAM;
 
+    // Seed of the power-on RAM pattern and the pattern itself (32K bytes)
+    uint32_t myRAMSeed;
+    uint8_t* myInitialRAM;
+
     // Pointer to the 128K bytes of ROM for the cartridge
     uint8_t* myImage;
 };
@@ -110,7 +110,7 @@ Console::Console(OSystem* osystem, Cartridge* cart, const Properties& props)
 
   M6502* m6502;
   if(myOSystem->settings().getString("cpu") == "low") {
-    m6502 = new M6502Low(1);
+    m6502 = new M6502Low(1, myOSystem->settings().getBool("skip_idle_loops"));
   }
   else {
     m6502 = new M6502High(1);
@@ -97,6 +97,13 @@ class Console
     */
     const Properties& properties() const { return myProperties; }
 
+    /**
+      Get the event object the controllers and switches read
+
+      @return The event object
+    */
+    const Event& event() const { return *myEvent; }
+
     /**
       Get the console switches
 
@@ -84,5 +84,14 @@ bool Deserializer::getBool(void)
   return result;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Deserializer::getByteArray(uint8_t* data, uint32_t size)
+{
+  myStream.read((char*)data, (std::streamsize)size);
+
+  if(myStream.fail())
+    throw "Deserializer: end of file";
+}
+
 }  // namespace stella
 }  // namespace ale
@@ -19,6 +19,7 @@
 #ifndef DESERIALIZER_HXX
 #define DESERIALIZER_HXX
 
+#include <cstdint>
 #include <sstream>
 
 namespace ale {
@@ -70,6 +71,14 @@ class Deserializer {
          */
         bool getBool(void);
 
+        /**
+         Reads a block of bytes written by Serializer::putByteArray.
+
+         @param data Where to store the bytes
+         @param size The number of bytes to read
+         */
+        void getByteArray(uint8_t* data, uint32_t size);
+
         bool isOpen(void) {return true;}
     private:
         // The stream to get the deserialized data from.
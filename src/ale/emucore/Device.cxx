@@ -38,5 +38,11 @@ void Device::systemCyclesReset()
   // By default I do nothing when my system resets its cycle counter
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Device::hash(StateHash&)
+{
+  // By default I have no state worth hashing
+}
+
 }  // namespace stella
 }  // namespace ale
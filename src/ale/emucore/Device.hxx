@@ -20,6 +20,9 @@
 #define DEVICE_HXX
 
 namespace ale {
+
+class StateHash;
+
 namespace stella {
 
 class System;
@@ -98,6 +101,16 @@ class Device
     */
     virtual bool load(Deserializer& in) = 0;
 
+    /**
+      Mixes the state of this device that affects future emulation into the
+      given hash, without serializing it.  Cycle counts are hashed relative
+      to the current system cycle, so that equal states reached at different
+      times hash equally.  Devices without such state need not override this.
+
+      @param out The hash to update
+    */
+    virtual void hash(StateHash& out);
+
   public:
     /**
       Get the byte at the specified address
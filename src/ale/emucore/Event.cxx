@@ -23,7 +23,8 @@ namespace stella {
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Event::Event()
-  : myNumberOfTypes(Event::LastType)
+  : myNumberOfTypes(Event::LastType),
+    myVersion(1)
 {
   // Set all of the events to 0 / false to start with,
   // including analog paddle events.  Doing it this way
@@ -50,7 +51,11 @@ int Event::get(Type type) const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Event::set(Type type, int value)
 {
-  myValues[type] = value;
+  if(myValues[type] != value)
+  {
+    myValues[type] = value;
+    ++myVersion;
+  }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -62,6 +67,7 @@ void Event::clear()
        i != PaddleTwoResistance  && i != PaddleThreeResistance)
       myValues[i] = 0;
   }
+  ++myVersion;
 }
 
 }  // namespace stella
@@ -19,6 +19,8 @@
 #ifndef EVENT_HXX
 #define EVENT_HXX
 
+#include <cstdint>
+
 namespace ale {
 namespace stella {
 
@@ -87,12 +89,23 @@ class Event
     */
     virtual void clear();
 
+    /**
+      Answer a counter which changes whenever the value of an event does.
+      Devices use it to cache values they derive from the events.
+
+      @return The current version of the events (never 0)
+    */
+    uint64_t version() const { return myVersion; }
+
   protected:
     // Number of event types there are
     const int myNumberOfTypes;
 
     // Array of values associated with each event type
     int myValues[LastType];
+
+    // Incremented whenever one of the values changes
+    uint64_t myVersion;
 };
 
 }  // namespace stella
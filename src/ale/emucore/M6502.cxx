@@ -22,6 +22,8 @@
 #include <cstdint>
 #include <iostream>
 
+#include "ale/common/StateHash.hpp"
+
 static std::once_flag bcd_table_init_once;
 
 namespace ale {
@@ -129,6 +131,16 @@ uint8_t M6502::PS() const
   return ps;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void M6502::hash(StateHash& out) const
+{
+  // All registers fit into a single word
+  out.update(uint64_t(A) | (uint64_t(X) << 8) | (uint64_t(Y) << 16) |
+             (uint64_t(SP) << 24) | (uint64_t(IR) << 32) |
+             (uint64_t(PC) << 40) | (uint64_t(PS()) << 56));
+  out.update(myExecutionStatus);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void M6502::PS(uint8_t ps)
 {
@@ -113,6 +113,13 @@ class M6502
     */
     virtual bool load(Deserializer& in) = 0;
 
+    /**
+      Mixes the registers and the execution status into the given hash.
+
+      @param out The hash to update
+    */
+    void hash(StateHash& out) const;
+
     /**
       Get a null terminated string which is the processor's name (i.e. "M6532")
 
@@ -172,6 +179,14 @@ class M6502
     */
     bool lastAccessWasRead() const { return myLastAccessWasRead; }
 
+    /**
+      Get the number of instructions executed since the processor was
+      created.  This is not part of the saved state.
+
+      @return The total instruction count
+    */
+    uint64_t totalInstructionCount() const { return myTotalInstructionCount; }
+
   public:
     /**
       Overload the ostream output operator for addressing modes.
@@ -258,7 +273,8 @@ class M6502
     /// Table of instruction mnemonics
     static const char* ourInstructionMnemonicTable[256];
 
-    int myTotalInstructionCount;
+    /// Number of instructions executed since construction
+    uint64_t myTotalInstructionCount;
 };
 
 }  // namespace stella
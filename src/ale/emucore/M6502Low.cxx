@@ -17,6 +17,7 @@
 //============================================================================
 
 #include "ale/emucore/M6502Low.hxx"
+#include "ale/emucore/M6532.hxx"
 #include "ale/emucore/Serializer.hxx"
 #include "ale/emucore/Deserializer.hxx"
 
@@ -28,8 +29,9 @@ namespace stella {
 #define debugStream std::cerr
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-M6502Low::M6502Low(uint32_t systemCyclesPerProcessorCycle)
-    : M6502(systemCyclesPerProcessorCycle)
+M6502Low::M6502Low(uint32_t systemCyclesPerProcessorCycle, bool skipIdleLoops)
+    : M6502(systemCyclesPerProcessorCycle),
+      mySkipIdleLoops(skipIdleLoops)
 {
 }
 
@@ -82,6 +84,13 @@ bool M6502Low::execute(uint32_t number)
       // Update system cycles
       mySystem->incrementCycles(myInstructionSystemCycleTable[IR]);
 
+      // Fast-forward busy-wait loops on the RIOT timer
+      if(mySkipIdleLoops &&
+         (IR == 0xad || IR == 0xae || IR == 0xac || IR == 0x2c))
+      {
+        skipIdleLoop(number);
+      }
+
       // Call code to execute the instruction
       switch(IR)
       {
@@ -94,6 +103,8 @@ bool M6502Low::execute(uint32_t number)
           std::cerr << "Illegal Instruction! " << std::hex << (int) IR << std::endl;
       }
 
+      myTotalInstructionCount++;
+
 #ifdef DEBUG
       debugStream << std::hex << std::setw(4) << operandAddress << " ";
       debugStream << std::setw(4) << ourInstructionMnemonicTable[IR];
@@ -139,6 +150,60 @@ bool M6502Low::execute(uint32_t number)
   }
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void M6502Low::skipIdleLoop(uint32_t& number)
+{
+  // The operand and the branch closing the loop must be read from memory
+  // that has no side effects when accessed, such as ROM or RAM
+  uint8_t code[4];
+  for(uint16_t i = 0; i < 4; ++i)
+  {
+    uint16_t address = PC + i;
+    const System::PageAccess& access = mySystem->getAddressAccess(address);
+    if(access.directPeekBase == 0)
+    {
+      return;
+    }
+    code[i] = access.directPeekBase[address & mySystem->pageMask()];
+  }
+
+  // The branch must jump back to the fetched instruction (offset -5).  BIT
+  // does not set the zero flag from the value read, so BNE requires a load.
+  uint8_t branch = code[2];
+  bool untilZero = (branch == 0xd0);
+  if((code[3] != 0xfb) || !((untilZero && IR != 0x2c) || (branch == 0x10)))
+  {
+    return;
+  }
+
+  // The instruction must read one of the RIOT's I/O registers
+  uint16_t operandAddress = (uint16_t)code[0] | ((uint16_t)code[1] << 8);
+  const System::PageAccess& access = mySystem->getAddressAccess(operandAddress);
+  M6532& riot = mySystem->riot();
+  if((access.directPeekBase != 0) || (access.device != &riot))
+  {
+    return;
+  }
+
+  // System cycles from one read of the register to the next
+  uint16_t loop = PC - 1;
+  uint32_t period = myInstructionSystemCycleTable[IR] +
+      myInstructionSystemCycleTable[branch] +
+      ((((loop + 5) ^ loop) & 0xff00) ?
+          mySystemCyclesPerProcessorCycle << 1 : mySystemCyclesPerProcessorCycle);
+
+  // Each skipped iteration executes two instructions, and the fetched
+  // instruction has to stay within the budget
+  uint32_t skipped = riot.idleReads(operandAddress, untilZero, period,
+      (number - 1) / 2);
+  if(skipped != 0)
+  {
+    mySystem->incrementCycles(skipped * period);
+    myTotalInstructionCount += 2 * skipped;
+    number -= 2 * skipped;
+  }
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void M6502Low::interruptHandler()
 {
@@ -59,8 +59,9 @@ class M6502Low : public M6502
       cycle multiplier.
 
       @param systemCyclesPerProcessorCycle The cycle multiplier
+      @param skipIdleLoops Fast-forward loops polling the RIOT timer
     */
-    M6502Low(uint32_t systemCyclesPerProcessorCycle);
+    M6502Low(uint32_t systemCyclesPerProcessorCycle, bool skipIdleLoops = false);
 
     /**
       Destructor
@@ -107,6 +108,22 @@ class M6502Low : public M6502
     */
     void interruptHandler();
 
+    /**
+      Called right after an absolute LDA, LDX, LDY or BIT instruction has
+      been fetched.  If it starts a loop polling the RIOT timer, e.g.
+
+        loop: LDA INTIM     or     loop: BIT TIMINT
+              BNE loop                   BPL loop
+
+      the iterations that cannot leave the loop are skipped by advancing
+      the system cycles directly, as if they had been executed.  The
+      fetched instruction then runs on the first iteration that may exit.
+
+      @param number The remaining number of instructions to execute,
+                    reduced by the number of instructions skipped
+    */
+    void skipIdleLoop(uint32_t& number);
+
   protected:
     /*
       Get the byte at the specified address
@@ -122,6 +139,10 @@ class M6502Low : public M6502
       @param value The value to be stored at the address
     */
     inline void poke(uint16_t address, uint8_t value);
+
+  private:
+    /// Indicates if loops polling the RIOT timer are fast-forwarded
+    bool mySkipIdleLoops;
 };
 
 }  // namespace stella
@@ -20,6 +20,7 @@
 #include <cassert>
 
 #include "ale/emucore/Console.hxx"
+#include "ale/emucore/Event.hxx"
 #include "ale/emucore/M6532.hxx"
 #include "ale/emucore/Switches.hxx"
 #include "ale/emucore/System.hxx"
@@ -27,13 +28,16 @@
 #include "ale/emucore/Deserializer.hxx"
 #include "ale/emucore/OSystem.hxx"
 #include "ale/common/Log.hpp"
+#include "ale/common/StateHash.hpp"
 
 namespace ale {
 namespace stella {
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 M6532::M6532(const Console& console)
-    : myConsole(console)
+    : myConsole(console),
+      myPortA(0xFF),
+      myPortAVersion(0)
 {
   // Randomize the 128 bytes of memory
 
@@ -124,27 +128,16 @@ uint8_t M6532::peek(uint16_t addr)
   {
     case 0x00:    // Port A I/O Register (Joystick)
     {
-      uint8_t value = 0x00;
-
-      if(myConsole.controller(Controller::Left).read(Controller::One))
-        value |= 0x10;
-      if(myConsole.controller(Controller::Left).read(Controller::Two))
-        value |= 0x20;
-      if(myConsole.controller(Controller::Left).read(Controller::Three))
-        value |= 0x40;
-      if(myConsole.controller(Controller::Left).read(Controller::Four))
-        value |= 0x80;
-
-      if(myConsole.controller(Controller::Right).read(Controller::One))
-        value |= 0x01;
-      if(myConsole.controller(Controller::Right).read(Controller::Two))
-        value |= 0x02;
-      if(myConsole.controller(Controller::Right).read(Controller::Three))
-        value |= 0x04;
-      if(myConsole.controller(Controller::Right).read(Controller::Four))
-        value |= 0x08;
-
-      return value;
+      // The pins only depend on the events, so the controllers are asked
+      // again only once the events have changed (about once per frame)
+      // rather than on every poll
+      uint64_t version = myConsole.event().version();
+      if(myPortAVersion != version)
+      {
+        myPortA = readPortA();
+        myPortAVersion = version;
+      }
+      return myPortA;
     }
 
     case 0x01:    // Port A Data Direction Register
@@ -220,6 +213,109 @@ uint8_t M6532::peek(uint16_t addr)
   }
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uint8_t M6532::readPortA() const
+{
+  uint8_t value = 0x00;
+
+  if(myConsole.controller(Controller::Left).read(Controller::One))
+    value |= 0x10;
+  if(myConsole.controller(Controller::Left).read(Controller::Two))
+    value |= 0x20;
+  if(myConsole.controller(Controller::Left).read(Controller::Three))
+    value |= 0x40;
+  if(myConsole.controller(Controller::Left).read(Controller::Four))
+    value |= 0x80;
+
+  if(myConsole.controller(Controller::Right).read(Controller::One))
+    value |= 0x01;
+  if(myConsole.controller(Controller::Right).read(Controller::Two))
+    value |= 0x02;
+  if(myConsole.controller(Controller::Right).read(Controller::Three))
+    value |= 0x04;
+  if(myConsole.controller(Controller::Right).read(Controller::Four))
+    value |= 0x08;
+
+  return value;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uint32_t M6532::idleReads(uint16_t addr, bool untilZero, uint32_t period,
+    uint32_t limit) const
+{
+  // Same arithmetic as peek(), which stays monotonic while the timer
+  // has been running for less than 2^30 cycles
+  uint32_t delta = (mySystem->cycles() - 1) - myCyclesWhenTimerSet;
+  if((delta >= 0x40000000) || (period == 0))
+  {
+    return 0;
+  }
+
+  // The timer reads below zero (and the interrupt flag gets set) once
+  // delta reaches expiry
+  uint64_t expiry = (uint64_t)myTimer << myIntervalShift;
+
+  // The loop keeps waiting for all reads with a delta below end
+  uint64_t end;
+
+  switch(addr & 0x07)
+  {
+    case 0x04:    // Timer Output
+    case 0x06:
+    {
+      if(untilZero)
+      {
+        // Waits while the timer reads one or more
+        end = (myTimer > 1) ? (uint64_t)(myTimer - 1) << myIntervalShift : 0;
+      }
+      else
+      {
+        // Waits while the timer reads 0 to 127; reads after it expired
+        // have side effects
+        int timer = (int)myTimer - (int)(delta >> myIntervalShift) - 1;
+        if(timer > 0x7f)
+        {
+          return 0;
+        }
+        end = expiry;
+      }
+      break;
+    }
+
+    case 0x05:    // Interrupt Flag
+    case 0x07:
+    {
+      // The flag stays clear until the timer is set again once the timer
+      // has been read after the interrupt
+      if(myTimerReadAfterInterrupt)
+      {
+        return untilZero ? 0 : limit;
+      }
+
+      if(untilZero)
+      {
+        // Waits while the flag is set, which lasts until the timer is set
+        return (delta >= expiry) ? limit : 0;
+      }
+      end = expiry;
+      break;
+    }
+
+    default:
+    {
+      return 0;
+    }
+  }
+
+  if(delta >= end)
+  {
+    return 0;
+  }
+
+  uint64_t reads = (end - delta + period - 1) / period;
+  return (reads < limit) ? (uint32_t)reads : limit;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void M6532::poke(uint16_t addr, uint8_t value)
 {
@@ -370,6 +466,19 @@ bool M6532::load(Deserializer& in)
   return true;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void M6532::hash(StateHash& out)
+{
+  out.update(myRAM, 128);
+
+  out.update(myTimer);
+  out.update(myIntervalShift);
+  out.update(uint64_t(mySystem->cycles() - myCyclesWhenTimerSet));
+  out.update(uint64_t(mySystem->cycles() - myCyclesWhenInterruptReset));
+  out.update(myTimerReadAfterInterrupt);
+  out.update(myDDRA | (myDDRB << 8));
+}
+
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 M6532::M6532(const M6532& c)
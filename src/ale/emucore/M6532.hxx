@@ -101,6 +101,13 @@ class M6532 : public Device
     */
     virtual bool load(Deserializer& in);
 
+    /**
+      Mixes the RAM, the timer and the port directions into the given hash.
+
+      @param out The hash to update
+    */
+    virtual void hash(StateHash& out);
+
    public:
     /**
       Get the byte at the specified address
@@ -117,6 +124,39 @@ class M6532 : public Device
     */
     virtual void poke(uint16_t address, uint8_t value);
 
+    /**
+      Answer how many consecutive reads of the timer or the interrupt flag
+      at the given address would keep a loop polling it waiting.  The first
+      read happens on the current system cycle and each following one
+      period cycles later.  The loop waits while the value read is non-zero
+      if untilZero is true, and while its bit 7 is clear otherwise.  Only
+      reads without side effects are counted, so that the processor can
+      skip all of them by advancing the system cycles.
+
+      @param addr The address being polled
+      @param untilZero True if the loop exits on zero, false on bit 7 set
+      @param period The number of system cycles between two reads
+      @param limit The maximum number of reads to answer
+      @return The number of reads that can be skipped
+    */
+    uint32_t idleReads(uint16_t addr, bool untilZero, uint32_t period,
+        uint32_t limit) const;
+
+    /**
+      Answer the 128 bytes of RAM, i.e. the contents of addresses $80-$FF.
+      Reading them this way does not disturb the data bus.
+
+      @return The RAM
+    */
+    const uint8_t* ram() const
+    {
+      return myRAM;
+    }
+
+  private:
+    // Read the joystick pins of port A from the controllers
+    uint8_t readPortA() const;
+
   private:
     // Reference to the console
     const Console& myConsole;
@@ -145,6 +185,11 @@ class M6532 : public Device
     // Data Direction Register for Port B
     uint8_t myDDRB;
 
+    // Port A as last read from the controllers, and the version of the
+    // events it was read at (0 if it has not been read yet)
+    uint8_t myPortA;
+    uint64_t myPortAVersion;
+
   private:
     // Copy constructor isn't supported by this class so make it private
     M6532(const M6532&);
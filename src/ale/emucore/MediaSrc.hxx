@@ -76,6 +76,32 @@ class MediaSource
     */
     virtual uint8_t* previousFrameBuffer() const = 0;
 
+    /**
+      Answers the generation of the frame buffers, which increases every
+      time a frame is finished or the buffers change in some other way.
+      Generations start at 1 and are neither saved nor restored.
+
+      @return The current generation
+    */
+    virtual uint64_t frameGeneration() const = 0;
+
+    /**
+      Answers, for each scanline of the frame buffers, the last generation
+      in which the current frame buffer differed from the previous one on
+      that scanline.  If a scanline's generation is at most g, it is the
+      same in the current frame buffer as at generation g; if it is less
+      than g, it is also the same in the previous frame buffer.
+
+      @return Pointer to height() generations
+    */
+    virtual const uint64_t* scanlineGenerations() const = 0;
+
+    /**
+      Tells the media source that its frame buffers were written from
+      outside, which marks every scanline as changed.
+    */
+    virtual void invalidateFrameBuffers() = 0;
+
   public:
     /**
       Answers the height of the frame buffer
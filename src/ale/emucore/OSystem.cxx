@@ -30,6 +30,7 @@
 #include "ale/emucore/Event.hxx"
 #include "ale/emucore/OSystem.hxx"
 #include "ale/emucore/System.hxx"
+#include "ale/common/SoundCapture.hxx"
 
 #ifdef SDL_SUPPORT
   #include "ale/common/ScreenSDL.hpp"
@@ -122,12 +123,21 @@ void OSystem::createSound()
       mySound = new SoundSDL(mySettings);
       mySound->initialize();
   }
+  else if (mySettings->getBool("sound_capture")) {
+      mySound = new SoundCapture(mySettings);
+  }
   else {
       mySound = new SoundNull(mySettings);
   }
 #else
   mySettings->setBool("sound", false);
-  mySound = new SoundNull(mySettings);
+  // Capturing sound into memory doesn't need SDL
+  if (mySettings->getBool("sound_capture")) {
+      mySound = new SoundCapture(mySettings);
+  }
+  else {
+      mySound = new SoundNull(mySettings);
+  }
 #endif
 }
 
@@ -36,6 +36,7 @@ class PropertiesSet;
 #include "ale/emucore/Console.hxx"
 #include "ale/emucore/Event.hxx"  //ALE
 #include "ale/common/ColourPalette.hpp"
+#include "ale/common/PerfStats.hpp"
 #include "ale/common/Log.hpp"
 
 namespace fs = std::filesystem;
@@ -189,10 +190,15 @@ class OSystem
   public: //ALE
     ale::ColourPalette &colourPalette() { return m_colour_palette; }
 
+    // Per-stage timing counters; only updated when built with ALE_PERF_STATS
+    ale::PerfStats &perfStats() { return m_perf_stats; }
+
   private:
 
     ale::ColourPalette m_colour_palette;
 
+    ale::PerfStats m_perf_stats;
+
     /**
       Creates the various sound devices available in this system
       (for now, that means either 'SDL' or 'Null').
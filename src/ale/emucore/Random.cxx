@@ -41,6 +41,7 @@ class Random::Impl {
     void seed(uint32_t value);
     uint32_t next();
     double nextDouble();
+    void discard(uint64_t n);
 
   private:
 
@@ -51,9 +52,13 @@ class Random::Impl {
 
     // Random number generator
     randgen_t m_randgen;
+
+    // Number of values drawn so far
+    uint64_t m_draws;
 };
 
 Random::Impl::Impl()
+  : m_draws(0)
 {
     // Initialize seed to time
 }
@@ -68,15 +73,24 @@ void Random::Impl::seed(uint32_t value)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uint32_t Random::Impl::next()
 {
+  ++m_draws;
   return m_randgen();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 double Random::Impl::nextDouble()
 {
+  ++m_draws;
   return m_randgen() / double(m_randgen.max() + 1.0);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Random::Impl::discard(uint64_t n)
+{
+  m_draws += n;
+  m_randgen.discard(n);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Random::Random() :
     m_pimpl(new Random::Impl())
@@ -109,6 +123,18 @@ double Random::nextDouble()
   return m_pimpl->nextDouble();
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Random::discard(uint64_t n)
+{
+  m_pimpl->discard(n);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uint64_t Random::draws() const
+{
+  return m_pimpl->m_draws;
+}
+
 bool Random::saveState(Serializer& ser) {
   // The mt19937 object's serialization of choice is into a string.
   std::ostringstream oss;
@@ -71,6 +71,23 @@ class Random
     */
     double nextDouble();
 
+    /**
+      Advances the random number generator as if next() was called the
+      given number of times
+
+      @param n The number of values to skip
+    */
+    void discard(uint64_t n);
+
+    /**
+      Answer the number of values drawn (or skipped) by this object so far.
+      The count is not part of the serialized state; it is meant for
+      measuring how far an operation advances the generator.
+
+      @return The number of values drawn
+    */
+    uint64_t draws() const;
+
     /**
       Serializes the RNG state.
     */
@@ -30,6 +30,11 @@ class Screen
   public:
     virtual void render() { };
 
+    /**
+      Answer whether render() does nothing, as in this base class.
+    */
+    virtual bool isNull() const { return true; }
+
   protected:
     OSystem* myOSystem;
 };
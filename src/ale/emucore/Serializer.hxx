@@ -19,6 +19,7 @@
 #ifndef SERIALIZER_HXX
 #define SERIALIZER_HXX
 
+#include <cstdint>
 #include <sstream>
 
 namespace ale {
@@ -29,7 +30,8 @@ namespace stella {
   serialized and sent to an output binary file in a system-
   independent way.
 
-  All bytes and integers are written as int's.  Strings are
+  All integers are written as int's; byte arrays are written
+  packed, one byte per value.  Strings are
   written as characters prepended by the length of the string.
   Boolean values are written using a special pattern.
 
@@ -82,6 +84,15 @@ class Serializer
     */
     void putBool(bool b);
 
+    /**
+      Writes a block of bytes to the current output stream, one byte
+      per value (rather than the four used by putInt).
+
+      @param data The bytes to write to the output stream
+      @param size The number of bytes to write
+    */
+    void putByteArray(const uint8_t* data, uint32_t size);
+
     // Accessor for myStream
     // TODO: don't copy the whole streams.
     std::string get_str(void) const {
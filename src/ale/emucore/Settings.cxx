@@ -391,6 +391,10 @@ void Settings::setDefaultSettings() {
 
     // Stella settings
     stringSettings.insert(std::pair<std::string, std::string>("cpu", "low")); // Reduce CPU emulation fidelity for speed
+    // Let the low fidelity CPU fast-forward loops busy-waiting on the RIOT timer.
+    // Skipped iterations leave exactly the state executing them would. Off
+    // until ale-idle-loop-check has been run over the supported ROMs.
+    boolSettings.insert(std::pair<std::string, bool>("skip_idle_loops", false));
     // Random seed for ale::stella::System.
     // This random seed should be fixed to enable full determinism in the ALE
     intSettings.insert(std::pair<std::string, int>("system_random_seed", 4753849));
@@ -418,6 +422,13 @@ void Settings::setDefaultSettings() {
     stringSettings.insert(std::pair<std::string, std::string>("rom_file", ""));
     // Whether to truncate an episode on loss of life.
     boolSettings.insert(std::pair<std::string, bool>("truncate_on_loss_of_life", false));
+    // Whether to snapshot the state after the first reset of each (mode, difficulty)
+    // and restore it on later resets instead of emulating the reset sequence again.
+    boolSettings.insert(std::pair<std::string, bool>("reset_cache", false));
+    // Number of NOOP actions, drawn uniformly from [0, noop_max], applied after each reset.
+    intSettings.insert(std::pair<std::string, int>("noop_max", 0));
+    // If positive, reset() samples from this many recorded start states instead.
+    intSettings.insert(std::pair<std::string, int>("num_start_states", 0));
     // Reward clipping settings
     intSettings.insert(std::pair<std::string, int>("reward_min", std::numeric_limits<int>::min()));
     intSettings.insert(std::pair<std::string, int>("reward_max", std::numeric_limits<int>::max()));
@@ -427,6 +438,14 @@ void Settings::setDefaultSettings() {
     stringSettings.insert(std::pair<std::string, std::string>("record_screen_dir", ""));
     stringSettings.insert(std::pair<std::string, std::string>("record_sound_filename", ""));
 
+    // Sound capture settings: whether to synthesize the audio into memory
+    // (when sound is off), the sample rate, how many samples to average into
+    // one, and how many to keep (if not positive, one act()'s worth)
+    boolSettings.insert(std::pair<std::string, bool>("sound_capture", false));
+    intSettings.insert(std::pair<std::string, int>("sound_capture_rate", 31400));
+    intSettings.insert(std::pair<std::string, int>("sound_capture_downsample", 1));
+    intSettings.insert(std::pair<std::string, int>("sound_capture_samples", 0));
+
     // Display Settings
     boolSettings.insert(std::pair<std::string, bool>("display_screen", false));
 
@@ -143,6 +143,14 @@ class Sound
       */
     virtual void recordNextFrame() = 0;
 
+    /**
+      Answer whether this sound object ignores everything it is given, in
+      which case the TIA does not forward audio register writes to it.
+
+      @return true iff the sound object does nothing
+    */
+    virtual bool isNull() const { return false; }
+
 public:
     /**
       Loads the current state of this device from the given Deserializer.
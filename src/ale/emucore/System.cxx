@@ -21,11 +21,13 @@
 
 #include "ale/emucore/Device.hxx"
 #include "ale/emucore/M6502.hxx"
+#include "ale/emucore/M6532.hxx"
 #include "ale/emucore/TIA.hxx"
 #include "ale/emucore/System.hxx"
 #include "ale/emucore/Serializer.hxx"
 #include "ale/emucore/Deserializer.hxx"
 #include "ale/emucore/Settings.hxx"
+#include "ale/common/StateHash.hpp"
 
 namespace ale {
 namespace stella {
@@ -35,7 +37,9 @@ System::System(Settings& settings)
   : myNumberOfDevices(0),
     myM6502(0),
     myTIA(0),
+    myM6532(0),
     myCycles(0),
+    myTotalCycles(0),
     myDataBusState(0)
 {
   // Seed RNG with fixed seed to enable full determinism
@@ -123,6 +127,13 @@ void System::attach(TIA* tia)
   attach((Device*) tia);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void System::attach(M6532* m6532)
+{
+  myM6532 = m6532;
+  attach((Device*) m6532);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool System::save(Serializer& out)
 {
@@ -130,6 +141,7 @@ bool System::save(Serializer& out)
   {
     out.putString("System");
     out.putInt(myCycles);
+    out.putInt(myDataBusState);
     myRandom.saveState(out);
   }
   catch(char *msg)
@@ -155,6 +167,7 @@ bool System::load(Deserializer& in)
       return false;
 
     myCycles = (uint32_t) in.getInt();
+    myDataBusState = (uint8_t) in.getInt();
     myRandom.loadState(in);
   }
   catch(char *msg)
@@ -171,6 +184,15 @@ bool System::load(Deserializer& in)
   return true;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void System::hash(StateHash& out)
+{
+  out.update(myDataBusState);
+  myM6502->hash(out);
+  for(uint32_t i = 0; i < myNumberOfDevices; ++i)
+    myDevices[i]->hash(out);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void System::resetCycles()
 {
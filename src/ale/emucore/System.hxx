@@ -24,6 +24,7 @@ namespace stella {
 
 class Device;
 class M6502;
+class M6532;
 class TIA;
 class NullDevice;
 class Serializer;
@@ -98,6 +99,15 @@ class System
     */
     bool load(Deserializer& in);
 
+    /**
+      Mixes the state of the system, the CPU and every attached device into
+      the given hash.  Unlike saveState() nothing is serialized, and the
+      cycle counter and the random number generator are left out.
+
+      @param out The hash to update
+    */
+    void hash(StateHash& out);
+
   public:
     /**
       Attach the specified device and claim ownership of it.  The device
@@ -123,6 +133,14 @@ class System
     */
     void attach(TIA* tia);
 
+    /**
+      Attach the specified RIOT device and claim ownership of it.
+      The device will be asked to install itself.
+
+      @param m6532 The RIOT device to attach to the system
+    */
+    void attach(M6532* m6532);
+
     /**
       Saves the current state of Stella to the given file.  Calls
       save on every device and CPU attached to this system.
@@ -167,6 +185,26 @@ class System
       return *myTIA;
     }
 
+    /**
+      Answer the RIOT device attached to the system.
+
+      @return The attached RIOT device
+    */
+    M6532& riot()
+    {
+      return *myM6532;
+    }
+
+    /**
+      Answer the RIOT device attached to the system.
+
+      @return The attached RIOT device
+    */
+    const M6532& riot() const
+    {
+      return *myM6532;
+    }
+
     /**
       Answer the random generator attached to the system.
       @return The random generator
@@ -238,6 +276,19 @@ class System
     void incrementCycles(uint32_t amount)
     {
       myCycles += amount;
+      myTotalCycles += amount;
+    }
+
+    /**
+      Get the number of system cycles executed since the system was
+      created.  Unlike cycles() this is never reset and is not part of
+      the saved state.
+
+      @return The total number of system cycles executed
+    */
+    uint64_t totalCycles() const
+    {
+      return myTotalCycles;
     }
 
     /**
@@ -367,6 +418,17 @@ class System
     */
     const PageAccess& getPageAccess(uint16_t page);
 
+    /**
+      Get the page accessing method used by the specified address.
+
+      @param addr The address to get accessing methods for
+      @return The accessing methods used by the address's page
+    */
+    const PageAccess& getAddressAccess(uint16_t addr) const
+    {
+      return myPageAccessTable[(addr & myAddressMask) >> myPageSize];
+    }
+
   private:
     // Log base 2 of the addressing space size.
     static constexpr uint16_t myAddressingSpace = 13;
@@ -398,6 +460,9 @@ class System
     // TIA device attached to the system or the null pointer
     TIA* myTIA;
 
+    // RIOT device attached to the system or the null pointer
+    M6532* myM6532;
+
     // Many devices need a source of random numbers, usually for emulating
     // unknown/undefined behaviour
     Random myRandom;
@@ -405,6 +470,9 @@ class System
     // Number of system cycles executed since the last reset
     uint32_t myCycles;
 
+    // Number of system cycles executed since construction
+    uint64_t myTotalCycles;
+
     // Null device to use for page which are not installed
     NullDevice myNullDevice;
 
@@ -16,14 +16,15 @@
 // $Id: TIA.cxx,v 1.79 2007/02/06 23:34:33 stephena Exp $
 //============================================================================
 
+#include <algorithm>
 #include <string>
 #include <iostream>
-#include <mutex>
 #include <cassert>
 #include <cstring>
 
 #include "ale/emucore/Console.hxx"
 #include "ale/emucore/Control.hxx"
+#include "ale/emucore/Event.hxx"
 #include "ale/emucore/M6502.hxx"
 #include "ale/emucore/System.hxx"
 #include "ale/emucore/TIA.hxx"
@@ -31,11 +32,11 @@
 #include "ale/emucore/Deserializer.hxx"
 #include "ale/emucore/Settings.hxx"
 #include "ale/emucore/Sound.hxx"
+#include "ale/emucore/OSystem.hxx"
+#include "ale/common/StateHash.hpp"
 
 #define HBLANK 68
 
-static std::once_flag tia_init_once;
-
 namespace ale {
 namespace stella {
 
@@ -44,6 +45,8 @@ TIA::TIA(const Console& console, Settings& settings)
     : myConsole(console),
       mySettings(settings),
       mySound(NULL),
+      mySoundIsNull(true),
+      myPerfStats(&console.osystem().perfStats()),
       myColorLossEnabled(false),
       myMaximumNumberOfScanlines(262),
       myCOLUBK(myColor[0]),
@@ -53,9 +56,14 @@ TIA::TIA(const Console& console, Settings& settings)
 {
   uint32_t i;
 
-  // Allocate buffers for two frame buffers
-  myCurrentFrameBuffer = new uint8_t[160 * 300];
-  myPreviousFrameBuffer = new uint8_t[160 * 300];
+  // The two frame buffers are allocated by frameReset(), once the display
+  // height is known
+  myCurrentFrameBuffer = 0;
+  myPreviousFrameBuffer = 0;
+  myFrameBufferSize = 0;
+  myScanlineGenerations = 0;
+  myFrameGeneration = 1;
+  myFrameComparable = false;
 
   myFrameGreyed = false;
   myPartialFrameFlag = false; //ALE : This was left uninitialized :(
@@ -63,53 +71,12 @@ TIA::TIA(const Console& console, Settings& settings)
   for(i = 0; i < 6; ++i)
     myBitEnabled[i] = true;
 
-  for(uint16_t x = 0; x < 2; ++x)
-  {
-    for(uint16_t enabled = 0; enabled < 256; ++enabled)
-    {
-      if(enabled & PriorityBit)
-      {
-        uint8_t color = 0;
+  // The fire buttons are read from the controllers on first use
+  myINPT4 = myINPT5 = 0x80;
+  myFireButtonsVersion = 0;
 
-        if((enabled & (myP1Bit | myM1Bit)) != 0)
-          color = 3;
-        if((enabled & (myP0Bit | myM0Bit)) != 0)
-          color = 2;
-        if((enabled & myBLBit) != 0)
-          color = 1;
-        if((enabled & myPFBit) != 0)
-          color = 1;  // NOTE: Playfield has priority so ScoreBit isn't used
-
-        myPriorityEncoder[x][enabled] = color;
-      }
-      else
-      {
-        uint8_t color = 0;
-
-        if((enabled & myBLBit) != 0)
-          color = 1;
-        if((enabled & myPFBit) != 0)
-          color = (enabled & ScoreBit) ? ((x == 0) ? 2 : 3) : 1;
-        if((enabled & (myP1Bit | myM1Bit)) != 0)
-          color = (color != 2) ? 3 : 2;
-        if((enabled & (myP0Bit | myM0Bit)) != 0)
-          color = 2;
-
-        myPriorityEncoder[x][enabled] = color;
-      }
-    }
-  }
-
-  std::call_once(tia_init_once, []() {
-    // Compute all of the mask tables
-    computeBallMaskTable();
-    computeCollisionTable();
-    computeMissleMaskTable();
-    computePlayerMaskTable();
-    computePlayerPositionResetWhenTable();
-    computePlayerReflectTable();
-    computePlayfieldMaskTable();
-  });
+  // Pick the vector rasterizer if the CPU supports it
+  myRasterizer = tiaRasterizer();
 
   // Init stats counters
   myFrameCounter = 0;
@@ -124,6 +91,7 @@ TIA::~TIA()
 {
   delete[] myCurrentFrameBuffer;
   delete[] myPreviousFrameBuffer;
+  delete[] myScanlineGenerations;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -183,12 +151,12 @@ void TIA::reset()
   // Some default values for the "current" variables
   myCurrentGRP0 = 0;
   myCurrentGRP1 = 0;
-  myCurrentBLMask = ourBallMaskTable[0][0];
-  myCurrentM0Mask = ourMissleMaskTable[0][0][0];
-  myCurrentM1Mask = ourMissleMaskTable[0][0][0];
-  myCurrentP0Mask = ourPlayerMaskTable[0][0][0];
-  myCurrentP1Mask = ourPlayerMaskTable[0][0][0];
-  myCurrentPFMask = ourPlayfieldTable[0];
+  myCurrentBLMask = ourBallMaskTable[0][0].data();
+  myCurrentM0Mask = ourMissleMaskTable[0][0][0].data();
+  myCurrentM1Mask = ourMissleMaskTable[0][0][0].data();
+  myCurrentP0Mask = ourPlayerMaskTable[0][0][0].data();
+  myCurrentP1Mask = ourPlayerMaskTable[0][0][0].data();
+  myCurrentPFMask = ourPlayfieldTable[0].data();
 
   myLastHMOVEClock = 0;
   myHMOVEBlankEnabled = false;
@@ -221,6 +189,10 @@ void TIA::reset()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIA::frameReset()
 {
+  // The console may change the display height after we are created (for
+  // PAL games), so the frame buffers are sized here
+  resizeBuffers(atoi(myConsole.properties().get(Display_Height).c_str()));
+
   // Clear frame buffers
   clearBuffers();
 
@@ -325,6 +297,7 @@ bool TIA::save(Serializer& out)
     out.putInt(myScanlineCountForLastFrame);
     out.putInt(myCurrentScanline);
     out.putInt(myVSYNCFinishClock);
+    out.putBool(myPartialFrameFlag);
 
     out.putInt(myEnabledObjects);
 
@@ -372,12 +345,12 @@ bool TIA::save(Serializer& out)
     out.putInt(myCurrentGRP1);
 
 // pointers
-//  myCurrentBLMask = ourBallMaskTable[0][0];
-//  myCurrentM0Mask = ourMissleMaskTable[0][0][0];
-//  myCurrentM1Mask = ourMissleMaskTable[0][0][0];
-//  myCurrentP0Mask = ourPlayerMaskTable[0][0][0];
-//  myCurrentP1Mask = ourPlayerMaskTable[0][0][0];
-//  myCurrentPFMask = ourPlayfieldTable[0];
+//  myCurrentBLMask = ourBallMaskTable[0][0].data();
+//  myCurrentM0Mask = ourMissleMaskTable[0][0][0].data();
+//  myCurrentM1Mask = ourMissleMaskTable[0][0][0].data();
+//  myCurrentP0Mask = ourPlayerMaskTable[0][0][0].data();
+//  myCurrentP1Mask = ourPlayerMaskTable[0][0][0].data();
+//  myCurrentPFMask = ourPlayfieldTable[0].data();
 
     out.putInt(myLastHMOVEClock);
     out.putBool(myHMOVEBlankEnabled);
@@ -422,6 +395,13 @@ bool TIA::load(Deserializer& in)
     myScanlineCountForLastFrame = (int) in.getInt();
     myCurrentScanline = (int) in.getInt();
     myVSYNCFinishClock = (int) in.getInt();
+    myPartialFrameFlag = in.getBool();
+
+    // A frame resumed from the state continues in whichever buffer is
+    // current, from the pixel the restored clocks have drawn up to
+    if(myPartialFrameFlag)
+      myFrameComparable = false;
+    restoreFramePointer();
 
     myEnabledObjects = (uint8_t) in.getInt();
 
@@ -469,12 +449,12 @@ bool TIA::load(Deserializer& in)
     myCurrentGRP1 = (uint8_t) in.getInt();
 
 // pointers
-//  myCurrentBLMask = ourBallMaskTable[0][0];
-//  myCurrentM0Mask = ourMissleMaskTable[0][0][0];
-//  myCurrentM1Mask = ourMissleMaskTable[0][0][0];
-//  myCurrentP0Mask = ourPlayerMaskTable[0][0][0];
-//  myCurrentP1Mask = ourPlayerMaskTable[0][0][0];
-//  myCurrentPFMask = ourPlayfieldTable[0];
+//  myCurrentBLMask = ourBallMaskTable[0][0].data();
+//  myCurrentM0Mask = ourMissleMaskTable[0][0][0].data();
+//  myCurrentM1Mask = ourMissleMaskTable[0][0][0].data();
+//  myCurrentP0Mask = ourPlayerMaskTable[0][0][0].data();
+//  myCurrentP1Mask = ourPlayerMaskTable[0][0][0].data();
+//  myCurrentPFMask = ourPlayfieldTable[0].data();
 
     myLastHMOVEClock = (int) in.getInt();
     myHMOVEBlankEnabled = in.getBool();
@@ -504,6 +484,76 @@ bool TIA::load(Deserializer& in)
   return true;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIA::hash(StateHash& out)
+{
+  // Clocks are hashed relative to the start of the frame, and the start of
+  // the frame relative to the current CPU cycle
+  int64_t frameStart = myClockWhenFrameStarted;
+  out.update(uint64_t(3 * int64_t(mySystem->cycles()) - frameStart));
+  out.update(uint64_t(myClockStartDisplay - frameStart));
+  out.update(uint64_t(myClockStopDisplay - frameStart));
+  out.update(uint64_t(myClockAtLastUpdate - frameStart));
+  out.update(uint64_t(myVSYNCFinishClock - frameStart));
+  out.update(uint64_t(myLastHMOVEClock - frameStart));
+  out.update(uint64_t(myDumpDisabledCycle - int64_t(mySystem->cycles())));
+  out.update(myClocksToEndOfScanLine);
+  out.update(myScanlineCountForLastFrame);
+  out.update(myCurrentScanline);
+  out.update(myPartialFrameFlag);
+
+  out.update(myEnabledObjects);
+
+  out.update(myVSYNC);
+  out.update(myVBLANK);
+  out.update(myNUSIZ0);
+  out.update(myNUSIZ1);
+
+  out.update(myCOLUP0);
+  out.update(myCOLUP1);
+  out.update(myCOLUPF);
+  out.update(myCOLUBK);
+
+  out.update(myCTRLPF);
+  out.update(myPlayfieldPriorityAndScore);
+  out.update(myREFP0);
+  out.update(myREFP1);
+  out.update(myPF);
+  out.update(myGRP0);
+  out.update(myGRP1);
+  out.update(myDGRP0);
+  out.update(myDGRP1);
+  out.update(myENAM0);
+  out.update(myENAM1);
+  out.update(myENABL);
+  out.update(myDENABL);
+  out.update(myHMP0);
+  out.update(myHMP1);
+  out.update(myHMM0);
+  out.update(myHMM1);
+  out.update(myHMBL);
+  out.update(myVDELP0);
+  out.update(myVDELP1);
+  out.update(myVDELBL);
+  out.update(myRESMP0);
+  out.update(myRESMP1);
+  out.update(myCollision);
+  out.update(myPOSP0);
+  out.update(myPOSP1);
+  out.update(myPOSM0);
+  out.update(myPOSM1);
+  out.update(myPOSBL);
+
+  out.update(myCurrentGRP0);
+  out.update(myCurrentGRP1);
+
+  out.update(myHMOVEBlankEnabled);
+  out.update(myM0CosmicArkMotionEnabled);
+  out.update(myM0CosmicArkCounter);
+
+  out.update(myDumpEnabled);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIA::update()
 {
@@ -528,6 +578,9 @@ void TIA::update()
     // grey out old frame contents
     if(!myFrameGreyed) greyOutFrame();
     myFrameGreyed = true;
+
+    // The partly drawn frame may be looked at before it is finished
+    invalidateFrameBuffers();
   } else {
     endFrame();
   }
@@ -559,6 +612,7 @@ inline void TIA::startFrame()
 
   // Reset frame buffer pointer
   myFramePointer = myCurrentFrameBuffer;
+  myFrameComparable = true;
 
   // If color loss is enabled then update the color registers based on
   // the number of scanlines in the last frame that was generated
@@ -593,6 +647,13 @@ inline void TIA::endFrame()
   // Stats counters
   myFrameCounter++;
 
+  // Without a fresh start the previous frame buffer does not hold the
+  // frame seen before this one, so every scanline counts as changed
+  if(myFrameComparable)
+    compareBuffers();
+  else
+    invalidateFrameBuffers();
+
   myFrameGreyed = false;
 }
 
@@ -628,20 +689,68 @@ uint32_t TIA::clocksThisLine() const
 void TIA::setSound(Sound& sound)
 {
   mySound = &sound;
+  mySoundIsNull = sound.isNull();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+constexpr TIA::PriorityEncoderTable TIA::computePriorityEncoder()
+{
+  PriorityEncoderTable table{};
+
+  for(uint16_t x = 0; x < 2; ++x)
+  {
+    for(uint16_t enabled = 0; enabled < 256; ++enabled)
+    {
+      if(enabled & PriorityBit)
+      {
+        uint8_t color = 0;
+
+        if((enabled & (myP1Bit | myM1Bit)) != 0)
+          color = 3;
+        if((enabled & (myP0Bit | myM0Bit)) != 0)
+          color = 2;
+        if((enabled & myBLBit) != 0)
+          color = 1;
+        if((enabled & myPFBit) != 0)
+          color = 1;  // NOTE: Playfield has priority so ScoreBit isn't used
+
+        table[x][enabled] = color;
+      }
+      else
+      {
+        uint8_t color = 0;
+
+        if((enabled & myBLBit) != 0)
+          color = 1;
+        if((enabled & myPFBit) != 0)
+          color = (enabled & ScoreBit) ? ((x == 0) ? 2 : 3) : 1;
+        if((enabled & (myP1Bit | myM1Bit)) != 0)
+          color = (color != 2) ? 3 : 2;
+        if((enabled & (myP0Bit | myM0Bit)) != 0)
+          color = 2;
+
+        table[x][enabled] = color;
+      }
+    }
+  }
+
+  return table;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void TIA::computeBallMaskTable()
+constexpr TIA::BallMaskTable TIA::computeBallMaskTable()
 {
+  BallMaskTable table{};
+
   // First, calculate masks for alignment 0
   for(int size = 0; size < 4; ++size)
   {
-    int x;
+    int x = 0;
 
     // Set all of the masks to false to start with
     for(x = 0; x < 160; ++x)
     {
-      ourBallMaskTable[0][size][x] = false;
+      table[0][size][x] = false;
     }
 
     // Set the necessary fields true
@@ -649,14 +758,14 @@ void TIA::computeBallMaskTable()
     {
       if((x >= 0) && (x < (1 << size)))
       {
-        ourBallMaskTable[0][size][x % 160] = true;
+        table[0][size][x % 160] = true;
       }
     }
 
     // Copy fields into the wrap-around area of the mask
     for(x = 0; x < 160; ++x)
     {
-      ourBallMaskTable[0][size][x + 160] = ourBallMaskTable[0][size][x];
+      table[0][size][x + 160] = table[0][size][x];
     }
   }
 
@@ -667,78 +776,86 @@ void TIA::computeBallMaskTable()
     {
       for(uint32_t x = 0; x < 320; ++x)
       {
-        ourBallMaskTable[align][size][x] =
-            ourBallMaskTable[0][size][(x + 320 - align) % 320];
+        table[align][size][x] =
+            table[0][size][(x + 320 - align) % 320];
       }
     }
   }
+
+  return table;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void TIA::computeCollisionTable()
+constexpr TIA::CollisionTable TIA::computeCollisionTable()
 {
+  CollisionTable table{};
+
   for(uint8_t i = 0; i < 64; ++i)
   {
-    ourCollisionTable[i] = 0;
+    table[i] = 0;
 
     if((i & myM0Bit) && (i & myP1Bit))    // M0-P1
-      ourCollisionTable[i] |= 0x0001;
+      table[i] |= 0x0001;
 
     if((i & myM0Bit) && (i & myP0Bit))    // M0-P0
-      ourCollisionTable[i] |= 0x0002;
+      table[i] |= 0x0002;
 
     if((i & myM1Bit) && (i & myP0Bit))    // M1-P0
-      ourCollisionTable[i] |= 0x0004;
+      table[i] |= 0x0004;
 
     if((i & myM1Bit) && (i & myP1Bit))    // M1-P1
-      ourCollisionTable[i] |= 0x0008;
+      table[i] |= 0x0008;
 
     if((i & myP0Bit) && (i & myPFBit))    // P0-PF
-      ourCollisionTable[i] |= 0x0010;
+      table[i] |= 0x0010;
 
     if((i & myP0Bit) && (i & myBLBit))    // P0-BL
-      ourCollisionTable[i] |= 0x0020;
+      table[i] |= 0x0020;
 
     if((i & myP1Bit) && (i & myPFBit))    // P1-PF
-      ourCollisionTable[i] |= 0x0040;
+      table[i] |= 0x0040;
 
     if((i & myP1Bit) && (i & myBLBit))    // P1-BL
-      ourCollisionTable[i] |= 0x0080;
+      table[i] |= 0x0080;
 
     if((i & myM0Bit) && (i & myPFBit))    // M0-PF
-      ourCollisionTable[i] |= 0x0100;
+      table[i] |= 0x0100;
 
     if((i & myM0Bit) && (i & myBLBit))    // M0-BL
-      ourCollisionTable[i] |= 0x0200;
+      table[i] |= 0x0200;
 
     if((i & myM1Bit) && (i & myPFBit))    // M1-PF
-      ourCollisionTable[i] |= 0x0400;
+      table[i] |= 0x0400;
 
     if((i & myM1Bit) && (i & myBLBit))    // M1-BL
-      ourCollisionTable[i] |= 0x0800;
+      table[i] |= 0x0800;
 
     if((i & myBLBit) && (i & myPFBit))    // BL-PF
-      ourCollisionTable[i] |= 0x1000;
+      table[i] |= 0x1000;
 
     if((i & myP0Bit) && (i & myP1Bit))    // P0-P1
-      ourCollisionTable[i] |= 0x2000;
+      table[i] |= 0x2000;
 
     if((i & myM0Bit) && (i & myM1Bit))    // M0-M1
-      ourCollisionTable[i] |= 0x4000;
+      table[i] |= 0x4000;
   }
+
+  return table;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void TIA::computeMissleMaskTable()
+constexpr TIA::MissleMaskTable TIA::computeMissleMaskTable()
 {
+  MissleMaskTable table{};
+
   // First, calculate masks for alignment 0
-  int x, size, number;
+  int x = 0, size = 0, number = 0;
 
   // Clear the missle table to start with
   for(number = 0; number < 8; ++number)
     for(size = 0; size < 4; ++size)
       for(x = 0; x < 160; ++x)
-        ourMissleMaskTable[0][number][size][x] = false;
+        table[0][number][size][x] = false;
 
   for(number = 0; number < 8; ++number)
   {
@@ -750,58 +867,58 @@ void TIA::computeMissleMaskTable()
         if((number == 0x00) || (number == 0x05) || (number == 0x07))
         {
           if((x >= 0) && (x < (1 << size)))
-            ourMissleMaskTable[0][number][size][x % 160] = true;
+            table[0][number][size][x % 160] = true;
         }
         // Two copies - close
         else if(number == 0x01)
         {
           if((x >= 0) && (x < (1 << size)))
-            ourMissleMaskTable[0][number][size][x % 160] = true;
+            table[0][number][size][x % 160] = true;
           else if(((x - 16) >= 0) && ((x - 16) < (1 << size)))
-            ourMissleMaskTable[0][number][size][x % 160] = true;
+            table[0][number][size][x % 160] = true;
         }
         // Two copies - medium
         else if(number == 0x02)
         {
           if((x >= 0) && (x < (1 << size)))
-            ourMissleMaskTable[0][number][size][x % 160] = true;
+            table[0][number][size][x % 160] = true;
           else if(((x - 32) >= 0) && ((x - 32) < (1 << size)))
-            ourMissleMaskTable[0][number][size][x % 160] = true;
+            table[0][number][size][x % 160] = true;
         }
         // Three copies - close
         else if(number == 0x03)
         {
           if((x >= 0) && (x < (1 << size)))
-            ourMissleMaskTable[0][number][size][x % 160] = true;
+            table[0][number][size][x % 160] = true;
           else if(((x - 16) >= 0) && ((x - 16) < (1 << size)))
-            ourMissleMaskTable[0][number][size][x % 160] = true;
+            table[0][number][size][x % 160] = true;
           else if(((x - 32) >= 0) && ((x - 32) < (1 << size)))
-            ourMissleMaskTable[0][number][size][x % 160] = true;
+            table[0][number][size][x % 160] = true;
         }
         // Two copies - wide
         else if(number == 0x04)
         {
           if((x >= 0) && (x < (1 << size)))
-            ourMissleMaskTable[0][number][size][x % 160] = true;
+            table[0][number][size][x % 160] = true;
           else if(((x - 64) >= 0) && ((x - 64) < (1 << size)))
-            ourMissleMaskTable[0][number][size][x % 160] = true;
+            table[0][number][size][x % 160] = true;
         }
         // Three copies - medium
         else if(number == 0x06)
         {
           if((x >= 0) && (x < (1 << size)))
-            ourMissleMaskTable[0][number][size][x % 160] = true;
+            table[0][number][size][x % 160] = true;
           else if(((x - 32) >= 0) && ((x - 32) < (1 << size)))
-            ourMissleMaskTable[0][number][size][x % 160] = true;
+            table[0][number][size][x % 160] = true;
           else if(((x - 64) >= 0) && ((x - 64) < (1 << size)))
-            ourMissleMaskTable[0][number][size][x % 160] = true;
+            table[0][number][size][x % 160] = true;
         }
       }
 
       // Copy data into wrap-around area
       for(x = 0; x < 160; ++x)
-        ourMissleMaskTable[0][number][size][x + 160] =
-          ourMissleMaskTable[0][number][size][x];
+        table[0][number][size][x + 160] =
+          table[0][number][size][x];
     }
   }
 
@@ -814,25 +931,29 @@ void TIA::computeMissleMaskTable()
       {
         for(x = 0; x < 320; ++x)
         {
-          ourMissleMaskTable[align][number][size][x] =
-            ourMissleMaskTable[0][number][size][(x + 320 - align) % 320];
+          table[align][number][size][x] =
+            table[0][number][size][(x + 320 - align) % 320];
         }
       }
     }
   }
+
+  return table;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void TIA::computePlayerMaskTable()
+constexpr TIA::PlayerMaskTable TIA::computePlayerMaskTable()
 {
+  PlayerMaskTable table{};
+
   // First, calculate masks for alignment 0
-  int x, enable, mode;
+  int x = 0, enable = 0, mode = 0;
 
   // Set the player mask table to all zeros
   for(enable = 0; enable < 2; ++enable)
     for(mode = 0; mode < 8; ++mode)
       for(x = 0; x < 160; ++x)
-        ourPlayerMaskTable[0][enable][mode][x] = 0x00;
+        table[0][enable][mode][x] = 0x00;
 
   // Now, compute the player mask table
   for(enable = 0; enable < 2; ++enable)
@@ -844,68 +965,68 @@ void TIA::computePlayerMaskTable()
         if(mode == 0x00)
         {
           if((enable == 0) && (x >= 0) && (x < 8))
-            ourPlayerMaskTable[0][enable][mode][x % 160] = 0x80 >> x;
+            table[0][enable][mode][x % 160] = 0x80 >> x;
         }
         else if(mode == 0x01)
         {
           if((enable == 0) && (x >= 0) && (x < 8))
-            ourPlayerMaskTable[0][enable][mode][x % 160] = 0x80 >> x;
+            table[0][enable][mode][x % 160] = 0x80 >> x;
           else if(((x - 16) >= 0) && ((x - 16) < 8))
-            ourPlayerMaskTable[0][enable][mode][x % 160] = 0x80 >> (x - 16);
+            table[0][enable][mode][x % 160] = 0x80 >> (x - 16);
         }
         else if(mode == 0x02)
         {
           if((enable == 0) && (x >= 0) && (x < 8))
-            ourPlayerMaskTable[0][enable][mode][x % 160] = 0x80 >> x;
+            table[0][enable][mode][x % 160] = 0x80 >> x;
           else if(((x - 32) >= 0) && ((x - 32) < 8))
-            ourPlayerMaskTable[0][enable][mode][x % 160] = 0x80 >> (x - 32);
+            table[0][enable][mode][x % 160] = 0x80 >> (x - 32);
         }
         else if(mode == 0x03)
         {
           if((enable == 0) && (x >= 0) && (x < 8))
-            ourPlayerMaskTable[0][enable][mode][x % 160] = 0x80 >> x;
+            table[0][enable][mode][x % 160] = 0x80 >> x;
           else if(((x - 16) >= 0) && ((x - 16) < 8))
-            ourPlayerMaskTable[0][enable][mode][x % 160] = 0x80 >> (x - 16);
+            table[0][enable][mode][x % 160] = 0x80 >> (x - 16);
           else if(((x - 32) >= 0) && ((x - 32) < 8))
-            ourPlayerMaskTable[0][enable][mode][x % 160] = 0x80 >> (x - 32);
+            table[0][enable][mode][x % 160] = 0x80 >> (x - 32);
         }
         else if(mode == 0x04)
         {
           if((enable == 0) && (x >= 0) && (x < 8))
-            ourPlayerMaskTable[0][enable][mode][x % 160] = 0x80 >> x;
+            table[0][enable][mode][x % 160] = 0x80 >> x;
           else if(((x - 64) >= 0) && ((x - 64) < 8))
-            ourPlayerMaskTable[0][enable][mode][x % 160] = 0x80 >> (x - 64);
+            table[0][enable][mode][x % 160] = 0x80 >> (x - 64);
         }
         else if(mode == 0x05)
         {
           // For some reason in double size mode the player's output
           // is delayed by one pixel thus we use > instead of >=
           if((enable == 0) && (x > 0) && (x <= 16))
-            ourPlayerMaskTable[0][enable][mode][x % 160] = 0x80 >> ((x - 1)/2);
+            table[0][enable][mode][x % 160] = 0x80 >> ((x - 1)/2);
         }
         else if(mode == 0x06)
         {
           if((enable == 0) && (x >= 0) && (x < 8))
-            ourPlayerMaskTable[0][enable][mode][x % 160] = 0x80 >> x;
+            table[0][enable][mode][x % 160] = 0x80 >> x;
           else if(((x - 32) >= 0) && ((x - 32) < 8))
-            ourPlayerMaskTable[0][enable][mode][x % 160] = 0x80 >> (x - 32);
+            table[0][enable][mode][x % 160] = 0x80 >> (x - 32);
           else if(((x - 64) >= 0) && ((x - 64) < 8))
-            ourPlayerMaskTable[0][enable][mode][x % 160] = 0x80 >> (x - 64);
+            table[0][enable][mode][x % 160] = 0x80 >> (x - 64);
         }
         else if(mode == 0x07)
         {
           // For some reason in quad size mode the player's output
           // is delayed by one pixel thus we use > instead of >=
           if((enable == 0) && (x > 0) && (x <= 32))
-            ourPlayerMaskTable[0][enable][mode][x % 160] = 0x80 >> ((x - 1)/4);
+            table[0][enable][mode][x % 160] = 0x80 >> ((x - 1)/4);
         }
       }
 
       // Copy data into wrap-around area
       for(x = 0; x < 160; ++x)
       {
-        ourPlayerMaskTable[0][enable][mode][x + 160] =
-            ourPlayerMaskTable[0][enable][mode][x];
+        table[0][enable][mode][x + 160] =
+            table[0][enable][mode][x];
       }
     }
   }
@@ -919,18 +1040,30 @@ void TIA::computePlayerMaskTable()
       {
         for(x = 0; x < 320; ++x)
         {
-          ourPlayerMaskTable[align][enable][mode][x] =
-              ourPlayerMaskTable[0][enable][mode][(x + 320 - align) % 320];
+          table[align][enable][mode][x] =
+              table[0][enable][mode][(x + 320 - align) % 320];
         }
       }
     }
   }
+
+  return table;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void TIA::computePlayerPositionResetWhenTable()
+constexpr TIA::PlayerPositionResetWhenTable TIA::computePlayerPositionResetWhenTable()
 {
-  uint32_t mode, oldx, newx;
+  PlayerPositionResetWhenTable table{};
+
+  // Number of copies of the player, their offsets from the first copy and
+  // the width of the player for each of the player modes
+  const uint32_t copies[8] = { 1, 2, 2, 3, 2, 1, 3, 1 };
+  const uint32_t offsets[8][3] = {
+    { 0 }, { 0, 16 }, { 0, 32 }, { 0, 16, 32 }, { 0, 64 }, { 0 }, { 0, 32, 64 }, { 0 }
+  };
+  const uint32_t widths[8] = { 8, 8, 8, 8, 8, 16, 8, 32 };
+
+  uint32_t mode = 0, oldx = 0, newx = 0;
 
   // Loop through all player modes, all old player positions, and all new
   // player positions and determine where the new position is located:
@@ -941,126 +1074,43 @@ void TIA::computePlayerPositionResetWhenTable()
   {
     for(oldx = 0; oldx < 160; ++oldx)
     {
-      // Set everything to 0 for non-delay/non-display section
-      for(newx = 0; newx < 160; ++newx)
-      {
-        ourPlayerPositionResetWhenTable[mode][oldx][newx] = 0;
-      }
+      std::array<int8_t, 160>& row = table[mode][oldx];
 
-      // Now, we'll set the entries for non-delay/non-display section
-      for(newx = 0; newx < 160 + 72 + 5; ++newx)
+      // Each copy has a 4 pixel delay followed by its display; the copies
+      // are visited from left to right, so if they wrap around the right
+      // edge of the screen they overwrite earlier entries as they should
+      for(uint32_t copy = 0; copy < copies[mode]; ++copy)
       {
-        if(mode == 0x00)
-        {
-          if((newx >= oldx) && (newx < (oldx + 4)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
+        uint32_t start = oldx + offsets[mode][copy];
 
-          if((newx >= oldx + 4) && (newx < (oldx + 4 + 8)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
-        }
-        else if(mode == 0x01)
-        {
-          if((newx >= oldx) && (newx < (oldx + 4)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
-          else if((newx >= (oldx + 16)) && (newx < (oldx + 16 + 4)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
+        for(newx = start; newx < start + 4; ++newx)
+          row[newx % 160] = -1;
 
-          if((newx >= oldx + 4) && (newx < (oldx + 4 + 8)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
-          else if((newx >= oldx + 16 + 4) && (newx < (oldx + 16 + 4 + 8)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
-        }
-        else if(mode == 0x02)
-        {
-          if((newx >= oldx) && (newx < (oldx + 4)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
-          else if((newx >= (oldx + 32)) && (newx < (oldx + 32 + 4)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
-
-          if((newx >= oldx + 4) && (newx < (oldx + 4 + 8)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
-          else if((newx >= oldx + 32 + 4) && (newx < (oldx + 32 + 4 + 8)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
-        }
-        else if(mode == 0x03)
-        {
-          if((newx >= oldx) && (newx < (oldx + 4)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
-          else if((newx >= (oldx + 16)) && (newx < (oldx + 16 + 4)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
-          else if((newx >= (oldx + 32)) && (newx < (oldx + 32 + 4)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
-
-          if((newx >= oldx + 4) && (newx < (oldx + 4 + 8)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
-          else if((newx >= oldx + 16 + 4) && (newx < (oldx + 16 + 4 + 8)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
-          else if((newx >= oldx + 32 + 4) && (newx < (oldx + 32 + 4 + 8)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
-        }
-        else if(mode == 0x04)
-        {
-          if((newx >= oldx) && (newx < (oldx + 4)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
-          else if((newx >= (oldx + 64)) && (newx < (oldx + 64 + 4)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
-
-          if((newx >= oldx + 4) && (newx < (oldx + 4 + 8)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
-          else if((newx >= oldx + 64 + 4) && (newx < (oldx + 64 + 4 + 8)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
-        }
-        else if(mode == 0x05)
-        {
-          if((newx >= oldx) && (newx < (oldx + 4)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
-
-          if((newx >= oldx + 4) && (newx < (oldx + 4 + 16)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
-        }
-        else if(mode == 0x06)
-        {
-          if((newx >= oldx) && (newx < (oldx + 4)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
-          else if((newx >= (oldx + 32)) && (newx < (oldx + 32 + 4)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
-          else if((newx >= (oldx + 64)) && (newx < (oldx + 64 + 4)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
-
-          if((newx >= oldx + 4) && (newx < (oldx + 4 + 8)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
-          else if((newx >= oldx + 32 + 4) && (newx < (oldx + 32 + 4 + 8)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
-          else if((newx >= oldx + 64 + 4) && (newx < (oldx + 64 + 4 + 8)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
-        }
-        else if(mode == 0x07)
-        {
-          if((newx >= oldx) && (newx < (oldx + 4)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = -1;
-
-          if((newx >= oldx + 4) && (newx < (oldx + 4 + 32)))
-            ourPlayerPositionResetWhenTable[mode][oldx][newx % 160] = 1;
-        }
+        for(newx = start + 4; newx < start + 4 + widths[mode]; ++newx)
+          row[newx % 160] = 1;
       }
 
       // Let's do a sanity check on our table entries
       uint32_t s1 = 0, s2 = 0;
       for(newx = 0; newx < 160; ++newx)
       {
-        if(ourPlayerPositionResetWhenTable[mode][oldx][newx] == -1)
+        if(row[newx] == -1)
           ++s1;
-        if(ourPlayerPositionResetWhenTable[mode][oldx][newx] == 1)
+        if(row[newx] == 1)
           ++s2;
       }
       assert((s1 % 4 == 0) && (s2 % 8 == 0));
     }
   }
+
+  return table;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void TIA::computePlayerReflectTable()
+constexpr TIA::PlayerReflectTable TIA::computePlayerReflectTable()
 {
+  PlayerReflectTable table{};
+
   for(uint16_t i = 0; i < 256; ++i)
   {
     uint8_t r = 0;
@@ -1070,48 +1120,77 @@ void TIA::computePlayerReflectTable()
       r = (r << 1) | ((i & t) ? 0x01 : 0x00);
     }
 
-    ourPlayerReflectTable[i] = r;
+    table[i] = r;
   }
+
+  return table;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void TIA::computePlayfieldMaskTable()
+constexpr TIA::PlayfieldTable TIA::computePlayfieldMaskTable()
 {
-  int x;
+  PlayfieldTable table{};
+
+  int x = 0;
 
   // Compute playfield mask table for non-reflected mode
   for(x = 0; x < 160; ++x)
   {
     if(x < 16)
-      ourPlayfieldTable[0][x] = 0x00001 << (x / 4);
+      table[0][x] = 0x00001 << (x / 4);
     else if(x < 48)
-      ourPlayfieldTable[0][x] = 0x00800 >> ((x - 16) / 4);
+      table[0][x] = 0x00800 >> ((x - 16) / 4);
     else if(x < 80)
-      ourPlayfieldTable[0][x] = 0x01000 << ((x - 48) / 4);
+      table[0][x] = 0x01000 << ((x - 48) / 4);
     else if(x < 96)
-      ourPlayfieldTable[0][x] = 0x00001 << ((x - 80) / 4);
+      table[0][x] = 0x00001 << ((x - 80) / 4);
     else if(x < 128)
-      ourPlayfieldTable[0][x] = 0x00800 >> ((x - 96) / 4);
+      table[0][x] = 0x00800 >> ((x - 96) / 4);
     else if(x < 160)
-      ourPlayfieldTable[0][x] = 0x01000 << ((x - 128) / 4);
+      table[0][x] = 0x01000 << ((x - 128) / 4);
   }
 
   // Compute playfield mask table for reflected mode
   for(x = 0; x < 160; ++x)
   {
     if(x < 16)
-      ourPlayfieldTable[1][x] = 0x00001 << (x / 4);
+      table[1][x] = 0x00001 << (x / 4);
     else if(x < 48)
-      ourPlayfieldTable[1][x] = 0x00800 >> ((x - 16) / 4);
+      table[1][x] = 0x00800 >> ((x - 16) / 4);
     else if(x < 80)
-      ourPlayfieldTable[1][x] = 0x01000 << ((x - 48) / 4);
+      table[1][x] = 0x01000 << ((x - 48) / 4);
     else if(x < 112)
-      ourPlayfieldTable[1][x] = 0x80000 >> ((x - 80) / 4);
+      table[1][x] = 0x80000 >> ((x - 80) / 4);
     else if(x < 144)
-      ourPlayfieldTable[1][x] = 0x00010 << ((x - 112) / 4);
+      table[1][x] = 0x00010 << ((x - 112) / 4);
     else if(x < 160)
-      ourPlayfieldTable[1][x] = 0x00008 >> ((x - 144) / 4);
+      table[1][x] = 0x00008 >> ((x - 144) / 4);
   }
+
+  return table;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+inline uint16_t TIA::rasterize(uint32_t hpos, uint32_t count, uint8_t* out)
+{
+  TIARasterState state;
+  state.pfMask = myCurrentPFMask;
+  state.pf = myPF;
+  state.p0Mask = myCurrentP0Mask;
+  state.p1Mask = myCurrentP1Mask;
+  state.grp0 = myCurrentGRP0;
+  state.grp1 = myCurrentGRP1;
+  state.m0Mask = myCurrentM0Mask;
+  state.m1Mask = myCurrentM1Mask;
+  state.blMask = myCurrentBLMask;
+  state.enabledObjects = myEnabledObjects;
+  state.colorIndex[0] = &ourPriorityEncoder[0][myPlayfieldPriorityAndScore];
+  state.colorIndex[1] = &ourPriorityEncoder[1][myPlayfieldPriorityAndScore];
+  for(int i = 0; i < 4; ++i)
+    state.colors[i] = (uint8_t)myColor[i];
+  state.collisionTable = ourCollisionTable.data();
+
+  return myRasterizer(state, hpos, count, out);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -1673,29 +1752,7 @@ inline void TIA::updateFrameScanline(uint32_t clocksToUpdate, uint32_t hpos)
       // Handle all of the other cases
       default:
       {
-        for(; myFramePointer < ending; ++myFramePointer, ++hpos)
-        {
-          uint8_t enabled = (myPF & myCurrentPFMask[hpos]) ? myPFBit : 0;
-
-          if((myEnabledObjects & myBLBit) && myCurrentBLMask[hpos])
-            enabled |= myBLBit;
-
-          if(myCurrentGRP1 & myCurrentP1Mask[hpos])
-            enabled |= myP1Bit;
-
-          if((myEnabledObjects & myM1Bit) && myCurrentM1Mask[hpos])
-            enabled |= myM1Bit;
-
-          if(myCurrentGRP0 & myCurrentP0Mask[hpos])
-            enabled |= myP0Bit;
-
-          if((myEnabledObjects & myM0Bit) && myCurrentM0Mask[hpos])
-            enabled |= myM0Bit;
-
-          myCollision |= ourCollisionTable[enabled];
-          *myFramePointer = myColor[myPriorityEncoder[hpos < 80 ? 0 : 1]
-              [enabled | myPlayfieldPriorityAndScore]];
-        }
+        myCollision |= rasterize(hpos, clocksToUpdate, myFramePointer);
         break;
       }
     }
@@ -1721,6 +1778,8 @@ inline void TIA::updateFrame(int clock)
     clock = myClockStopDisplay;
   }
 
+  ALE_PERF_ADD(myPerfStats->tia_clocks, clock - myClockAtLastUpdate);
+
   // Update frame one scanline at a time
   do
   {
@@ -1794,7 +1853,7 @@ inline void TIA::updateFrame(int clock)
       myFramePointer -= (160 - myFrameWidth - myFrameXStart);
 
       // Yes, so set PF mask based on current CTRLPF reflection state
-      myCurrentPFMask = ourPlayfieldTable[myCTRLPF & 0x01];
+      myCurrentPFMask = ourPlayfieldTable[myCTRLPF & 0x01].data();
 
       // TODO: These should be reset right after the first copy of the player
       // has passed.  However, for now we'll just reset at the end of the
@@ -1808,7 +1867,7 @@ inline void TIA::updateFrame(int clock)
       if(myM0CosmicArkMotionEnabled)
       {
         // Movement table associated with the bug
-        static uint32_t m[4] = {18, 33, 0, 17};
+        static const uint32_t m[4] = {18, 33, 0, 17};
 
         myM0CosmicArkCounter = (myM0CosmicArkCounter + 1) & 3;
         myPOSM0 -= m[myM0CosmicArkCounter];
@@ -1871,10 +1930,84 @@ void TIA::greyOutFrame()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIA::clearBuffers()
 {
-  for(uint32_t i = 0; i < 160 * 300; ++i)
+  for(uint32_t i = 0; i < myFrameBufferSize; ++i)
   {
     myCurrentFrameBuffer[i] = myPreviousFrameBuffer[i] = 0;
   }
+  invalidateFrameBuffers();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIA::resizeBuffers(uint32_t height)
+{
+  // The frame is at least 200 lines high (see frameReset), and only the
+  // displayed scanlines are ever drawn
+  uint32_t size = 160 * std::max(height, (uint32_t)200);
+
+  if(size != myFrameBufferSize)
+  {
+    delete[] myCurrentFrameBuffer;
+    delete[] myPreviousFrameBuffer;
+    delete[] myScanlineGenerations;
+
+    myCurrentFrameBuffer = new uint8_t[size];
+    myPreviousFrameBuffer = new uint8_t[size];
+    myScanlineGenerations = new uint64_t[size / 160];
+    myFrameBufferSize = size;
+    invalidateFrameBuffers();
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIA::restoreFramePointer()
+{
+  // A state saved with a taller display must not draw past the buffers
+  int lines = (int)(myFrameBufferSize / 160);
+  myClockStopDisplay = std::min(myClockStopDisplay,
+                                myClockStartDisplay + 228 * lines);
+
+  int drawn = myClockAtLastUpdate - myClockStartDisplay;
+  drawn = std::max(0, std::min(drawn, myClockStopDisplay - myClockStartDisplay));
+  myFramePointer = myCurrentFrameBuffer + (drawn / 228) * 160 +
+      std::max(0, (drawn % 228) - HBLANK);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIA::compareBuffers()
+{
+  ++myFrameGeneration;
+  for(uint32_t s = 0; s < myFrameBufferSize / 160; ++s)
+  {
+    if(memcmp(myCurrentFrameBuffer + s * 160,
+              myPreviousFrameBuffer + s * 160, 160) != 0)
+      myScanlineGenerations[s] = myFrameGeneration;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIA::invalidateFrameBuffers()
+{
+  ++myFrameGeneration;
+  for(uint32_t s = 0; s < myFrameBufferSize / 160; ++s)
+    myScanlineGenerations[s] = myFrameGeneration;
+  myFrameComparable = false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+inline void TIA::readFireButtons()
+{
+  // The buttons only depend on the events, so the controllers are asked
+  // again only once the events have changed (about once per frame) rather
+  // than on every poll
+  uint64_t version = myConsole.event().version();
+  if(myFireButtonsVersion != version)
+  {
+    myINPT4 = myConsole.controller(Controller::Left).read(Controller::Six) ?
+        0x80 : 0x00;
+    myINPT5 = myConsole.controller(Controller::Right).read(Controller::Six) ?
+        0x80 : 0x00;
+    myFireButtonsVersion = version;
+  }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -2023,12 +2156,12 @@ uint8_t TIA::peek(uint16_t addr)
     }
 
     case 0x0C:    // INPT4
-      return myConsole.controller(Controller::Left).read(Controller::Six) ?
-          (0x80 | noise) : noise;
+      readFireButtons();
+      return myINPT4 | noise;
 
     case 0x0D:    // INPT5
-      return myConsole.controller(Controller::Right).read(Controller::Six) ?
-          (0x80 | noise) : noise;
+      readFireButtons();
+      return myINPT5 | noise;
 
     case 0x0e:
       return noise;
@@ -2042,6 +2175,7 @@ uint8_t TIA::peek(uint16_t addr)
 void TIA::poke(uint16_t addr, uint8_t value)
 {
   addr = addr & 0x003f;
+  ALE_PERF_ADD(myPerfStats->tia_pokes, 1);
 
   int clock = mySystem->cycles() * 3;
   int16_t delay = ourPokeDelayTable[addr];
@@ -2049,7 +2183,7 @@ void TIA::poke(uint16_t addr, uint8_t value)
   // See if this is a poke to a PF register
   if(delay == -1)
   {
-    static uint32_t d[4] = {4, 5, 2, 3};
+    static const uint32_t d[4] = {4, 5, 2, 3};
     int x = ((clock - myClockWhenFrameStarted) % 228);
     delay = d[(x / 3) & 3];
   }
@@ -2220,7 +2354,7 @@ void TIA::poke(uint16_t addr, uint8_t value)
       // we're still on the left hand side of the playfield
       if(((clock - myClockWhenFrameStarted) % 228) < (68 + 79))
       {
-        myCurrentPFMask = ourPlayfieldTable[myCTRLPF & 0x01];
+        myCurrentPFMask = ourPlayfieldTable[myCTRLPF & 0x01].data();
       }
 
       myCurrentBLMask = &ourBallMaskTable[myPOSBL & 0x03]
@@ -2454,42 +2588,48 @@ void TIA::poke(uint16_t addr, uint8_t value)
     case 0x15:    // Audio control 0
     {
       myAUDC0 = value & 0x0f;
-      mySound->set(addr, value, mySystem->cycles());
+      if(!mySoundIsNull)
+        mySound->set(addr, value, mySystem->cycles());
       break;
     }
 
     case 0x16:    // Audio control 1
     {
       myAUDC1 = value & 0x0f;
-      mySound->set(addr, value, mySystem->cycles());
+      if(!mySoundIsNull)
+        mySound->set(addr, value, mySystem->cycles());
       break;
     }
 
     case 0x17:    // Audio frequency 0
     {
       myAUDF0 = value & 0x1f;
-      mySound->set(addr, value, mySystem->cycles());
+      if(!mySoundIsNull)
+        mySound->set(addr, value, mySystem->cycles());
       break;
     }
 
     case 0x18:    // Audio frequency 1
     {
       myAUDF1 = value & 0x1f;
-      mySound->set(addr, value, mySystem->cycles());
+      if(!mySoundIsNull)
+        mySound->set(addr, value, mySystem->cycles());
       break;
     }
 
     case 0x19:    // Audio volume 0
     {
       myAUDV0 = value & 0x0f;
-      mySound->set(addr, value, mySystem->cycles());
+      if(!mySoundIsNull)
+        mySound->set(addr, value, mySystem->cycles());
       break;
     }
 
     case 0x1A:    // Audio volume 1
     {
       myAUDV1 = value & 0x0f;
-      mySound->set(addr, value, mySystem->cycles());
+      if(!mySoundIsNull)
+        mySound->set(addr, value, mySystem->cycles());
       break;
     }
 
@@ -2819,10 +2959,12 @@ void TIA::poke(uint16_t addr, uint8_t value)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-uint8_t TIA::ourBallMaskTable[4][4][320];
+alignas(4) constexpr TIA::BallMaskTable TIA::ourBallMaskTable =
+    computeBallMaskTable();
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-uint16_t TIA::ourCollisionTable[64];
+constexpr TIA::CollisionTable TIA::ourCollisionTable =
+    computeCollisionTable();
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 const uint8_t TIA::ourDisabledMaskTable[640] = {};
@@ -2836,7 +2978,8 @@ const int16_t TIA::ourPokeDelayTable[64] = {
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-uint8_t TIA::ourMissleMaskTable[4][8][4][320];
+alignas(4) constexpr TIA::MissleMaskTable TIA::ourMissleMaskTable =
+    computeMissleMaskTable();
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 const bool TIA::ourHMOVEBlankEnableCycles[76] = {
@@ -2931,22 +3074,32 @@ const int TIA::ourCompleteMotionTable[76][16] = {
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-uint8_t TIA::ourPlayerMaskTable[4][2][8][320];
+alignas(4) constexpr TIA::PlayerMaskTable TIA::ourPlayerMaskTable =
+    computePlayerMaskTable();
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+constexpr TIA::PlayerPositionResetWhenTable
+    TIA::ourPlayerPositionResetWhenTable =
+        computePlayerPositionResetWhenTable();
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-int8_t TIA::ourPlayerPositionResetWhenTable[8][160][160];
+constexpr TIA::PlayerReflectTable TIA::ourPlayerReflectTable =
+    computePlayerReflectTable();
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-uint8_t TIA::ourPlayerReflectTable[256];
+constexpr TIA::PlayfieldTable TIA::ourPlayfieldTable =
+    computePlayfieldMaskTable();
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-uint32_t TIA::ourPlayfieldTable[2][160];
+constexpr TIA::PriorityEncoderTable TIA::ourPriorityEncoder =
+    computePriorityEncoder();
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 TIA::TIA(const TIA& c)
     : myConsole(c.myConsole),
       mySettings(c.mySettings),
       mySound(c.mySound),
+      myPerfStats(c.myPerfStats),
       myCOLUBK(myColor[0]),
       myCOLUPF(myColor[1]),
       myCOLUP0(myColor[2]),
@@ -3530,29 +3683,7 @@ inline void TIA::updateFrameScanlineFast(uint32_t clocksToUpdate, uint32_t hpos)
       // Handle all of the other cases
       default:
       {
-        for(; myFramePointer < ending; ++myFramePointer, ++hpos)
-        {
-          uint8_t enabled = (myPF & myCurrentPFMask[hpos]) ? myPFBit : 0;
-
-          if((myEnabledObjects & myBLBit) && myCurrentBLMask[hpos])
-            enabled |= myBLBit;
-
-          if(myCurrentGRP1 & myCurrentP1Mask[hpos])
-            enabled |= myP1Bit;
-
-          if((myEnabledObjects & myM1Bit) && myCurrentM1Mask[hpos])
-            enabled |= myM1Bit;
-
-          if(myCurrentGRP0 & myCurrentP0Mask[hpos])
-            enabled |= myP0Bit;
-
-          if((myEnabledObjects & myM0Bit) && myCurrentM0Mask[hpos])
-            enabled |= myM0Bit;
-
-          myCollision |= ourCollisionTable[enabled];
-          /* @strip *myFramePointer = myColor[myPriorityEncoder[hpos < 80 ? 0 : 1]
-              [enabled | myPlayfieldPriorityAndScore]]; */
-        }
+        myCollision |= rasterize(hpos, clocksToUpdate, /* @strip myFramePointer */ 0);
         break;
       }
     }
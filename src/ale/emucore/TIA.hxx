@@ -31,9 +31,13 @@ class Settings;
 }  // namespace stella
 }  // namespace ale
 
+#include <array>
+
 #include "ale/emucore/Sound.hxx"
 #include "ale/emucore/Device.hxx"
 #include "ale/emucore/MediaSrc.hxx"
+#include "ale/emucore/TIARaster.hxx"
+#include "ale/common/PerfStats.hpp"
 
 namespace ale {
 namespace stella {
@@ -119,6 +123,14 @@ class TIA : public Device , public MediaSource
     */
     virtual bool load(Deserializer& in);
 
+    /**
+      Mixes the registers and the beam position into the given hash.  The
+      frame buffers and the sound state are not included.
+
+      @param out The hash to update
+    */
+    virtual void hash(StateHash& out);
+
   public:
     /**
       Get the byte at the specified address
@@ -156,6 +168,29 @@ class TIA : public Device , public MediaSource
     */
     uint8_t* previousFrameBuffer() const { return myPreviousFrameBuffer; }
 
+    /**
+      Answers the generation of the frame buffers
+
+      @return The current generation
+    */
+    uint64_t frameGeneration() const { return myFrameGeneration; }
+
+    /**
+      Answers the last generation in which each scanline changed
+
+      @return Pointer to height() generations
+    */
+    const uint64_t* scanlineGenerations() const
+    {
+      return myScanlineGenerations;
+    }
+
+    /**
+      Marks every scanline as changed, after the frame buffers were
+      written from outside
+    */
+    void invalidateFrameBuffers();
+
     /**
       Answers the height of the frame buffer
 
@@ -186,6 +221,13 @@ class TIA : public Device , public MediaSource
     */
     uint32_t clocksThisLine() const;
 
+    /**
+      Answers the number of frames completed since this TIA was created.
+
+      @return The number of frames completed
+    */
+    uint32_t frameCount() const { return myFrameCounter; }
+
     /**
       Sets the sound device for the TIA.
     */
@@ -222,28 +264,49 @@ class TIA : public Device , public MediaSource
     void enableBits(bool mode) { for(uint8_t i = 0; i < 6; ++i) myBitEnabled[i] = mode; }
 
   private:
+    // Lookup tables, built at compile time by the functions below
+    typedef std::array<std::array<std::array<uint8_t, 320>, 4>, 4> BallMaskTable;
+    typedef std::array<uint16_t, 64> CollisionTable;
+    typedef std::array<std::array<std::array<std::array<uint8_t, 320>, 4>, 8>, 4>
+        MissleMaskTable;
+    typedef std::array<std::array<std::array<std::array<uint8_t, 320>, 8>, 2>, 4>
+        PlayerMaskTable;
+    typedef std::array<std::array<std::array<int8_t, 160>, 160>, 8>
+        PlayerPositionResetWhenTable;
+    typedef std::array<uint8_t, 256> PlayerReflectTable;
+    typedef std::array<std::array<uint32_t, 160>, 2> PlayfieldTable;
+    typedef std::array<std::array<uint8_t, 256>, 2> PriorityEncoderTable;
+
     // Compute the ball mask table
-    static void computeBallMaskTable();
+    static constexpr BallMaskTable computeBallMaskTable();
 
     // Compute the collision decode table
-    static void computeCollisionTable();
+    static constexpr CollisionTable computeCollisionTable();
 
     // Compute the missle mask table
-    static void computeMissleMaskTable();
+    static constexpr MissleMaskTable computeMissleMaskTable();
 
     // Compute the player mask table
-    static void computePlayerMaskTable();
+    static constexpr PlayerMaskTable computePlayerMaskTable();
 
     // Compute the player position reset when table
-    static void computePlayerPositionResetWhenTable();
+    static constexpr PlayerPositionResetWhenTable
+        computePlayerPositionResetWhenTable();
 
     // Compute the player reflect table
-    static void computePlayerReflectTable();
+    static constexpr PlayerReflectTable computePlayerReflectTable();
 
     // Compute playfield mask table
-    static void computePlayfieldMaskTable();
+    static constexpr PlayfieldTable computePlayfieldMaskTable();
+
+    // Compute the colour register drawn for each combination of objects
+    static constexpr PriorityEncoderTable computePriorityEncoder();
 
   private:
+    // Draw count pixels of the scanline from hpos on when several objects
+    // are visible, answering the collisions; out may be the null pointer
+    uint16_t rasterize(uint32_t hpos, uint32_t count, uint8_t* out);
+
     // Update the current frame buffer up to one scanline
     void updateFrameScanline(uint32_t clocksToUpdate, uint32_t hpos);
 
@@ -259,6 +322,22 @@ class TIA : public Device , public MediaSource
     // Clear both internal TIA buffers to black (palette color 0)
     void clearBuffers();
 
+    // Make the frame buffers large enough for the given display height
+    void resizeBuffers(uint32_t height);
+
+    // Point the frame pointer at the pixel that the restored clocks have
+    // drawn up to, so that a frame resumed from a saved state stays within
+    // the frame buffers
+    void restoreFramePointer();
+
+    // Record the scanlines of the finished frame that differ from the
+    // previous frame, in a new generation
+    void compareBuffers();
+
+    // Read the fire buttons (bit 7 of INPT4 and INPT5) from the controllers
+    // if the events have changed since they were last read
+    void readFireButtons();
+
     // Set up bookkeeping for the next frame
     void startFrame();
 
@@ -275,6 +354,12 @@ class TIA : public Device , public MediaSource
     // Sound object the TIA is associated with
     Sound* mySound;
 
+    // Whether the sound object ignores audio register writes
+    bool mySoundIsNull;
+
+    // Counters of the owning OSystem (only updated with ALE_PERF_STATS)
+    ale::PerfStats* myPerfStats;
+
   private:
     // Indicates if color loss should be enabled or disabled.  Color loss
     // occurs on PAL (and maybe SECAM) systems when the previous frame
@@ -287,7 +372,7 @@ class TIA : public Device , public MediaSource
 
   private:
     // Number of frames displayed by this TIA
-    int myFrameCounter;
+    uint32_t myFrameCounter;
 
     // Pointer to the current frame buffer
     uint8_t* myCurrentFrameBuffer;
@@ -295,6 +380,20 @@ class TIA : public Device , public MediaSource
     // Pointer to the previous frame buffer
     uint8_t* myPreviousFrameBuffer;
 
+    // Size of each frame buffer, which holds the displayed scanlines only
+    uint32_t myFrameBufferSize;
+
+    // Generation of the frame buffers (see MediaSource::frameGeneration)
+    uint64_t myFrameGeneration;
+
+    // Last generation in which each scanline of the frame buffers changed
+    uint64_t* myScanlineGenerations;
+
+    // Indicates whether the frame being drawn was started in a fresh buffer
+    // and has been drawn without interruption, so its scanlines can be
+    // compared with the previous frame's when it ends
+    bool myFrameComparable;
+
     // Pointer to the next pixel that will be drawn in the current frame buffer
     uint8_t* myFramePointer;
 
@@ -380,7 +479,9 @@ class TIA : public Device , public MediaSource
 
     uint8_t myPlayfieldPriorityAndScore;
     uint32_t myColor[4];
-    uint8_t myPriorityEncoder[2][256];
+
+    // Draws scanlines with several objects (see TIARaster.hxx)
+    TIARasterizer myRasterizer;
 
     uint32_t& myCOLUBK;       // Background color register (replicated 4 times)
     uint32_t& myCOLUPF;       // Playfield color register (replicated 4 times)
@@ -475,6 +576,12 @@ class TIA : public Device , public MediaSource
     // Indicates if the dump is current enabled for the paddles
     bool myDumpEnabled;
 
+    // Fire buttons (bit 7 of INPT4 and INPT5) as last read from the
+    // controllers, and the version of the events they were read at
+    uint8_t myINPT4;
+    uint8_t myINPT5;
+    uint64_t myFireButtonsVersion;
+
   private:
     // Color clock when last HMOVE occured
     int myLastHMOVEClock;
@@ -499,10 +606,10 @@ class TIA : public Device , public MediaSource
 
   private:
     // Ball mask table (entries are true or false)
-    static uint8_t ourBallMaskTable[4][4][320];
+    static const BallMaskTable ourBallMaskTable;
 
     // Used to set the collision register to the correct value
-    static uint16_t ourCollisionTable[64];
+    static const CollisionTable ourCollisionTable;
 
     // A mask table which can be used when an object is disabled
     static const uint8_t ourDisabledMaskTable[640];
@@ -511,7 +618,7 @@ class TIA : public Device , public MediaSource
     static const int16_t ourPokeDelayTable[64];
 
     // Missle mask table (entries are true or false)
-    static uint8_t ourMissleMaskTable[4][8][4][320];
+    static const MissleMaskTable ourMissleMaskTable;
 
     // Used to convert value written in a motion register into
     // its internal representation
@@ -521,16 +628,20 @@ class TIA : public Device , public MediaSource
     static const bool ourHMOVEBlankEnableCycles[76];
 
     // Player mask table
-    static uint8_t ourPlayerMaskTable[4][2][8][320];
+    static const PlayerMaskTable ourPlayerMaskTable;
 
     // Indicates if player is being reset during delay, display or other times
-    static int8_t ourPlayerPositionResetWhenTable[8][160][160];
+    static const PlayerPositionResetWhenTable ourPlayerPositionResetWhenTable;
 
     // Used to reflect a players graphics
-    static uint8_t ourPlayerReflectTable[256];
+    static const PlayerReflectTable ourPlayerReflectTable;
 
     // Playfield mask table for reflected and non-reflected playfields
-    static uint32_t ourPlayfieldTable[2][160];
+    static const PlayfieldTable ourPlayfieldTable;
+
+    // Colour register (index into myColor) drawn for each combination of
+    // objects and playfield priority/score bits, for each half of the screen
+    static const PriorityEncoderTable ourPriorityEncoder;
 
   private:
     // Copy constructor isn't supported by this class so make it private
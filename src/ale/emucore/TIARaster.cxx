@@ -0,0 +1,404 @@
+/******************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2013 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details.
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ *  TIARaster.cxx
+ *
+ *  Generic scanline rasterizer used by the TIA when several objects are
+ *  drawn on the same stretch of a scanline, with SSSE3 and AVX2 versions
+ *  selected at run time.
+ **************************************************************************** */
+
+#include "ale/emucore/TIARaster.hxx"
+
+// The vector versions rely on GCC/Clang function-level target attributes,
+// so that the rest of the library does not need to be built for AVX2
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+  #define TIA_RASTER_X86
+  #include <immintrin.h>
+#endif
+
+namespace ale {
+namespace stella {
+
+namespace {
+
+// Same object bits as the TIA uses
+enum
+{
+  P0Bit = 0x01,
+  M0Bit = 0x02,
+  P1Bit = 0x04,
+  M1Bit = 0x08,
+  BLBit = 0x10,
+  PFBit = 0x20
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uint16_t rasterScalar(const TIARasterState& s, uint32_t hpos, uint32_t count,
+    uint8_t* out)
+{
+  uint16_t collision = 0;
+
+  for(uint32_t end = hpos + count; hpos < end; ++hpos)
+  {
+    uint8_t enabled = (s.pf & s.pfMask[hpos]) ? PFBit : 0;
+
+    if((s.enabledObjects & BLBit) && s.blMask[hpos])
+      enabled |= BLBit;
+
+    if(s.grp1 & s.p1Mask[hpos])
+      enabled |= P1Bit;
+
+    if((s.enabledObjects & M1Bit) && s.m1Mask[hpos])
+      enabled |= M1Bit;
+
+    if(s.grp0 & s.p0Mask[hpos])
+      enabled |= P0Bit;
+
+    if((s.enabledObjects & M0Bit) && s.m0Mask[hpos])
+      enabled |= M0Bit;
+
+    collision |= s.collisionTable[enabled];
+    if(out)
+      *out++ = s.colors[s.colorIndex[hpos < 80 ? 0 : 1][enabled]];
+  }
+
+  return collision;
+}
+
+#ifdef TIA_RASTER_X86
+
+/*
+  The vector versions compute the enabled objects of 16 (SSSE3) or 32 (AVX2)
+  pixels at once.  The colour of a pixel is found with two byte shuffles:
+  the low four object bits select an entry in one of four 16-entry slices
+  of the colour index table, picked by the two high bits, and the colour
+  index selects one of the four colours.
+
+  Collisions are accumulated per pair of objects: bit i of pairs[d - 1] is
+  set if objects i and i + d were both enabled on some pixel.  Since every
+  entry of the collision table is the union of the collisions of the pairs
+  it contains, this is enough to rebuild the collision register.
+*/
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uint16_t pairCollisions(const TIARasterState& s, const uint8_t pairs[5])
+{
+  uint16_t collision = 0;
+
+  for(int d = 1; d <= 5; ++d)
+  {
+    for(int i = 0; i + d < 6; ++i)
+    {
+      if(pairs[d - 1] & (1 << i))
+        collision |= s.collisionTable[(1 << i) | (1 << (i + d))];
+    }
+  }
+
+  return collision;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+__attribute__((target("ssse3")))
+inline __m128i enabled16(const TIARasterState& s, uint32_t hpos)
+{
+  const __m128i zero = _mm_setzero_si128();
+
+  // Playfield masks are 32 bits wide; narrow the comparisons to bytes
+  const __m128i pf = _mm_set1_epi32((int)s.pf);
+  const __m128i* pfMask = (const __m128i*)(s.pfMask + hpos);
+  __m128i a = _mm_cmpeq_epi32(_mm_and_si128(_mm_loadu_si128(pfMask), pf), zero);
+  __m128i b = _mm_cmpeq_epi32(_mm_and_si128(_mm_loadu_si128(pfMask + 1), pf), zero);
+  __m128i c = _mm_cmpeq_epi32(_mm_and_si128(_mm_loadu_si128(pfMask + 2), pf), zero);
+  __m128i d = _mm_cmpeq_epi32(_mm_and_si128(_mm_loadu_si128(pfMask + 3), pf), zero);
+  __m128i pfClear = _mm_packs_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+  __m128i enabled = _mm_andnot_si128(pfClear, _mm_set1_epi8(PFBit));
+
+  __m128i p0 = _mm_and_si128(
+      _mm_loadu_si128((const __m128i*)(s.p0Mask + hpos)), _mm_set1_epi8((char)s.grp0));
+  enabled = _mm_or_si128(enabled,
+      _mm_andnot_si128(_mm_cmpeq_epi8(p0, zero), _mm_set1_epi8(P0Bit)));
+
+  __m128i p1 = _mm_and_si128(
+      _mm_loadu_si128((const __m128i*)(s.p1Mask + hpos)), _mm_set1_epi8((char)s.grp1));
+  enabled = _mm_or_si128(enabled,
+      _mm_andnot_si128(_mm_cmpeq_epi8(p1, zero), _mm_set1_epi8(P1Bit)));
+
+  if(s.enabledObjects & M0Bit)
+  {
+    __m128i m0 = _mm_loadu_si128((const __m128i*)(s.m0Mask + hpos));
+    enabled = _mm_or_si128(enabled,
+        _mm_andnot_si128(_mm_cmpeq_epi8(m0, zero), _mm_set1_epi8(M0Bit)));
+  }
+  if(s.enabledObjects & M1Bit)
+  {
+    __m128i m1 = _mm_loadu_si128((const __m128i*)(s.m1Mask + hpos));
+    enabled = _mm_or_si128(enabled,
+        _mm_andnot_si128(_mm_cmpeq_epi8(m1, zero), _mm_set1_epi8(M1Bit)));
+  }
+  if(s.enabledObjects & BLBit)
+  {
+    __m128i bl = _mm_loadu_si128((const __m128i*)(s.blMask + hpos));
+    enabled = _mm_or_si128(enabled,
+        _mm_andnot_si128(_mm_cmpeq_epi8(bl, zero), _mm_set1_epi8(BLBit)));
+  }
+
+  return enabled;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+__attribute__((target("ssse3")))
+uint32_t spanSSSE3(const TIARasterState& s, int half, uint32_t hpos,
+    uint32_t count, uint8_t* out, uint8_t pairs[5])
+{
+  const uint8_t* index = s.colorIndex[half];
+  const __m128i index0 = _mm_loadu_si128((const __m128i*)index);
+  const __m128i index1 = _mm_loadu_si128((const __m128i*)(index + 16));
+  const __m128i index2 = _mm_loadu_si128((const __m128i*)(index + 32));
+  const __m128i index3 = _mm_loadu_si128((const __m128i*)(index + 48));
+  int colors;
+  __builtin_memcpy(&colors, s.colors, 4);
+  const __m128i palette = _mm_cvtsi32_si128(colors);
+  const __m128i lowBits = _mm_set1_epi8(0x0f);
+
+  __m128i acc[5];
+  for(int d = 0; d < 5; ++d)
+    acc[d] = _mm_setzero_si128();
+
+  uint32_t done = 0;
+  for(; done + 16 <= count; done += 16)
+  {
+    __m128i enabled = enabled16(s, hpos + done);
+
+    // Bytes are shifted within 16-bit lanes, so mask off the bits coming
+    // from the neighbouring byte
+    acc[0] = _mm_or_si128(acc[0], _mm_and_si128(enabled, _mm_and_si128(
+        _mm_srli_epi16(enabled, 1), _mm_set1_epi8(0x1f))));
+    acc[1] = _mm_or_si128(acc[1], _mm_and_si128(enabled, _mm_and_si128(
+        _mm_srli_epi16(enabled, 2), _mm_set1_epi8(0x0f))));
+    acc[2] = _mm_or_si128(acc[2], _mm_and_si128(enabled, _mm_and_si128(
+        _mm_srli_epi16(enabled, 3), _mm_set1_epi8(0x07))));
+    acc[3] = _mm_or_si128(acc[3], _mm_and_si128(enabled, _mm_and_si128(
+        _mm_srli_epi16(enabled, 4), _mm_set1_epi8(0x03))));
+    acc[4] = _mm_or_si128(acc[4], _mm_and_si128(enabled, _mm_and_si128(
+        _mm_srli_epi16(enabled, 5), _mm_set1_epi8(0x01))));
+
+    if(out)
+    {
+      __m128i low = _mm_and_si128(enabled, lowBits);
+      __m128i high = _mm_and_si128(_mm_srli_epi16(enabled, 4), lowBits);
+      __m128i color = _mm_and_si128(_mm_cmpeq_epi8(high, _mm_setzero_si128()),
+          _mm_shuffle_epi8(index0, low));
+      color = _mm_or_si128(color, _mm_and_si128(
+          _mm_cmpeq_epi8(high, _mm_set1_epi8(1)), _mm_shuffle_epi8(index1, low)));
+      color = _mm_or_si128(color, _mm_and_si128(
+          _mm_cmpeq_epi8(high, _mm_set1_epi8(2)), _mm_shuffle_epi8(index2, low)));
+      color = _mm_or_si128(color, _mm_and_si128(
+          _mm_cmpeq_epi8(high, _mm_set1_epi8(3)), _mm_shuffle_epi8(index3, low)));
+      _mm_storeu_si128((__m128i*)(out + done), _mm_shuffle_epi8(palette, color));
+    }
+  }
+
+  for(int d = 0; d < 5; ++d)
+  {
+    __m128i v = _mm_or_si128(acc[d], _mm_srli_si128(acc[d], 8));
+    v = _mm_or_si128(v, _mm_srli_si128(v, 4));
+    v = _mm_or_si128(v, _mm_srli_si128(v, 2));
+    v = _mm_or_si128(v, _mm_srli_si128(v, 1));
+    pairs[d] |= (uint8_t)_mm_cvtsi128_si32(v);
+  }
+
+  return done;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+__attribute__((target("avx2")))
+inline __m256i enabled32(const TIARasterState& s, uint32_t hpos)
+{
+  const __m256i zero = _mm256_setzero_si256();
+
+  // Packing works within 128-bit lanes, so the playfield bytes come out
+  // in groups of four that need to be put back in order
+  const __m256i pf = _mm256_set1_epi32((int)s.pf);
+  const __m256i* pfMask = (const __m256i*)(s.pfMask + hpos);
+  __m256i a = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_loadu_si256(pfMask), pf), zero);
+  __m256i b = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_loadu_si256(pfMask + 1), pf), zero);
+  __m256i c = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_loadu_si256(pfMask + 2), pf), zero);
+  __m256i d = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_loadu_si256(pfMask + 3), pf), zero);
+  __m256i pfClear = _mm256_packs_epi16(_mm256_packs_epi32(a, b),
+      _mm256_packs_epi32(c, d));
+  pfClear = _mm256_permutevar8x32_epi32(pfClear,
+      _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+  __m256i enabled = _mm256_andnot_si256(pfClear, _mm256_set1_epi8(PFBit));
+
+  __m256i p0 = _mm256_and_si256(_mm256_loadu_si256((const __m256i*)(s.p0Mask + hpos)),
+      _mm256_set1_epi8((char)s.grp0));
+  enabled = _mm256_or_si256(enabled,
+      _mm256_andnot_si256(_mm256_cmpeq_epi8(p0, zero), _mm256_set1_epi8(P0Bit)));
+
+  __m256i p1 = _mm256_and_si256(_mm256_loadu_si256((const __m256i*)(s.p1Mask + hpos)),
+      _mm256_set1_epi8((char)s.grp1));
+  enabled = _mm256_or_si256(enabled,
+      _mm256_andnot_si256(_mm256_cmpeq_epi8(p1, zero), _mm256_set1_epi8(P1Bit)));
+
+  if(s.enabledObjects & M0Bit)
+  {
+    __m256i m0 = _mm256_loadu_si256((const __m256i*)(s.m0Mask + hpos));
+    enabled = _mm256_or_si256(enabled,
+        _mm256_andnot_si256(_mm256_cmpeq_epi8(m0, zero), _mm256_set1_epi8(M0Bit)));
+  }
+  if(s.enabledObjects & M1Bit)
+  {
+    __m256i m1 = _mm256_loadu_si256((const __m256i*)(s.m1Mask + hpos));
+    enabled = _mm256_or_si256(enabled,
+        _mm256_andnot_si256(_mm256_cmpeq_epi8(m1, zero), _mm256_set1_epi8(M1Bit)));
+  }
+  if(s.enabledObjects & BLBit)
+  {
+    __m256i bl = _mm256_loadu_si256((const __m256i*)(s.blMask + hpos));
+    enabled = _mm256_or_si256(enabled,
+        _mm256_andnot_si256(_mm256_cmpeq_epi8(bl, zero), _mm256_set1_epi8(BLBit)));
+  }
+
+  return enabled;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+__attribute__((target("avx2")))
+uint32_t spanAVX2(const TIARasterState& s, int half, uint32_t hpos,
+    uint32_t count, uint8_t* out, uint8_t pairs[5])
+{
+  const uint8_t* index = s.colorIndex[half];
+  const __m256i index0 = _mm256_broadcastsi128_si256(
+      _mm_loadu_si128((const __m128i*)index));
+  const __m256i index1 = _mm256_broadcastsi128_si256(
+      _mm_loadu_si128((const __m128i*)(index + 16)));
+  const __m256i index2 = _mm256_broadcastsi128_si256(
+      _mm_loadu_si128((const __m128i*)(index + 32)));
+  const __m256i index3 = _mm256_broadcastsi128_si256(
+      _mm_loadu_si128((const __m128i*)(index + 48)));
+  int colors;
+  __builtin_memcpy(&colors, s.colors, 4);
+  const __m256i palette = _mm256_set1_epi32(colors);
+  const __m256i lowBits = _mm256_set1_epi8(0x0f);
+
+  __m256i acc[5];
+  for(int d = 0; d < 5; ++d)
+    acc[d] = _mm256_setzero_si256();
+
+  uint32_t done = 0;
+  for(; done + 32 <= count; done += 32)
+  {
+    __m256i enabled = enabled32(s, hpos + done);
+
+    acc[0] = _mm256_or_si256(acc[0], _mm256_and_si256(enabled, _mm256_and_si256(
+        _mm256_srli_epi16(enabled, 1), _mm256_set1_epi8(0x1f))));
+    acc[1] = _mm256_or_si256(acc[1], _mm256_and_si256(enabled, _mm256_and_si256(
+        _mm256_srli_epi16(enabled, 2), _mm256_set1_epi8(0x0f))));
+    acc[2] = _mm256_or_si256(acc[2], _mm256_and_si256(enabled, _mm256_and_si256(
+        _mm256_srli_epi16(enabled, 3), _mm256_set1_epi8(0x07))));
+    acc[3] = _mm256_or_si256(acc[3], _mm256_and_si256(enabled, _mm256_and_si256(
+        _mm256_srli_epi16(enabled, 4), _mm256_set1_epi8(0x03))));
+    acc[4] = _mm256_or_si256(acc[4], _mm256_and_si256(enabled, _mm256_and_si256(
+        _mm256_srli_epi16(enabled, 5), _mm256_set1_epi8(0x01))));
+
+    if(out)
+    {
+      __m256i low = _mm256_and_si256(enabled, lowBits);
+      __m256i high = _mm256_and_si256(_mm256_srli_epi16(enabled, 4), lowBits);
+      __m256i color = _mm256_and_si256(
+          _mm256_cmpeq_epi8(high, _mm256_setzero_si256()),
+          _mm256_shuffle_epi8(index0, low));
+      color = _mm256_or_si256(color, _mm256_and_si256(
+          _mm256_cmpeq_epi8(high, _mm256_set1_epi8(1)),
+          _mm256_shuffle_epi8(index1, low)));
+      color = _mm256_or_si256(color, _mm256_and_si256(
+          _mm256_cmpeq_epi8(high, _mm256_set1_epi8(2)),
+          _mm256_shuffle_epi8(index2, low)));
+      color = _mm256_or_si256(color, _mm256_and_si256(
+          _mm256_cmpeq_epi8(high, _mm256_set1_epi8(3)),
+          _mm256_shuffle_epi8(index3, low)));
+      _mm256_storeu_si256((__m256i*)(out + done),
+          _mm256_shuffle_epi8(palette, color));
+    }
+  }
+
+  for(int d = 0; d < 5; ++d)
+  {
+    __m128i v = _mm_or_si128(_mm256_castsi256_si128(acc[d]),
+        _mm256_extracti128_si256(acc[d], 1));
+    v = _mm_or_si128(v, _mm_srli_si128(v, 8));
+    v = _mm_or_si128(v, _mm_srli_si128(v, 4));
+    v = _mm_or_si128(v, _mm_srli_si128(v, 2));
+    v = _mm_or_si128(v, _mm_srli_si128(v, 1));
+    pairs[d] |= (uint8_t)_mm_cvtsi128_si32(v);
+  }
+
+  // Leave what is left to the 16 pixel version
+  return done + spanSSSE3(s, half, hpos + done, count - done,
+      out ? out + done : out, pairs);
+}
+
+typedef uint32_t (*SpanFunction)(const TIARasterState& s, int half,
+    uint32_t hpos, uint32_t count, uint8_t* out, uint8_t pairs[5]);
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<SpanFunction span>
+uint16_t rasterVector(const TIARasterState& s, uint32_t hpos, uint32_t count,
+    uint8_t* out)
+{
+  uint8_t pairs[5] = { 0, 0, 0, 0, 0 };
+  uint16_t collision = 0;
+
+  // The two halves of the screen use different colour index tables
+  const uint32_t end = hpos + count;
+  while(hpos < end)
+  {
+    const int half = (hpos < 80) ? 0 : 1;
+    const uint32_t stop = (half == 0 && end > 80) ? 80 : end;
+
+    uint32_t done = span(s, half, hpos, stop - hpos, out, pairs);
+    collision |= rasterScalar(s, hpos + done, stop - hpos - done,
+        out ? out + done : out);
+
+    if(out)
+      out += stop - hpos;
+    hpos = stop;
+  }
+
+  return collision | pairCollisions(s, pairs);
+}
+
+#endif  // TIA_RASTER_X86
+
+}  // namespace
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TIARasterizer tiaRasterizer()
+{
+#ifdef TIA_RASTER_X86
+  __builtin_cpu_init();
+  if(__builtin_cpu_supports("avx2"))
+    return &rasterVector<spanAVX2>;
+  if(__builtin_cpu_supports("ssse3"))
+    return &rasterVector<spanSSSE3>;
+#endif
+  return &rasterScalar;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TIARasterizer tiaScalarRasterizer()
+{
+  return &rasterScalar;
+}
+
+}  // namespace stella
+}  // namespace ale
@@ -0,0 +1,83 @@
+/******************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2013 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details.
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ *  TIARaster.hxx
+ *
+ *  Generic scanline rasterizer used by the TIA when several objects are
+ *  drawn on the same stretch of a scanline, with SSSE3 and AVX2 versions
+ *  selected at run time.
+ **************************************************************************** */
+
+#ifndef TIA_RASTER_HXX
+#define TIA_RASTER_HXX
+
+#include <cstdint>
+
+namespace ale {
+namespace stella {
+
+/**
+  The TIA state needed to draw a stretch of a scanline.  The masks are
+  indexed by horizontal position (0 to 159), as in the TIA.
+*/
+struct TIARasterState
+{
+  // Playfield masks and register
+  const uint32_t* pfMask;
+  uint32_t pf;
+
+  // Player masks and graphics
+  const uint8_t* p0Mask;
+  const uint8_t* p1Mask;
+  uint8_t grp0;
+  uint8_t grp1;
+
+  // Missile and ball masks, only used if enabled in enabledObjects
+  const uint8_t* m0Mask;
+  const uint8_t* m1Mask;
+  const uint8_t* blMask;
+  uint8_t enabledObjects;
+
+  // Colour index of each combination of objects in the left and right
+  // halves of the screen, i.e. the TIA's priority encoder offset by the
+  // playfield priority and score bits.  Only the first 64 entries are used.
+  const uint8_t* colorIndex[2];
+
+  // Background, playfield, player 0 and player 1 colours
+  uint8_t colors[4];
+
+  // Collision bits of each combination of objects
+  const uint16_t* collisionTable;
+};
+
+/**
+  Draws the pixels [hpos, hpos + count) of the current scanline into out
+  and answers the collision register bits they set.  If out is the null
+  pointer only the collisions are computed.  hpos + count must not exceed
+  160.
+*/
+typedef uint16_t (*TIARasterizer)(const TIARasterState& state,
+    uint32_t hpos, uint32_t count, uint8_t* out);
+
+/**
+  Answer the fastest rasterizer supported by the CPU we are running on.
+  All of them produce identical pixels and collisions.
+*/
+TIARasterizer tiaRasterizer();
+
+/**
+  Answer the portable one-pixel-at-a-time rasterizer.
+*/
+TIARasterizer tiaScalarRasterizer();
+
+}  // namespace stella
+}  // namespace ale
+
+#endif
@@ -12,6 +12,7 @@
 
 #include "ale/environment/ale_state.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <sstream>
@@ -29,10 +30,23 @@
 namespace ale {
 using namespace stella;   // System, Event, Deserializer, Serializer, Random
 
+namespace {
+
+// Serialized states start with this tag and a format version. The tag
+// ("ALES") cannot be mistaken for the left paddle resistance that states of
+// earlier versions start with. Bump the version whenever the layout below,
+// or the state saved by any device, RomSettings or the RNG, changes.
+constexpr int kStateTag = 0x53454C41;
+constexpr int kStateVersion = 1;
+
+}  // namespace
+
 /** Default constructor - loads settings from system */
 ALEState::ALEState()
     : m_left_paddle(PADDLE_DEFAULT_VALUE),
       m_right_paddle(PADDLE_DEFAULT_VALUE),
+      m_paddle_c(PADDLE_DEFAULT_VALUE),
+      m_paddle_d(PADDLE_DEFAULT_VALUE),
       m_paddle_min(PADDLE_MIN),
       m_paddle_max(PADDLE_MAX),
       m_frame_number(0),
@@ -43,6 +57,8 @@ ALEState::ALEState()
 ALEState::ALEState(const ALEState& rhs, const std::string& serialized)
     : m_left_paddle(rhs.m_left_paddle),
       m_right_paddle(rhs.m_right_paddle),
+      m_paddle_c(rhs.m_paddle_c),
+      m_paddle_d(rhs.m_paddle_d),
       m_paddle_min(rhs.m_paddle_min),
       m_paddle_max(rhs.m_paddle_max),
       m_frame_number(rhs.m_frame_number),
@@ -53,6 +69,17 @@ ALEState::ALEState(const ALEState& rhs, const std::string& serialized)
 
 ALEState::ALEState(const std::string& serialized) {
   Deserializer des(serialized);
+  if (serialized.size() < 8 || des.getInt() != kStateTag) {
+    throw std::runtime_error(
+        "Cannot restore a state serialized by an earlier version of ALE");
+  }
+  const int version = des.getInt();
+  if (version != kStateVersion) {
+    throw std::runtime_error("Cannot restore a state serialized with format "
+                             "version " + std::to_string(version) +
+                             ", this version of ALE reads version " +
+                             std::to_string(kStateVersion));
+  }
   this->m_left_paddle = des.getInt();
   this->m_right_paddle = des.getInt();
   this->m_frame_number = des.getInt();
@@ -62,6 +89,8 @@ ALEState::ALEState(const std::string& serialized) {
   this->m_serialized_state = des.getString();
   this->m_paddle_min = des.getInt();
   this->m_paddle_max = des.getInt();
+  this->m_paddle_c = des.getInt();
+  this->m_paddle_d = des.getInt();
 }
 
 /** Restores ALE to the given previously saved state. */
@@ -82,6 +111,8 @@ void ALEState::load(OSystem* osystem, RomSettings* settings, Random* rng, std::s
   // Copy over other member variables
   m_left_paddle = rhs.m_left_paddle;
   m_right_paddle = rhs.m_right_paddle;
+  m_paddle_c = rhs.m_paddle_c;
+  m_paddle_d = rhs.m_paddle_d;
   m_paddle_min = rhs.m_paddle_min;
   m_paddle_max = rhs.m_paddle_max;
   m_frame_number = rhs.m_frame_number;
@@ -113,9 +144,16 @@ void ALEState::incrementFrame(int steps /* = 1 */) {
 
 void ALEState::resetEpisodeFrameNumber() { m_episode_frame_number = 0; }
 
+void ALEState::setFrameNumbers(int frame_number, int episode_frame_number) {
+  m_frame_number = frame_number;
+  m_episode_frame_number = episode_frame_number;
+}
+
 std::string ALEState::serialize() {
   Serializer ser;
 
+  ser.putInt(kStateTag);
+  ser.putInt(kStateVersion);
   ser.putInt(this->m_left_paddle);
   ser.putInt(this->m_right_paddle);
   ser.putInt(this->m_frame_number);
@@ -125,6 +163,8 @@ std::string ALEState::serialize() {
   ser.putString(this->m_serialized_state);
   ser.putInt(this->m_paddle_min);
   ser.putInt(this->m_paddle_max);
+  ser.putInt(this->m_paddle_c);
+  ser.putInt(this->m_paddle_d);
 
   return ser.get_str();
 }
@@ -139,6 +179,14 @@ int ALEState::calcPaddleResistance(int x_val) {
 void ALEState::resetPaddles(Event* event) {
   int paddle_default = (m_paddle_min + m_paddle_max) / 2;
   setPaddles(event, paddle_default, paddle_default);
+
+  // The right port's paddles stay disconnected (zero resistance) until
+  // players C and D act, so that games played by one or two players see the
+  // same inputs as before they could be connected.
+  m_paddle_c = paddle_default;
+  m_paddle_d = paddle_default;
+  event->set(Event::PaddleTwoResistance, 0);
+  event->set(Event::PaddleThreeResistance, 0);
 }
 
 void ALEState::setPaddles(Event* event, int left, int right) {
@@ -189,23 +237,19 @@ void ALEState::updatePaddlePositions(Event* event, int delta_left,
   setPaddles(event, m_left_paddle, m_right_paddle);
 }
 
-void ALEState::applyActionPaddles(Event* event,
-                                  int player_a_action, float paddle_a_strength,
-                                  int player_b_action, float paddle_b_strength) {
-  // Reset keys
-  resetKeys(event);
+namespace {
 
-  int delta_a = 0;
-  int delta_b = 0;
-  switch (player_a_action) {
+// The paddle movement for an action in player A's action set. Right turns
+// the paddle clockwise, which lowers its resistance.
+int paddleDelta(int action, float strength) {
+  switch (action) {
     case PLAYER_A_RIGHT:
     case PLAYER_A_RIGHTFIRE:
     case PLAYER_A_UPRIGHT:
     case PLAYER_A_DOWNRIGHT:
     case PLAYER_A_UPRIGHTFIRE:
     case PLAYER_A_DOWNRIGHTFIRE:
-      delta_a = static_cast<int>(-PADDLE_DELTA * fabs(paddle_a_strength));
-      break;
+      return static_cast<int>(-PADDLE_DELTA * fabs(strength));
 
     case PLAYER_A_LEFT:
     case PLAYER_A_LEFTFIRE:
@@ -213,45 +257,16 @@ void ALEState::applyActionPaddles(Event* event,
     case PLAYER_A_DOWNLEFT:
     case PLAYER_A_UPLEFTFIRE:
     case PLAYER_A_DOWNLEFTFIRE:
-      delta_a = static_cast<int>(PADDLE_DELTA * fabs(paddle_a_strength));
-      break;
-
-    default:
-      break;
-  }
-
-  switch (player_b_action) {
-    case PLAYER_B_RIGHT:
-    case PLAYER_B_RIGHTFIRE:
-    case PLAYER_B_UPRIGHT:
-    case PLAYER_B_DOWNRIGHT:
-    case PLAYER_B_UPRIGHTFIRE:
-    case PLAYER_B_DOWNRIGHTFIRE:
-      delta_b = static_cast<int>(-PADDLE_DELTA * fabs(paddle_b_strength));
-      break;
-
-    case PLAYER_B_LEFT:
-    case PLAYER_B_LEFTFIRE:
-    case PLAYER_B_UPLEFT:
-    case PLAYER_B_DOWNLEFT:
-    case PLAYER_B_UPLEFTFIRE:
-    case PLAYER_B_DOWNLEFTFIRE:
-      delta_b = static_cast<int>(PADDLE_DELTA * fabs(paddle_b_strength));
-      break;
+      return static_cast<int>(PADDLE_DELTA * fabs(strength));
 
     default:
-      break;
+      return 0;
   }
+}
 
-  // Now update the paddle positions
-  updatePaddlePositions(event, delta_a, delta_b);
-
-  // Handle reset
-  if (player_a_action == RESET || player_b_action == RESET)
-    event->set(Event::ConsoleReset, 1);
-
-  // Now add the fire event
-  switch (player_a_action) {
+// Whether an action in player A's action set presses the fire button.
+bool isFireAction(int action) {
+  switch (action) {
     case PLAYER_A_FIRE:
     case PLAYER_A_UPFIRE:
     case PLAYER_A_RIGHTFIRE:
@@ -261,29 +276,50 @@ void ALEState::applyActionPaddles(Event* event,
     case PLAYER_A_UPLEFTFIRE:
     case PLAYER_A_DOWNRIGHTFIRE:
     case PLAYER_A_DOWNLEFTFIRE:
-      event->set(Event::PaddleZeroFire, 1);
-      break;
+      return true;
     default:
-      // Nothing
-      break;
+      return false;
   }
+}
 
-  switch (player_b_action) {
-    case PLAYER_B_FIRE:
-    case PLAYER_B_UPFIRE:
-    case PLAYER_B_RIGHTFIRE:
-    case PLAYER_B_LEFTFIRE:
-    case PLAYER_B_DOWNFIRE:
-    case PLAYER_B_UPRIGHTFIRE:
-    case PLAYER_B_UPLEFTFIRE:
-    case PLAYER_B_DOWNRIGHTFIRE:
-    case PLAYER_B_DOWNLEFTFIRE:
-      event->set(Event::PaddleOneFire, 1);
-      break;
-    default:
-      // Nothing
-      break;
-  }
+}  // namespace
+
+void ALEState::applyActionPaddles(Event* event,
+                                  int player_a_action, float paddle_a_strength,
+                                  int player_b_action, float paddle_b_strength) {
+  // Reset keys
+  resetKeys(event);
+
+  // Player B's actions are offset by PLAYER_B_NOOP
+  int delta_a = paddleDelta(player_a_action, paddle_a_strength);
+  int delta_b = paddleDelta(player_b_action - PLAYER_B_NOOP, paddle_b_strength);
+
+  // Now update the paddle positions
+  updatePaddlePositions(event, delta_a, delta_b);
+
+  // Handle reset
+  if (player_a_action == RESET || player_b_action == RESET)
+    event->set(Event::ConsoleReset, 1);
+
+  // Now add the fire event
+  if (isFireAction(player_a_action))
+    event->set(Event::PaddleZeroFire, 1);
+  if (isFireAction(player_b_action - PLAYER_B_NOOP))
+    event->set(Event::PaddleOneFire, 1);
+}
+
+void ALEState::applyActionRightPaddles(Event* event,
+                                       int player_c_action, float paddle_c_strength,
+                                       int player_d_action, float paddle_d_strength) {
+  m_paddle_c = std::clamp(m_paddle_c + paddleDelta(player_c_action, paddle_c_strength),
+                          m_paddle_min, m_paddle_max);
+  m_paddle_d = std::clamp(m_paddle_d + paddleDelta(player_d_action, paddle_d_strength),
+                          m_paddle_min, m_paddle_max);
+  event->set(Event::PaddleTwoResistance, calcPaddleResistance(m_paddle_c));
+  event->set(Event::PaddleThreeResistance, calcPaddleResistance(m_paddle_d));
+
+  event->set(Event::PaddleTwoFire, isFireAction(player_c_action));
+  event->set(Event::PaddleThreeFire, isFireAction(player_d_action));
 }
 
 void ALEState::pressSelect(Event* event) {
@@ -483,6 +519,8 @@ void ALEState::resetKeys(Event* event) {
   // also reset paddle fire
   event->set(Event::PaddleZeroFire, 0);
   event->set(Event::PaddleOneFire, 0);
+  event->set(Event::PaddleTwoFire, 0);
+  event->set(Event::PaddleThreeFire, 0);
 
   // Set the difficulty switches accordingly for this time step.
   setDifficultySwitches(event, m_difficulty);
@@ -492,6 +530,8 @@ bool ALEState::equals(ALEState& rhs) {
   return (rhs.m_serialized_state == this->m_serialized_state &&
           rhs.m_left_paddle == this->m_left_paddle &&
           rhs.m_right_paddle == this->m_right_paddle &&
+          rhs.m_paddle_c == this->m_paddle_c &&
+          rhs.m_paddle_d == this->m_paddle_d &&
           rhs.m_frame_number == this->m_frame_number &&
           rhs.m_episode_frame_number == this->m_episode_frame_number &&
           rhs.m_mode == this->m_mode && rhs.m_difficulty == this->m_difficulty);
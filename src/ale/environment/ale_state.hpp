@@ -45,7 +45,8 @@ class ALEState {
   // Makes a copy of this state, also storing emulator information provided as a string
   ALEState(const ALEState& rhs, const std::string& serialized);
 
-  // Restores a serialized ALEState
+  // Restores a serialized ALEState. Throws std::runtime_error if it was
+  // serialized by another version of the state format.
   ALEState(const std::string& serialized);
 
   /** Resets the system to its start state. numResetSteps 'RESET' actions are taken after the
@@ -66,6 +67,13 @@ class ALEState {
                           int player_a_action, float paddle_a_strength,
                           int player_b_action, float paddle_b_strength);
 
+  /** Applies the paddle actions of players C and D, given in player A's
+   *  action set, to the paddles of the right controller port. Must follow
+   *  applyActionPaddles(), which releases the fire buttons. */
+  void applyActionRightPaddles(stella::Event* event,
+                               int player_c_action, float paddle_c_strength,
+                               int player_d_action, float paddle_d_strength);
+
   /** Sets the joystick events. No effect until the emulator is run forward. */
   void applyActionJoysticks(stella::Event* event,
                             int player_a_action, int player_b_action);
@@ -74,12 +82,21 @@ class ALEState {
 
   void resetEpisodeFrameNumber();
 
+  // Overrides both frame counters, e.g. after loading a state recorded earlier.
+  void setFrameNumbers(int frame_number, int episode_frame_number);
+
   //Get the frames executed so far
   int getFrameNumber() const { return m_frame_number; }
 
   //Get the number of frames executed this episode.
   int getEpisodeFrameNumber() const { return m_episode_frame_number; }
 
+  // Returns the current paddle resistances.
+  int getLeftPaddle() const { return m_left_paddle; }
+  int getRightPaddle() const { return m_right_paddle; }
+  int getPaddleC() const { return m_paddle_c; }
+  int getPaddleD() const { return m_paddle_d; }
+
   /** set the difficulty according to the value.
    *  If the first bit is 1, then it will put the left difficulty switch to A (otherwise leave it on B)
    *  If the second bit is 1, then it will put the right difficulty switch to A (otherwise leave it on B)
@@ -131,6 +148,8 @@ class ALEState {
  private:
   int m_left_paddle;               // Current value for the left-paddle
   int m_right_paddle;              // Current value for the right-paddle
+  int m_paddle_c;                  // Current value for player C's paddle
+  int m_paddle_d;                  // Current value for player D's paddle
 
   int m_paddle_min;                // Minimum value for paddle
   int m_paddle_max;                // Maximum value for paddle
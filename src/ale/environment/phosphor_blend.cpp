@@ -16,40 +16,101 @@
 
 #include "ale/environment/phosphor_blend.hpp"
 
+#include <map>
+#include <mutex>
+#include <vector>
+
 #include "ale/emucore/Console.hxx"
+#include "ale/emucore/MediaSrc.hxx"
 
 namespace ale {
 using namespace stella;   // OSystem
 
-PhosphorBlend::PhosphorBlend(OSystem* osystem) : m_osystem(osystem) {
-  // Taken from default Stella settings
-  m_phosphor_blend_ratio = 77;
+// Taken from default Stella settings
+static const uint32_t PHOSPHOR_BLEND_RATIO = 77;
 
-  makeAveragePalette();
-}
+PhosphorBlend::PhosphorBlend(OSystem* osystem)
+    : m_osystem(osystem), m_generation(0) {}
 
 void PhosphorBlend::process(ALEScreen& screen) {
   Console& console = m_osystem->console();
 
+  if (!m_tables) {
+    m_tables = sharedTables(m_osystem->colourPalette());
+  }
+  const Tables& tables = *m_tables;
+
   // Fetch current and previous frame buffers from the emulator
-  uint8_t* current_buffer = console.mediaSource().currentFrameBuffer();
-  uint8_t* previous_buffer = console.mediaSource().previousFrameBuffer();
+  MediaSource& media = console.mediaSource();
+  uint8_t* current_buffer = media.currentFrameBuffer();
+  uint8_t* previous_buffer = media.previousFrameBuffer();
+  const uint64_t* generations = media.scanlineGenerations();
+
+  // Process each pixel of the scanlines that changed in either buffer since
+  // the last call; a scanline that changed in the generation blended last
+  // still differs in the previous buffer now
+  const size_t width = screen.width();
+  for (size_t row = 0; row < screen.height(); row++) {
+    if (generations[row] < m_generation) {
+      continue;
+    }
+    for (size_t i = row * width; i < (row + 1) * width; i++) {
+      int cv = current_buffer[i];
+      int pv = previous_buffer[i];
+
+      // Find out the corresponding rgb color
+      uint32_t rgb = tables.avg_palette[cv][pv];
+
+      // Set the corresponding pixel in the array
+      screen.getArray()[i] = rgbToNTSC(tables, rgb);
+    }
+  }
+  m_generation = media.frameGeneration();
+}
+
+// Tables are kept while some environment uses them, keyed by the even
+// (colour) palette entries, which are the only ones they read
+struct PhosphorBlend::TableCache {
+  std::mutex mutex;
+  std::map<std::vector<uint32_t>, std::weak_ptr<const Tables>> tables;
+};
+
+PhosphorBlend::TableCache& PhosphorBlend::tableCache() {
+  static TableCache cache;
+  return cache;
+}
 
-  // Process each pixel in turn
-  for (size_t i = 0; i < screen.arraySize(); i++) {
-    int cv = current_buffer[i];
-    int pv = previous_buffer[i];
+size_t PhosphorBlend::tablesInUse() {
+  TableCache& cache = tableCache();
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  size_t count = 0;
+  for (const auto& entry : cache.tables) {
+    count += !entry.second.expired();
+  }
+  return count;
+}
 
-    // Find out the corresponding rgb color
-    uint32_t rgb = m_avg_palette[cv][pv];
+std::shared_ptr<const PhosphorBlend::Tables> PhosphorBlend::sharedTables(
+    const ColourPalette& palette) {
+  std::vector<uint32_t> key;
+  for (int c = 0; c < 256; c += 2) {
+    key.push_back(palette.getRGB(c));
+  }
 
-    // Set the corresponding pixel in the array
-    screen.getArray()[i] = rgbToNTSC(rgb);
+  TableCache& cache = tableCache();
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  std::shared_ptr<const Tables> tables = cache.tables[key].lock();
+  if (!tables) {
+    std::shared_ptr<Tables> built = std::make_shared<Tables>();
+    makeAveragePalette(palette, *built);
+    tables = built;
+    cache.tables[key] = tables;
   }
+  return tables;
 }
-void PhosphorBlend::makeAveragePalette() {
-  ColourPalette& palette = m_osystem->colourPalette();
 
+void PhosphorBlend::makeAveragePalette(const ColourPalette& palette,
+                                       Tables& tables) {
   // Precompute the average RGB values for phosphor-averaged colors c1 and c2.
   for (int c1 = 0; c1 < 256; c1 += 2) {
     for (int c2 = 0; c2 < 256; c2 += 2) {
@@ -61,7 +122,7 @@ void PhosphorBlend::makeAveragePalette() {
       uint8_t r = getPhosphor(r1, r2);
       uint8_t g = getPhosphor(g1, g2);
       uint8_t b = getPhosphor(b1, b2);
-      m_avg_palette[c1][c2] = makeRGB(r, g, b);
+      tables.avg_palette[c1][c2] = makeRGB(r, g, b);
     }
   }
 
@@ -88,7 +149,7 @@ void PhosphorBlend::makeAveragePalette() {
           }
         }
 
-        m_rgb_ntsc[r >> 2][g >> 2][b >> 2] = minIndex;
+        tables.rgb_ntsc[r >> 2][g >> 2][b >> 2] = minIndex;
       }
     }
   }
@@ -101,7 +162,7 @@ uint8_t PhosphorBlend::getPhosphor(uint8_t v1, uint8_t v2) {
     v2 = tmp;
   }
 
-  uint32_t blendedValue = ((v1 - v2) * m_phosphor_blend_ratio) / 100 + v2;
+  uint32_t blendedValue = ((v1 - v2) * PHOSPHOR_BLEND_RATIO) / 100 + v2;
   if (blendedValue > 255)
     return 255;
   else
@@ -113,12 +174,12 @@ uint32_t PhosphorBlend::makeRGB(uint8_t r, uint8_t g, uint8_t b) {
 }
 
 /** Converts a RGB value to an 8-bit format */
-uint8_t PhosphorBlend::rgbToNTSC(uint32_t rgb) {
+uint8_t PhosphorBlend::rgbToNTSC(const Tables& tables, uint32_t rgb) {
   int r = (rgb >> 16) & 0xFF;
   int g = (rgb >> 8) & 0xFF;
   int b = rgb & 0xFF;
 
-  return m_rgb_ntsc[r >> 2][g >> 2][b >> 2];
+  return tables.rgb_ntsc[r >> 2][g >> 2][b >> 2];
 }
 
 }  // namespace ale
@@ -17,6 +17,9 @@
 #ifndef __PHOSPHOR_BLEND_HPP__
 #define __PHOSPHOR_BLEND_HPP__
 
+#include <cstddef>
+#include <memory>
+
 #include "ale/emucore/OSystem.hxx"
 #include "ale/environment/ale_screen.hpp"
 
@@ -26,22 +29,42 @@ class PhosphorBlend {
  public:
   PhosphorBlend(stella::OSystem*);
 
+  /** Blends the current and previous frames into the given screen, which
+   *  must hold the result of the previous call, if any. */
   void process(ALEScreen& screen);
 
+  /** Returns how many sets of lookup tables are in use, which is one per
+   *  distinct palette of the environments that have blended a frame. */
+  static size_t tablesInUse();
+
  private:
-  void makeAveragePalette();
-  uint8_t getPhosphor(uint8_t v1, uint8_t v2);
-  uint32_t makeRGB(uint8_t r, uint8_t g, uint8_t b);
+  /** Lookup tables, which only depend on the colour palette. They take
+   *  512 KB, so they are built on first use and shared by every
+   *  environment using the same palette. */
+  struct Tables {
+    uint8_t rgb_ntsc[64][64][64];
+    uint32_t avg_palette[256][256];
+  };
+
+  struct TableCache;
+  static TableCache& tableCache();
+  static std::shared_ptr<const Tables> sharedTables(
+      const ColourPalette& palette);
+  static void makeAveragePalette(const ColourPalette& palette,
+                                 Tables& tables);
+  static uint8_t getPhosphor(uint8_t v1, uint8_t v2);
+  static uint32_t makeRGB(uint8_t r, uint8_t g, uint8_t b);
   /** Converts a RGB value to an 8-bit format */
-  uint8_t rgbToNTSC(uint32_t rgb);
+  static uint8_t rgbToNTSC(const Tables& tables, uint32_t rgb);
 
  private:
   stella::OSystem* m_osystem;
 
-  uint8_t m_rgb_ntsc[64][64][64];
+  std::shared_ptr<const Tables> m_tables;  // Null until the first frame
 
-  uint32_t m_avg_palette[256][256];
-  uint8_t m_phosphor_blend_ratio;
+  // Frame generation blended by the last call; only the scanlines that
+  // changed since then are blended again
+  uint64_t m_generation;
 };
 
 }  // namespace ale
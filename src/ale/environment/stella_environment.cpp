@@ -18,14 +18,30 @@
 #include "ale/environment/stella_environment.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <sstream>
 #include <cstring>
 #include <optional>
+#include <stdexcept>
+#include <string>
 
+#include "ale/emucore/M6502.hxx"
+#include "ale/emucore/Serializer.hxx"
+#include "ale/emucore/Deserializer.hxx"
 #include "ale/emucore/System.hxx"
+#include "ale/common/StateHash.hpp"
 
 namespace ale {
-using namespace stella;   // OSystem, Random
+using namespace stella;   // OSystem, Random, Serializer, Deserializer
+
+/** An observation generation is an id unique to the environment in the high
+ *  32 bits and a count of the environment's own updates in the low 32 bits.
+ *  Environments only draw from this shared counter when they are created or
+ *  their count runs out, and a generation is never reused in the process. */
+static uint64_t firstObservationGeneration() {
+  static std::atomic<uint64_t> next_id(0);
+  return ++next_id << 32;
+}
 
 StellaEnvironment::StellaEnvironment(OSystem* osystem, RomSettings* settings)
     : m_osystem(osystem),
@@ -33,11 +49,18 @@ StellaEnvironment::StellaEnvironment(OSystem* osystem, RomSettings* settings)
       m_phosphor_blend(osystem),
       m_screen(m_osystem->console().mediaSource().height(),
                m_osystem->console().mediaSource().width()),
-      m_player_a_action(PLAYER_A_NOOP),
-      m_player_b_action(PLAYER_B_NOOP) {
+      m_sound_capture(dynamic_cast<SoundCapture*>(&osystem->sound())),
+      m_screen_generation(0),
+      m_observation_generation(firstObservationGeneration()),
+      m_in_rollout(false) {
+  resetPlayerActions();
+  std::fill(m_paddle_strengths, m_paddle_strengths + MAX_PLAYERS, 1.0f);
+
   // Determine whether this is a paddle-based game
+  m_right_paddles =
+      m_osystem->console().properties().get(Controller_Right) == "PADDLES";
   if (m_osystem->console().properties().get(Controller_Left) == "PADDLES" ||
-      m_osystem->console().properties().get(Controller_Right) == "PADDLES") {
+      m_right_paddles) {
     m_use_paddles = true;
     int paddle_min_val = m_osystem->settings().getInt("paddle_min");
     int paddle_max_val = m_osystem->settings().getInt("paddle_max");
@@ -69,6 +92,9 @@ StellaEnvironment::StellaEnvironment(OSystem* osystem, RomSettings* settings)
       m_osystem->settings().getInt("max_num_frames_per_episode");
   m_max_lives = m_settings->lives();
   m_truncate_on_loss_of_life = m_osystem->settings().getBool("truncate_on_loss_of_life");
+  m_use_reset_cache = m_osystem->settings().getBool("reset_cache");
+  m_noop_max = m_osystem->settings().getInt("noop_max");
+  m_num_start_states = std::max(0, m_osystem->settings().getInt("num_start_states"));
   m_colour_averaging = m_osystem->settings().getBool("color_averaging");
 
   m_reward_min = m_osystem->settings().getInt("reward_min");
@@ -92,10 +118,50 @@ StellaEnvironment::StellaEnvironment(OSystem* osystem, RomSettings* settings)
     m_screen_exporter.reset(
         new ScreenExporter(m_osystem->colourPalette(), recordDir));
   }
+
+  if (m_sound_capture != nullptr) {
+    m_audio.assign(m_sound_capture->samples(),
+                   m_sound_capture->samples() + m_sound_capture->size());
+  }
+
+  // Without a display, sound playback or screen recording, act() runs the
+  // frames without calling the per-frame hooks at all
+  m_headless = (m_osystem->sound().isNull() || m_sound_capture != nullptr) &&
+               m_osystem->screen().isNull() && m_screen_exporter == nullptr;
 }
 
 /** Resets the system to its start state. */
 void StellaEnvironment::reset() {
+  ALE_PERF_SCOPE(m_osystem->perfStats().reset_ns);
+
+  if (m_num_start_states == 0) {
+    resetEmulator();
+    noopStart();
+    return;
+  }
+
+  // Fill the bank lazily, one fresh start state per reset, then sample from it
+  std::vector<ResetSnapshot>& bank = m_start_states[snapshotKey()];
+  if (bank.size() < m_num_start_states) {
+    uint64_t rng_draws = m_osystem->console().system().rng().draws();
+    resetEmulator();
+    noopStart();
+    bank.push_back(takeSnapshot(rng_draws));
+  } else {
+    restoreSnapshot(bank[m_random.next() % bank.size()]);
+  }
+}
+
+void StellaEnvironment::resetEmulator() {
+  uint64_t rng_draws = m_osystem->console().system().rng().draws();
+  if (m_use_reset_cache) {
+    auto it = m_reset_cache.find(snapshotKey());
+    if (it != m_reset_cache.end()) {
+      restoreSnapshot(it->second);
+      return;
+    }
+  }
+
   m_state.resetEpisodeFrameNumber();
   // Reset the paddles
   m_state.resetPaddles(m_osystem->event());
@@ -103,7 +169,8 @@ void StellaEnvironment::reset() {
   // Reset the emulator
   m_osystem->console().system().reset();
 
-  // NOOP for 60 steps in the deterministic environment setting, or some random amount otherwise
+  // NOOP for 60 steps in the deterministic environment setting; random starts
+  // are added afterwards by noopStart()
   int noopSteps;
   noopSteps = 60;
 
@@ -124,6 +191,81 @@ void StellaEnvironment::reset() {
   for (size_t i = 0; i < startingActions.size(); i++) {
     emulate(startingActions[i], PLAYER_B_NOOP, 1.0, 1.0);
   }
+
+  if (m_use_reset_cache) {
+    m_reset_cache[snapshotKey()] = takeSnapshot(rng_draws);
+  }
+}
+
+void StellaEnvironment::noopStart() {
+  if (m_noop_max <= 0) {
+    return;
+  }
+
+  // Each NOOP is a full act(), i.e. frame_skip frames subject to sticky actions
+  int noops = m_random.next() % (m_noop_max + 1);
+  for (int i = 0; i < noops && !isTerminal(); i++) {
+    act(PLAYER_A_NOOP, PLAYER_B_NOOP);
+  }
+}
+
+StellaEnvironment::SnapshotKey StellaEnvironment::snapshotKey() const {
+  return std::make_pair(m_state.getCurrentMode(), m_state.getDifficulty());
+}
+
+StellaEnvironment::ResetSnapshot
+StellaEnvironment::takeSnapshot(uint64_t rng_draws) {
+  ResetSnapshot snapshot;
+  snapshot.state = cloneState();
+  snapshot.rng_draws = m_osystem->console().system().rng().draws() - rng_draws;
+
+  MediaSource& media = m_osystem->console().mediaSource();
+  size_t frame_size = media.width() * media.height();
+  snapshot.current_frame.assign(media.currentFrameBuffer(),
+                                media.currentFrameBuffer() + frame_size);
+  snapshot.previous_frame.assign(media.previousFrameBuffer(),
+                                 media.previousFrameBuffer() + frame_size);
+  return snapshot;
+}
+
+/** The reset sequence is deterministic given the mode and difficulty, apart
+ *  from the RIOT RAM, which System::reset() leaves as the last episode left
+ *  it, and the RIOT timer and cartridge RAM, which it draws from the system
+ *  RNG. A restored episode starts from the values of the recorded one; games
+ *  that clear their RAM on start-up, once the 60 NOOP frames have let the
+ *  timer settle, then play exactly as after a cold reset. */
+void StellaEnvironment::restoreSnapshot(const ResetSnapshot& snapshot) {
+  // The snapshot holds the system RNG as it was after the recorded reset.
+  // Advance the current one as that reset did instead, so that the next
+  // cold reset draws what it would have drawn without the snapshot.
+  Random& rng = m_osystem->console().system().rng();
+  Serializer rng_state;
+  rng.saveState(rng_state);
+
+  // Keep counting frames from where we are, plus whatever the recorded
+  // episode had already played (random NOOPs).
+  int frame_number = m_state.getFrameNumber();
+  m_state.load(m_osystem, m_settings, &m_random, m_cartridge_md5,
+               snapshot.state);
+
+  Deserializer rng_in(rng_state.get_str());
+  rng.loadState(rng_in);
+  rng.discard(snapshot.rng_draws);
+  int episode_frame_number = m_state.getEpisodeFrameNumber();
+  m_state.setFrameNumbers(frame_number + episode_frame_number,
+                          episode_frame_number);
+
+  MediaSource& media = m_osystem->console().mediaSource();
+  std::copy(snapshot.current_frame.begin(), snapshot.current_frame.end(),
+            media.currentFrameBuffer());
+  std::copy(snapshot.previous_frame.begin(), snapshot.previous_frame.end(),
+            media.previousFrameBuffer());
+  media.invalidateFrameBuffers();
+
+  // As left by softReset()
+  resetPlayerActions();
+
+  processObservations();
 }
 
 ALEState StellaEnvironment::cloneState(bool include_rng) {
@@ -135,6 +277,62 @@ void StellaEnvironment::restoreState(const ALEState& target_state) {
   m_state.load(m_osystem, m_settings, &m_random, m_cartridge_md5, target_state);
 }
 
+uint64_t StellaEnvironment::stateHash() {
+  StateHash hash;
+  m_osystem->console().system().hash(hash);
+
+  // The ROM settings' bookkeeping: reward, score, terminal and lives, plus
+  // whatever flags a game keeps
+  m_settings->hash(hash);
+
+  // With sticky actions, the last actions may be repeated instead of the
+  // next ones
+  if (m_repeat_action_probability > 0.0) {
+    for (size_t p = 0; p < MAX_PLAYERS; p++) {
+      uint32_t strength;
+      std::memcpy(&strength, &m_paddle_strengths[p], sizeof(strength));
+      hash.update(m_player_actions[p]);
+      hash.update(strength);
+    }
+  }
+
+  // Paddle resistances and console switches
+  hash.update(m_state.getLeftPaddle());
+  hash.update(m_state.getRightPaddle());
+  hash.update(m_state.getPaddleC());
+  hash.update(m_state.getPaddleD());
+  hash.update(m_state.getCurrentMode());
+  hash.update(m_state.getDifficulty());
+  return hash.value();
+}
+
+size_t StellaEnvironment::rollout(const ALEState& state, const Action* actions,
+                                  size_t num_actions, float paddle_strength,
+                                  bool stop_on_terminal, reward_t* rewards) {
+  restoreState(state);
+
+  size_t steps = 0;
+  m_in_rollout = true;
+  try {
+    while (steps < num_actions && !(stop_on_terminal && isTerminal())) {
+      rewards[steps] = act(actions[steps], PLAYER_B_NOOP, paddle_strength, 0.0);
+      steps++;
+    }
+  } catch (...) {
+    m_in_rollout = false;
+    throw;
+  }
+  m_in_rollout = false;
+
+  // The phosphor blend only looks at the last two frames, so the final screen
+  // is the same as if every frame had been processed, and the audio samples
+  // are captured regardless.
+  updateObservationGeneration();
+  processScreen();
+  processAudio();
+  return steps;
+}
+
 void StellaEnvironment::noopIllegalActions(Action& player_a_action,
                                            Action& player_b_action) {
   if (player_a_action < (Action)PLAYER_B_NOOP &&
@@ -154,8 +352,66 @@ void StellaEnvironment::noopIllegalActions(Action& player_a_action,
 
 reward_t StellaEnvironment::act(Action player_a_action, Action player_b_action,
                                 float paddle_a_strength, float paddle_b_strength) {
-  // Total reward received as we repeat the action
-  reward_t sum_rewards = 0;
+  ALE_PERF_SCOPE(m_osystem->perfStats().act_ns);
+
+  const Action actions[2] = {player_a_action, player_b_action};
+  const float paddle_strengths[2] = {paddle_a_strength, paddle_b_strength};
+  reward_t rewards[2];
+  if (m_headless || m_in_rollout) {
+    actFrames<false>(actions, paddle_strengths, 2, rewards);
+  } else {
+    actFrames<true>(actions, paddle_strengths, 2, rewards);
+  }
+  return rewards[0];
+}
+
+void StellaEnvironment::act(const Action* actions,
+                            const float* paddle_strengths, size_t num_players,
+                            reward_t* rewards) {
+  ALE_PERF_SCOPE(m_osystem->perfStats().act_ns);
+
+  if (num_players == 0 || num_players > getMaxPlayers()) {
+    throw std::runtime_error("Invalid number of players: " +
+                             std::to_string(num_players) + " (this game takes 1 to " +
+                             std::to_string(getMaxPlayers()) + ")");
+  }
+
+  // Player B is always stepped, so that the environment RNG advances as in
+  // the single-player act().
+  const size_t num_stepped = std::max<size_t>(num_players, 2);
+  Action player_actions[MAX_PLAYERS];
+  float player_strengths[MAX_PLAYERS];
+  for (size_t i = 0; i < num_stepped; i++) {
+    player_actions[i] = i < num_players ? actions[i] : PLAYER_A_NOOP;
+    if (player_actions[i] >= PLAYER_B_NOOP) {
+      throw std::runtime_error("Invalid action for player " +
+                               std::to_string(i) + ": " +
+                               action_to_string(player_actions[i]));
+    }
+    player_strengths[i] =
+        (paddle_strengths != nullptr && i < num_players) ? paddle_strengths[i] : 1.0f;
+  }
+  player_actions[1] = (Action)(player_actions[1] + PLAYER_B_NOOP);
+
+  reward_t player_rewards[MAX_PLAYERS];
+  if (m_headless || m_in_rollout) {
+    actFrames<false>(player_actions, player_strengths, num_stepped, player_rewards);
+  } else {
+    actFrames<true>(player_actions, player_strengths, num_stepped, player_rewards);
+  }
+  std::copy(player_rewards, player_rewards + num_players, rewards);
+}
+
+size_t StellaEnvironment::getMaxPlayers() const {
+  return m_right_paddles ? 4 : 2;
+}
+
+template <bool WithHooks>
+void StellaEnvironment::actFrames(const Action* actions,
+                                  const float* paddle_strengths,
+                                  size_t num_players, reward_t* rewards) {
+  // Total reward received by each player as we repeat the action
+  std::fill(rewards, rewards + num_players, 0);
 
   Random& rng = getEnvironmentRNG();
 
@@ -163,33 +419,35 @@ reward_t StellaEnvironment::act(Action player_a_action, Action player_b_action,
   //  past the terminal state
   for (size_t i = 0; i < m_frame_skip; i++) {
     // Stochastically drop actions, according to m_repeat_action_probability
-    if (rng.nextDouble() >= m_repeat_action_probability) {
-      m_player_a_action = player_a_action;
-      m_paddle_a_strength = paddle_a_strength;
-    }
-    // @todo Possibly optimize by avoiding call to rand() when player B is "off" ?
-    if (rng.nextDouble() >= m_repeat_action_probability) {
-      m_player_b_action = player_b_action;
-      m_paddle_b_strength = paddle_b_strength;
+    for (size_t p = 0; p < num_players; p++) {
+      if (rng.nextDouble() >= m_repeat_action_probability) {
+        m_player_actions[p] = actions[p];
+        m_paddle_strengths[p] = paddle_strengths[p];
+      }
     }
 
-    // If so desired, request one frame's worth of sound (this does nothing if recording
-    // is not enabled)
-    m_osystem->sound().recordNextFrame();
+    if constexpr (WithHooks) {
+      ALE_PERF_SCOPE(m_osystem->perfStats().hooks_ns);
 
-    // Render screen if we're displaying it
-    m_osystem->screen().render();
+      // If so desired, request one frame's worth of sound (this does nothing if recording
+      // is not enabled)
+      m_osystem->sound().recordNextFrame();
 
-    // Similarly record screen as needed
-    if (m_screen_exporter.get() != NULL)
-      m_screen_exporter->saveNext(m_screen);
+      // Render screen if we're displaying it
+      m_osystem->screen().render();
+
+      // Similarly record screen as needed
+      if (m_screen_exporter.get() != NULL)
+        m_screen_exporter->saveNext(m_screen);
+    }
 
     // Use the stored actions, which may or may not have changed this frame
-    sum_rewards += oneStepAct(m_player_a_action, m_player_b_action,
-                              m_paddle_a_strength, m_paddle_b_strength);
+    oneStepAct(num_players, rewards);
   }
 
-  return std::clamp(sum_rewards, m_reward_min, m_reward_max);
+  for (size_t p = 0; p < num_players; p++) {
+    rewards[p] = std::clamp(rewards[p], m_reward_min, m_reward_max);
+  }
 }
 
 /** This functions emulates a push on the reset button of the console */
@@ -197,30 +455,53 @@ void StellaEnvironment::softReset() {
   emulate(RESET, PLAYER_B_NOOP, 1.0, 1.0, m_num_reset_steps);
 
   // Reset previous actions to NOOP for correct action repeating
-  m_player_a_action = PLAYER_A_NOOP;
-  m_player_b_action = PLAYER_B_NOOP;
+  resetPlayerActions();
+}
+
+void StellaEnvironment::resetPlayerActions() {
+  std::fill(m_player_actions, m_player_actions + MAX_PLAYERS, PLAYER_A_NOOP);
+  m_player_actions[1] = PLAYER_B_NOOP;
 }
 
 /** Applies the given actions (e.g. updating paddle positions when the paddle is used)
  *  and performs one simulation step in Stella. */
-reward_t StellaEnvironment::oneStepAct(Action player_a_action, Action player_b_action,
-                                       float paddle_a_strength, float paddle_b_strength) {
+void StellaEnvironment::oneStepAct(size_t num_players, reward_t* rewards) {
   // Once in a terminal state, refuse to go any further (special actions must be handled
   //  outside of this environment; in particular reset() should be called rather than passing
   //  RESET or SYSTEM_RESET.
   if (isTerminal())
-    return 0;
+    return;
 
   // Convert illegal actions into NOOPs; actions such as reset are always legal
+  Action player_a_action = m_player_actions[0];
+  Action player_b_action = m_player_actions[1];
   noopIllegalActions(player_a_action, player_b_action);
 
   // Emulate in the emulator
-  emulate(player_a_action, player_b_action,
-          paddle_a_strength, paddle_b_strength);
+  if (num_players > 2) {
+    Action player_cd_actions[2];
+    for (size_t p = 0; p < 2; p++) {
+      const Action action = m_player_actions[2 + p];
+      player_cd_actions[p] = m_settings->isLegal(action) ? action : PLAYER_A_NOOP;
+    }
+    emulate(player_a_action, player_b_action, m_paddle_strengths[0],
+            m_paddle_strengths[1], 1, player_cd_actions, m_paddle_strengths + 2);
+  } else {
+    emulate(player_a_action, player_b_action, m_paddle_strengths[0],
+            m_paddle_strengths[1]);
+  }
   // Increment the number of frames seen so far
   m_state.incrementFrame();
 
-  return m_settings->getReward();
+  if (num_players > 1 && m_settings->numPlayers() > 1) {
+    reward_t frame_rewards[MAX_PLAYERS] = {};
+    m_settings->getRewards(frame_rewards);
+    for (size_t p = 0; p < num_players; p++) {
+      rewards[p] += frame_rewards[p];
+    }
+  } else {
+    rewards[0] += m_settings->getReward();
+  }
 }
 
 bool StellaEnvironment::isTerminal() const {
@@ -248,10 +529,9 @@ bool StellaEnvironment::isGameTruncated() const {
 void StellaEnvironment::pressSelect(size_t num_steps) {
   m_state.pressSelect(m_osystem->event());
   for (size_t t = 0; t < num_steps; t++) {
-    m_osystem->console().mediaSource().update();
+    updateMediaSource();
   }
-  processScreen();
-  processRAM();
+  processObservations();
   emulate(PLAYER_A_NOOP, PLAYER_B_NOOP, 1.0, 1.0);
   m_state.incrementFrame();
 }
@@ -267,7 +547,8 @@ void StellaEnvironment::setMode(game_mode_t value) {
 void StellaEnvironment::emulate(
   Action player_a_action, Action player_b_action,
   float paddle_a_strength, float paddle_b_strength,
-  size_t num_steps
+  size_t num_steps,
+  const Action* player_cd_actions, const float* paddle_cd_strengths
 ) {
   Event* event = m_osystem->event();
 
@@ -281,23 +562,50 @@ void StellaEnvironment::emulate(
         player_a_action, paddle_a_strength,
         player_b_action, paddle_b_strength
       );
-
-      m_osystem->console().mediaSource().update();
-      m_settings->step(m_osystem->console().system());
+      if (player_cd_actions != nullptr) {
+        m_state.applyActionRightPaddles(
+          event,
+          player_cd_actions[0], paddle_cd_strengths[0],
+          player_cd_actions[1], paddle_cd_strengths[1]
+        );
+      }
+
+      updateMediaSource();
+      stepRomSettings();
     }
   } else {
     // In joystick mode we only need to set the action events once
     m_state.applyActionJoysticks(event, player_a_action, player_b_action);
 
     for (size_t t = 0; t < num_steps; t++) {
-      m_osystem->console().mediaSource().update();
-      m_settings->step(m_osystem->console().system());
+      updateMediaSource();
+      stepRomSettings();
     }
   }
 
-  // Parse screen and RAM into their respective data structures
-  processScreen();
-  processRAM();
+  processObservations();
+}
+
+void StellaEnvironment::updateMediaSource() {
+  ALE_PERF_SCOPE(m_osystem->perfStats().emulate_ns);
+#ifdef ALE_PERF_STATS
+  PerfStats& stats = m_osystem->perfStats();
+  const uint64_t instructions =
+      m_osystem->console().system().m6502().totalInstructionCount();
+#endif
+
+  m_osystem->console().mediaSource().update();
+
+#ifdef ALE_PERF_STATS
+  stats.frames++;
+  stats.instructions +=
+      m_osystem->console().system().m6502().totalInstructionCount() - instructions;
+#endif
+}
+
+void StellaEnvironment::stepRomSettings() {
+  ALE_PERF_SCOPE(m_osystem->perfStats().rom_step_ns);
+  m_settings->step(m_osystem->console().system());
 }
 
 /** Accessor methods for the environment state. */
@@ -311,26 +619,63 @@ std::unique_ptr<StellaEnvironmentWrapper> StellaEnvironment::getWrapper() {
 }
 
 void StellaEnvironment::processScreen() {
+  ALE_PERF_SCOPE(m_osystem->perfStats().screen_ns);
   if (m_colour_averaging) {
     // Perform phosphor averaging; the blender stores its result in the given screen
     m_phosphor_blend.process(m_screen);
   } else {
-    // Copy screen over and we're done!
-    std::memcpy(m_screen.getArray(),
-           m_osystem->console().mediaSource().currentFrameBuffer(),
-           m_screen.arraySize());
+    // Copy the scanlines that changed since the screen was last copied
+    MediaSource& media = m_osystem->console().mediaSource();
+    const uint64_t* generations = media.scanlineGenerations();
+    const size_t width = m_screen.width();
+    for (size_t row = 0; row < m_screen.height(); row++) {
+      if (generations[row] > m_screen_generation) {
+        std::memcpy(m_screen.getArray() + row * width,
+                    media.currentFrameBuffer() + row * width, width);
+      }
+    }
+    m_screen_generation = media.frameGeneration();
   }
 }
 
 void StellaEnvironment::processRAM() {
+  ALE_PERF_SCOPE(m_osystem->perfStats().ram_ns);
   // Copy RAM over
   for (size_t i = 0; i < m_ram.size(); i++)
     *m_ram.byte(i) = m_osystem->console().system().peek(i + 0x80);
 }
 
+void StellaEnvironment::processAudio() {
+  if (m_sound_capture == nullptr) return;
+
+  // Synthesize the samples up to now, and copy the window of the latest ones
+  m_sound_capture->update(m_osystem->console().system().cycles());
+  std::memcpy(m_audio.data(), m_sound_capture->samples(), m_audio.size());
+}
+
+void StellaEnvironment::processObservations() {
+  updateObservationGeneration();
+
+  // Parse screen, audio and RAM into their respective data structures
+  if (!m_in_rollout) {
+    processScreen();
+    processAudio();
+  }
+  processRAM();
+}
+
 void StellaEnvironment::setRAM(size_t memory_index, byte_t value) {
   m_osystem->console().system().poke(memory_index + 0x80, value);
   *m_ram.byte(memory_index) = value;
+  updateObservationGeneration();
+}
+
+void StellaEnvironment::updateObservationGeneration() {
+  if ((m_observation_generation & 0xFFFFFFFF) == 0xFFFFFFFF) {
+    m_observation_generation = firstObservationGeneration();
+  } else {
+    m_observation_generation++;
+  }
 }
 
 }  // namespace ale
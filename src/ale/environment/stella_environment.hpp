@@ -30,10 +30,15 @@
 #include "ale/common/Constants.h"
 #include "ale/games/RomSettings.hpp"
 #include "ale/common/Log.hpp"
+#include "ale/common/PerfStats.hpp"
 #include "ale/common/ScreenExporter.hpp"
+#include "ale/common/SoundCapture.hxx"
 
 #include <cstddef>
+#include <map>
 #include <memory>
+#include <utility>
+#include <vector>
 
 namespace ale {
 
@@ -52,6 +57,19 @@ class StellaEnvironment {
   /** Restores a previously saved copy of the state. */
   void restoreState(const ALEState&);
 
+  /** Returns a 64-bit hash of the emulator state, computed in place; see
+   *  ALEInterface::stateHash(). */
+  uint64_t stateHash();
+
+  /** Restores the given state, then applies player A's actions one act() at a
+   *  time and stores each step's reward. Intermediate screens are neither
+   *  processed nor passed to the display and recording hooks; only the final
+   *  screen is. Returns the number of steps taken, which is less than
+   *  num_actions when stop_on_terminal is set and the episode ends early. */
+  size_t rollout(const ALEState& state, const Action* actions,
+                 size_t num_actions, float paddle_strength,
+                 bool stop_on_terminal, reward_t* rewards);
+
   /** Applies the given actions (e.g. updating paddle positions when the paddle is used)
    *  and performs one simulation step in Stella. Returns the resultant reward. When
    *  frame skip is set to > 1, up the corresponding number of simulation steps are performed.
@@ -61,6 +79,21 @@ class StellaEnvironment {
   reward_t act(Action player_a_action, Action player_b_action,
                float paddle_a_strength = 1.0, float paddle_b_strength = 1.0);
 
+  /** Applies one action per player to the first num_players players and
+   *  performs one act() worth of simulation steps. Each player's action is
+   *  taken from player A's action set (PLAYER_A_NOOP to
+   *  PLAYER_A_DOWNLEFTFIRE); players C and D turn the paddles of the right
+   *  controller port. paddle_strengths may be null, meaning 1.0 for all.
+   *  Stores each player's reward, as reported by RomSettings::getRewards()
+   *  and summed over the frames, in rewards[0 .. num_players). Player A's
+   *  reward is what act() would have returned. */
+  void act(const Action* actions, const float* paddle_strengths,
+           size_t num_players, reward_t* rewards);
+
+  /** Returns the number of players the multi-player act() accepts: 4 in
+   *  games with paddles on both controller ports, otherwise 2. */
+  size_t getMaxPlayers() const;
+
   /** Applies the given continuous actions (e.g. updating paddle positions when
    * the paddle is used) and performs one simulation step in Stella. Returns the
    * resultant reward. When frame skip is set to > 1, up the corresponding
@@ -110,6 +143,14 @@ class StellaEnvironment {
   void setRAM(size_t memory_index, byte_t value);
   const ALERAM& getRAM() const { return m_ram; }
 
+  /** Returns the most recent audio samples, oldest first, if the sound is
+   *  captured into memory (see SoundCapture); otherwise nothing. */
+  const std::vector<uint8_t>& getAudio() const { return m_audio; }
+
+  /** Returns a number that changes whenever the screen, audio or RAM may
+   *  have changed. It is never repeated, even by other environments. */
+  uint64_t getObservationGeneration() const { return m_observation_generation; }
+
   int getFrameNumber() const { return m_state.getFrameNumber(); }
   int getEpisodeFrameNumber() const { return m_state.getEpisodeFrameNumber(); }
 
@@ -123,18 +164,40 @@ class StellaEnvironment {
   // game mode changes only take effect when the environment is reset.
   game_mode_t getMode() const { return m_state.getCurrentMode(); }
 
+  /** Per-stage timing counters accumulated since construction or the last
+   *  resetPerfStats(). All zero unless built with ALE_PERF_STATS. */
+  const PerfStats& getPerfStats() const { return m_osystem->perfStats(); }
+  void resetPerfStats() { m_osystem->perfStats().reset(); }
+
   /** Returns a wrapper providing #include-free access to our methods. */
   std::unique_ptr<StellaEnvironmentWrapper> getWrapper();
 
  private:
-  /** This applies an action exactly one time step. Helper function to act(). */
-  reward_t oneStepAct(Action player_a_action, Action player_b_action,
-                      float paddle_a_strength, float paddle_b_strength);
-
-  /** Actually emulates the emulator for a given number of steps. */
+  /** The body of act(). The frames are emulated without the display,
+   *  sound and screen recording hooks unless WithHooks is set. */
+  template <bool WithHooks>
+  void actFrames(const Action* actions, const float* paddle_strengths,
+                 size_t num_players, reward_t* rewards);
+
+  /** This applies the players' last actions exactly one time step and adds
+   *  their rewards to rewards. Helper function to act(). */
+  void oneStepAct(size_t num_players, reward_t* rewards);
+
+  /** Actually emulates the emulator for a given number of steps. Players C
+   *  and D's paddles are only moved if their actions are given. */
   void emulate(Action player_a_action, Action player_b_action,
                float paddle_a_strength, float paddle_b_strength,
-               size_t num_steps = 1);
+               size_t num_steps = 1,
+               const Action* player_cd_actions = nullptr,
+               const float* paddle_cd_strengths = nullptr);
+
+  /** Sets every player's last action to NOOP, as after a reset. */
+  void resetPlayerActions();
+
+  /** Runs the emulator for one frame. */
+  void updateMediaSource();
+  /** Lets the ROM settings extract reward and terminal information. */
+  void stepRomSettings();
 
   /** Drops illegal actions, such as the fire button in skiing. Note that this is different
    *   from the minimal set of actions. */
@@ -144,6 +207,29 @@ class StellaEnvironment {
   void processScreen();
   /** Processes the emulator RAM and saves it in m_ram */
   void processRAM();
+  /** Copies the captured audio samples, if any, to m_audio */
+  void processAudio();
+  /** Processes the screen and audio, unless in a rollout, and the RAM. */
+  void processObservations();
+  /** Moves to the next observation generation, once per update of the
+   *  screen, audio or RAM. */
+  void updateObservationGeneration();
+
+  /** Runs the reset sequence (or restores its cached outcome). */
+  void resetEmulator();
+  /** Applies a random number of NOOPs in [0, noop_max]. */
+  void noopStart();
+
+  struct ResetSnapshot;
+  typedef std::pair<game_mode_t, difficulty_t> SnapshotKey;
+
+  /** The key under which start states for the current configuration are kept. */
+  SnapshotKey snapshotKey() const;
+  /** Records the current state as a start state, reached from a reset that
+   *  began when the system RNG had drawn rng_draws values. */
+  ResetSnapshot takeSnapshot(uint64_t rng_draws);
+  /** Starts a new episode from a recorded start state. */
+  void restoreSnapshot(const ResetSnapshot& snapshot);
 
  private:
   stella::OSystem* m_osystem;
@@ -155,8 +241,31 @@ class StellaEnvironment {
   ALEState m_state;   // Current environment state
   ALEScreen m_screen; // The current ALE screen (possibly colour-averaged)
   ALERAM m_ram;       // The current ALE RAM
+  std::vector<uint8_t> m_audio; // The current audio samples, if captured
+  SoundCapture* m_sound_capture; // The sound object, if it captures audio
+  uint64_t m_screen_generation; // Frame generation m_screen was copied at
+  uint64_t m_observation_generation; // See getObservationGeneration()
 
   bool m_use_paddles; // Whether this game uses paddles
+  bool m_right_paddles; // Whether the right controller is a pair of paddles
+  bool m_in_rollout;  // Skip per-frame screen processing and hooks
+  bool m_headless;    // No display, sound or screen recording: skip the hooks
+
+  /** A start state (after reset, or after the random NOOPs), along with the
+   *  TIA frame buffers that the saved emulator state does not include
+   *  (needed for colour averaging). */
+  struct ResetSnapshot {
+    ALEState state;
+    std::vector<uint8_t> current_frame;
+    std::vector<uint8_t> previous_frame;
+    uint64_t rng_draws;  // Values drawn from the system RNG by the reset
+  };
+  bool m_use_reset_cache;  // Whether reset() restores cached snapshots
+  std::map<SnapshotKey, ResetSnapshot> m_reset_cache;
+
+  int m_noop_max;             // Maximum number of NOOPs applied after reset
+  size_t m_num_start_states;  // Size of the start state bank (0 disables it)
+  std::map<SnapshotKey, std::vector<ResetSnapshot>> m_start_states;
 
   /** Parameters loaded from Settings. */
   int m_num_reset_steps;             // Number of RESET frames per reset
@@ -170,9 +279,10 @@ class StellaEnvironment {
   int m_reward_min;                // Minimum reward value
   int m_reward_max;                // Maximum reward value
 
-  // The last actions taken by our players
-  Action m_player_a_action, m_player_b_action;
-  float m_paddle_a_strength, m_paddle_b_strength;
+  // The last actions taken by our players. Player B's are PLAYER_B_*
+  // actions, the other players' are from player A's action set.
+  Action m_player_actions[MAX_PLAYERS];
+  float m_paddle_strengths[MAX_PLAYERS];
   float m_player_a_r, m_player_b_r;
   float m_player_a_theta, m_player_b_theta;
   float m_player_a_fire, m_player_b_fire;
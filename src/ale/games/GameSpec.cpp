@@ -0,0 +1,123 @@
+/* *****************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2013 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details.
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ *
+ * GameSpec.cpp
+ *
+ * Declarative description of where a game keeps its score, lives and
+ *  game-over flags in RAM, and the RomSettings that evaluates it.
+ * *****************************************************************************
+ */
+
+#include "ale/games/GameSpec.hpp"
+
+#include "ale/emucore/M6532.hxx"
+#include "ale/emucore/System.hxx"
+
+namespace ale {
+using namespace stella;
+
+namespace {
+
+bool holds(const TerminalClause& clause, const uint8_t* ram) {
+  bool used = false;
+  for (const RamTest& test : clause) {
+    if (!test.used()) continue;
+    if (!test(ram)) return false;
+    used = true;
+  }
+  return used;
+}
+
+}  // namespace
+
+GameSpecSettings::GameSpecSettings(const GameSpec& spec) : m_spec(&spec) {
+  reset();
+}
+
+void GameSpecSettings::reset() {
+  m_reward = 0;
+  m_score = 0;
+  m_terminal = false;
+  m_started = false;
+  m_lives = m_spec->lives.initial;
+}
+
+bool GameSpecSettings::isMinimal(const Action& a) const {
+  return a < PLAYER_B_NOOP && (m_spec->minimalActions >> a) & 1;
+}
+
+void GameSpecSettings::step(const System& system) {
+  evaluate(system.riot().ram());
+}
+
+void GameSpecSettings::evaluate(const uint8_t* ram) {
+  const GameSpec& spec = *m_spec;
+
+  // update the reward
+  reward_t score =
+      (spec.score(ram) - spec.opponentScore(ram)) * spec.scoreMultiplier;
+  reward_t reward = score - m_score;
+  if (reward < 0 && spec.scoreWrap > 0) {
+    reward += spec.scoreWrap;
+  }
+  m_reward = std::min(std::max(reward, spec.minReward), spec.maxReward);
+  m_score = score;
+
+  if (spec.lives.used()) {
+    m_lives = spec.lives(ram);
+  }
+
+  // update terminal status
+  if (spec.started.used() && !m_started) {
+    m_started = spec.started(ram);
+  }
+  m_terminal = false;
+  if (m_started || !spec.started.used()) {
+    for (const TerminalClause& clause : spec.terminal) {
+      m_terminal = m_terminal || holds(clause, ram);
+    }
+  }
+}
+
+void GameSpecSettings::getRewards(reward_t* rewards) const {
+  rewards[0] = m_reward;
+  if (m_spec->players > 1) rewards[1] = -m_reward;
+}
+
+int GameSpecSettings::lives() {
+  return (isTerminal() || !m_spec->lives.used()) ? 0 : m_lives;
+}
+
+ActionVect GameSpecSettings::getStartingActions() {
+  ActionVect actions;
+  for (Action a : m_spec->startingActions) {
+    if (a != PLAYER_A_NOOP) actions.push_back(a);
+  }
+  return actions;
+}
+
+void GameSpecSettings::saveState(Serializer& ser) {
+  ser.putInt(m_reward);
+  ser.putInt(m_score);
+  ser.putBool(m_terminal);
+  if (m_spec->started.used()) ser.putBool(m_started);
+  if (m_spec->lives.used()) ser.putInt(m_lives);
+}
+
+void GameSpecSettings::loadState(Deserializer& ser) {
+  m_reward = ser.getInt();
+  m_score = ser.getInt();
+  m_terminal = ser.getBool();
+  if (m_spec->started.used()) m_started = ser.getBool();
+  if (m_spec->lives.used()) m_lives = ser.getInt();
+}
+
+}  // namespace ale
@@ -0,0 +1,215 @@
+/* *****************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2013 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details.
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ *
+ * GameSpec.hpp
+ *
+ * Declarative description of where a game keeps its score, lives and
+ *  game-over flags in RAM, and the RomSettings that evaluates it.
+ * *****************************************************************************
+ */
+
+#ifndef __GAMESPEC_HPP__
+#define __GAMESPEC_HPP__
+
+#include <array>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+
+#include "ale/games/RomSettings.hpp"
+
+namespace ale {
+
+// A test of one RAM byte: (ram[address] & mask) == value, or != value.
+// Addresses may be given as RAM offsets (0x00 - 0x7f) or as mapped
+// addresses (0x80 - 0xff), like readRam(). A zero mask marks an unused test.
+struct RamTest {
+  uint8_t address = 0;
+  uint8_t mask = 0;
+  uint8_t value = 0;
+  bool equal = true;
+
+  constexpr bool used() const { return mask != 0; }
+
+  constexpr bool operator()(const uint8_t* ram) const {
+    return ((ram[address & 0x7F] & mask) == value) == equal;
+  }
+};
+
+constexpr RamTest ramEquals(int address, int value, int mask = 0xFF) {
+  return {uint8_t(address), uint8_t(mask), uint8_t(value), true};
+}
+
+constexpr RamTest ramNotEquals(int address, int value, int mask = 0xFF) {
+  return {uint8_t(address), uint8_t(mask), uint8_t(value), false};
+}
+
+// A number spread over up to three RAM bytes, least significant byte first.
+// In BCD each byte holds two decimal digits, low digit in the low nibble,
+// and only the given number of digits is read. Binary scores are a single
+// byte. An empty score (no bytes) is always zero.
+struct ScoreSpec {
+  std::array<int16_t, 3> bytes = {-1, -1, -1};
+  uint8_t digits = 0;
+  bool bcd = false;
+
+  constexpr int operator()(const uint8_t* ram) const {
+    if (!bcd) {
+      return bytes[0] < 0 ? 0 : ram[bytes[0] & 0x7F];
+    }
+    int value = 0;
+    int scale = 1;
+    for (int i = 0; i < digits; i++, scale *= 10) {
+      const uint8_t byte = ram[bytes[i / 2] & 0x7F];
+      value += ((i % 2 == 0) ? (byte & 0xF) : (byte >> 4)) * scale;
+    }
+    return value;
+  }
+};
+
+// Same digit layout as getDecimalScore(lo, mid, hi) when reading two digits
+// per byte.
+constexpr ScoreSpec bcdScore(int digits, int lo, int mid = -1, int hi = -1) {
+  return {{int16_t(lo), int16_t(mid), int16_t(hi)}, uint8_t(digits), true};
+}
+
+constexpr ScoreSpec binaryScore(int address) {
+  return {{int16_t(address), -1, -1}, 0, false};
+}
+
+// Lives are ((ram[address] & mask) + offset), or the number of bits set in
+// (ram[address] & mask) if countBits. Games without an address have no
+// lives, and lives() is always 0.
+struct LivesSpec {
+  int16_t address = -1;
+  uint8_t mask = 0xFF;
+  int8_t offset = 0;
+  bool countBits = false;
+  // Lives reported before the first step
+  int initial = 0;
+
+  constexpr bool used() const { return address >= 0; }
+
+  constexpr int operator()(const uint8_t* ram) const {
+    const int value = ram[address & 0x7F] & mask;
+    if (!countBits) return value + offset;
+    int bits = 0;
+    for (int v = value; v != 0; v &= v - 1) bits++;
+    return bits;
+  }
+};
+
+// The game is over when every used test of any clause holds. Clauses
+// without a used test never hold.
+typedef std::array<RamTest, 3> TerminalClause;
+
+// Answers a bitmask over the player A actions, for GameSpec::minimalActions.
+constexpr uint32_t actionSet(std::initializer_list<Action> actions) {
+  uint32_t set = 0;
+  for (Action a : actions) set |= uint32_t(1) << a;
+  return set;
+}
+
+// All player A actions
+constexpr uint32_t ALL_ACTIONS = (uint32_t(1) << PLAYER_B_NOOP) - 1;
+
+/* Everything GameSpecSettings needs to extract rewards, lives and terminal
+ * states from RAM. Specs are constexpr tables; see Breakout.cpp for a
+ * typical one. */
+struct GameSpec {
+  // The score is (score - opponentScore) * scoreMultiplier, and the reward
+  // the difference in score since the previous frame.
+  ScoreSpec score;
+  ScoreSpec opponentScore;
+  int scoreMultiplier = 1;
+
+  // If positive, the score wraps around to 0 at this value, so a decrease
+  // is counted as wrapping rather than as a negative reward.
+  int scoreWrap = 0;
+
+  // Rewards are clipped to [minReward, maxReward].
+  reward_t minReward = std::numeric_limits<reward_t>::min();
+  reward_t maxReward = std::numeric_limits<reward_t>::max();
+
+  // With two players the game is zero-sum: player B's reward is the
+  // opposite of player A's.
+  int players = 1;
+
+  LivesSpec lives;
+
+  std::array<TerminalClause, 2> terminal = {};
+
+  // If used, the game is only considered over once this test has held,
+  // which keeps the power-on RAM contents from looking like a game over.
+  RamTest started;
+
+  // Player A actions that make up the minimal action set
+  uint32_t minimalActions = 0;
+
+  // Actions pressed to start the game; NOOP marks unused entries.
+  std::array<Action, 2> startingActions = {PLAYER_A_NOOP, PLAYER_A_NOOP};
+};
+
+/* RomSettings driven by a GameSpec. Reads the RIOT RAM directly rather
+ * than through System::peek. Games only need to provide the spec, their
+ * name and checksum, and anything the spec does not cover, like modes.
+ * The state is saved as reward, score, terminal, then the started flag and
+ * lives if the spec uses them. */
+class GameSpecSettings : public RomSettings {
+ public:
+  explicit GameSpecSettings(const GameSpec& spec);
+
+  // reset
+  void reset() override;
+
+  // is end of game
+  bool isTerminal() const override { return m_terminal; }
+
+  // get the most recently observed reward
+  reward_t getReward() const override { return m_reward; }
+
+  // is an action part of the minimal set?
+  bool isMinimal(const Action& a) const override;
+
+  // process the latest information from ALE
+  void step(const stella::System& system) override;
+
+  // saves the state of the rom settings
+  void saveState(stella::Serializer& ser) override;
+
+  // loads the state of the rom settings
+  void loadState(stella::Deserializer& ser) override;
+
+  int lives() override;
+
+  ActionVect getStartingActions() override;
+
+  int numPlayers() const override { return m_spec->players; }
+
+  void getRewards(reward_t* rewards) const override;
+
+ protected:
+  // Updates the reward, lives and terminal state from the given RAM.
+  void evaluate(const uint8_t* ram);
+
+ private:
+  const GameSpec* m_spec;
+
+  bool m_terminal;
+  bool m_started;
+  reward_t m_reward;
+  reward_t m_score;
+  int m_lives;
+};
+
+}  // namespace ale
+
+#endif  // __GAMESPEC_HPP__
@@ -19,12 +19,24 @@
 #include "ale/games/RomSettings.hpp"
 
 #include <algorithm>
+#include <string>
+
+#include "ale/common/StateHash.hpp"
 
 namespace ale {
-using namespace stella;   // System
+using namespace stella;   // System, Serializer
 
 RomSettings::RomSettings() {}
 
+void RomSettings::hash(StateHash& hash) {
+  // Scores, flags and counters kept outside RAM are only visible through
+  // the saved state
+  Serializer ser;
+  saveState(ser);
+  const std::string state = ser.get_str();
+  hash.update(state.data(), state.size());
+}
+
 bool RomSettings::isLegal(const Action& a) const {
   return true;
 }
@@ -50,6 +50,8 @@ namespace stella{
 class System;
 }
 
+class StateHash;
+
 // rom support interface
 class RomSettings {
  public:
@@ -92,9 +94,19 @@ class RomSettings {
   // loads the state of the rom settings
   virtual void loadState(stella::Deserializer& ser) = 0;
 
+  // mixes the state saved by saveState into a state hash
+  virtual void hash(StateHash& hash);
+
   // is an action legal (default: yes)
   virtual bool isLegal(const Action& a) const;
 
+  // Number of players the game reports rewards for, at most MAX_PLAYERS.
+  virtual int numPlayers() const { return 1; }
+
+  // Stores the most recently observed reward of each of the numPlayers()
+  // players, player A's being getReward().
+  virtual void getRewards(reward_t* rewards) const { rewards[0] = getReward(); }
+
   // Remaining lives.
   virtual int lives() {
     return isTerminal() ? 0 : 1;
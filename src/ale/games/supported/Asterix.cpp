@@ -27,85 +27,38 @@
 
 #include "ale/games/supported/Asterix.hpp"
 
-#include "ale/games/RomUtils.hpp"
-
 namespace ale {
 using namespace stella;
 
-AsterixSettings::AsterixSettings() { reset(); }
+namespace {
+
+// Score in BCD at 0xE0-0xDE; lives in the low nibble of 0xD3.
+// We cannot wait for lives to be set to 0, because the agent has the option
+// of restarting the game on the very last frame (when lives == 1 and the
+// death counter at 0xC7 is 0x01) by holding 'fire'.
+constexpr GameSpec AsterixSpec = [] {
+  GameSpec spec;
+  spec.score = bcdScore(6, 0xE0, 0xDF, 0xDE);
+  spec.lives.address = 0xD3;
+  spec.lives.mask = 0xF;
+  spec.lives.initial = 3;
+  spec.terminal = {{{ramEquals(0xC7, 0x01), ramEquals(0xD3, 1, 0xF)}}};
+  spec.minimalActions = actionSet(
+      {PLAYER_A_NOOP, PLAYER_A_UP, PLAYER_A_RIGHT, PLAYER_A_LEFT, PLAYER_A_DOWN,
+       PLAYER_A_UPRIGHT, PLAYER_A_UPLEFT, PLAYER_A_DOWNRIGHT,
+       PLAYER_A_DOWNLEFT});
+  // Asterix requires the fire action to start the game
+  spec.startingActions = {PLAYER_A_FIRE};
+  return spec;
+}();
+
+}  // namespace
+
+AsterixSettings::AsterixSettings() : GameSpecSettings(AsterixSpec) {}
 
 /* create a new instance of the rom */
 RomSettings* AsterixSettings::clone() const {
   return new AsterixSettings(*this);
 }
 
-/* process the latest information from ALE */
-void AsterixSettings::step(const System& system) {
-  // update the reward
-  reward_t score = getDecimalScore(0xE0, 0xDF, 0xDE, &system);
-  m_reward = score - m_score;
-  m_score = score;
-
-  // update terminal status
-  m_lives = readRam(&system, 0xD3) & 0xF;
-  int death_counter = readRam(&system, 0xC7);
-
-  // we cannot wait for lives to be set to 0, because the agent has the
-  // option of the restarting the game on the very last frame (when lives==1
-  // and death_counter == 0x01) by holding 'fire'
-  m_terminal = (death_counter == 0x01 && m_lives == 1);
-}
-
-/* is end of game */
-bool AsterixSettings::isTerminal() const { return m_terminal; };
-
-/* get the most recently observed reward */
-reward_t AsterixSettings::getReward() const { return m_reward; }
-
-/* is an action part of the minimal set? */
-bool AsterixSettings::isMinimal(const Action& a) const {
-  switch (a) {
-    case PLAYER_A_NOOP:
-    case PLAYER_A_UP:
-    case PLAYER_A_RIGHT:
-    case PLAYER_A_LEFT:
-    case PLAYER_A_DOWN:
-    case PLAYER_A_UPRIGHT:
-    case PLAYER_A_UPLEFT:
-    case PLAYER_A_DOWNRIGHT:
-    case PLAYER_A_DOWNLEFT:
-      return true;
-    default:
-      return false;
-  }
-}
-
-/* reset the state of the game */
-void AsterixSettings::reset() {
-  m_reward = 0;
-  m_score = 0;
-  m_terminal = false;
-  m_lives = 3;
-}
-
-/* saves the state of the rom settings */
-void AsterixSettings::saveState(Serializer& ser) {
-  ser.putInt(m_reward);
-  ser.putInt(m_score);
-  ser.putBool(m_terminal);
-  ser.putInt(m_lives);
-}
-
-// loads the state of the rom settings
-void AsterixSettings::loadState(Deserializer& ser) {
-  m_reward = ser.getInt();
-  m_score = ser.getInt();
-  m_terminal = ser.getBool();
-  m_lives = ser.getInt();
-}
-
-ActionVect AsterixSettings::getStartingActions() {
-  return {PLAYER_A_FIRE};
-}
-
 }  // namespace ale
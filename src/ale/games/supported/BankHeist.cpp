@@ -32,82 +32,27 @@
 namespace ale {
 using namespace stella;
 
-BankHeistSettings::BankHeistSettings() { reset(); }
+namespace {
 
-/* create a new instance of the rom */
-RomSettings* BankHeistSettings::clone() const {
-  return new BankHeistSettings(*this);
-}
-
-/* process the latest information from ALE */
-void BankHeistSettings::step(const System& system) {
-  // update the reward
-  reward_t score = getDecimalScore(0xDA, 0xD9, 0xD8, &system);
-  m_reward = score - m_score;
-  m_score = score;
-
-  // update terminal status
-  int death_timer = readRam(&system, 0xCE);
-  m_lives = readRam(&system, 0xD5);
-
-  m_terminal = (death_timer == 0x01 && m_lives == 0x00);
-}
-
-/* is end of game */
-bool BankHeistSettings::isTerminal() const { return m_terminal; };
+// Score in BCD at 0xDA-0xD8; lives at 0xD5. The game is over when the
+// death timer at 0xCE runs out with no lives left.
+constexpr GameSpec BankHeistSpec = [] {
+  GameSpec spec;
+  spec.score = bcdScore(6, 0xDA, 0xD9, 0xD8);
+  spec.lives.address = 0xD5;
+  spec.lives.initial = 5;
+  spec.terminal = {{{ramEquals(0xCE, 0x01), ramEquals(0xD5, 0x00)}}};
+  spec.minimalActions = ALL_ACTIONS;
+  return spec;
+}();
 
-/* get the most recently observed reward */
-reward_t BankHeistSettings::getReward() const { return m_reward; }
+}  // namespace
 
-/* is an action part of the minimal set? */
-bool BankHeistSettings::isMinimal(const Action& a) const {
-  switch (a) {
-    case PLAYER_A_NOOP:
-    case PLAYER_A_FIRE:
-    case PLAYER_A_UP:
-    case PLAYER_A_RIGHT:
-    case PLAYER_A_LEFT:
-    case PLAYER_A_DOWN:
-    case PLAYER_A_UPRIGHT:
-    case PLAYER_A_UPLEFT:
-    case PLAYER_A_DOWNRIGHT:
-    case PLAYER_A_DOWNLEFT:
-    case PLAYER_A_UPFIRE:
-    case PLAYER_A_RIGHTFIRE:
-    case PLAYER_A_LEFTFIRE:
-    case PLAYER_A_DOWNFIRE:
-    case PLAYER_A_UPRIGHTFIRE:
-    case PLAYER_A_UPLEFTFIRE:
-    case PLAYER_A_DOWNRIGHTFIRE:
-    case PLAYER_A_DOWNLEFTFIRE:
-      return true;
-    default:
-      return false;
-  }
-}
+BankHeistSettings::BankHeistSettings() : GameSpecSettings(BankHeistSpec) {}
 
-/* reset the state of the game */
-void BankHeistSettings::reset() {
-  m_reward = 0;
-  m_score = 0;
-  m_terminal = false;
-  m_lives = 5;
-}
-
-/* saves the state of the rom settings */
-void BankHeistSettings::saveState(Serializer& ser) {
-  ser.putInt(m_reward);
-  ser.putInt(m_score);
-  ser.putBool(m_terminal);
-  ser.putInt(m_lives);
-}
-
-// loads the state of the rom settings
-void BankHeistSettings::loadState(Deserializer& ser) {
-  m_reward = ser.getInt();
-  m_score = ser.getInt();
-  m_terminal = ser.getBool();
-  m_lives = ser.getInt();
+/* create a new instance of the rom */
+RomSettings* BankHeistSettings::clone() const {
+  return new BankHeistSettings(*this);
 }
 
 // returns a list of mode that the game can be played in
@@ -32,77 +32,31 @@
 namespace ale {
 using namespace stella;
 
-BreakoutSettings::BreakoutSettings() { reset(); }
+namespace {
+
+// Score in BCD at 77 (tens and units) and the low nibble of 76 (hundreds).
+// 57 holds the lives left: 5 once the game has started, 0 when it is over.
+constexpr GameSpec BreakoutSpec = [] {
+  GameSpec spec;
+  spec.score = bcdScore(3, 77, 76);
+  spec.lives.address = 57;
+  spec.lives.initial = 5;
+  spec.terminal = {{{ramEquals(57, 0)}}};
+  spec.started = ramEquals(57, 5);
+  spec.minimalActions = actionSet(
+      {PLAYER_A_NOOP, PLAYER_A_FIRE, PLAYER_A_RIGHT, PLAYER_A_LEFT});
+  return spec;
+}();
+
+}  // namespace
+
+BreakoutSettings::BreakoutSettings() : GameSpecSettings(BreakoutSpec) {}
 
 /* create a new instance of the rom */
 RomSettings* BreakoutSettings::clone() const {
   return new BreakoutSettings(*this);
 }
 
-/* process the latest information from ALE */
-void BreakoutSettings::step(const System& system) {
-  // update the reward
-  int x = readRam(&system, 77);
-  int y = readRam(&system, 76);
-  reward_t score =
-      1 * (x & 0x000F) + 10 * ((x & 0x00F0) >> 4) + 100 * (y & 0x000F);
-  m_reward = score - m_score;
-  m_score = score;
-
-  // update terminal status
-  int byte_val = readRam(&system, 57);
-  if (!m_started && byte_val == 5)
-    m_started = true;
-  m_terminal = m_started && byte_val == 0;
-  m_lives = byte_val;
-}
-
-/* is end of game */
-bool BreakoutSettings::isTerminal() const { return m_terminal; };
-
-/* get the most recently observed reward */
-reward_t BreakoutSettings::getReward() const { return m_reward; }
-
-/* is an action part of the minimal set? */
-bool BreakoutSettings::isMinimal(const Action& a) const {
-  switch (a) {
-    case PLAYER_A_NOOP:
-    case PLAYER_A_FIRE:
-    case PLAYER_A_RIGHT:
-    case PLAYER_A_LEFT:
-      return true;
-    default:
-      return false;
-  }
-}
-
-/* reset the state of the game */
-void BreakoutSettings::reset() {
-  m_reward = 0;
-  m_score = 0;
-  m_lives = 5;
-  m_terminal = false;
-  m_started = false;
-}
-
-/* saves the state of the rom settings */
-void BreakoutSettings::saveState(Serializer& ser) {
-  ser.putInt(m_reward);
-  ser.putInt(m_score);
-  ser.putBool(m_terminal);
-  ser.putBool(m_started);
-  ser.putInt(m_lives);
-}
-
-// loads the state of the rom settings
-void BreakoutSettings::loadState(Deserializer& ser) {
-  m_reward = ser.getInt();
-  m_score = ser.getInt();
-  m_terminal = ser.getBool();
-  m_started = ser.getBool();
-  m_lives = ser.getInt();
-}
-
 // returns a list of mode that the game can be played in
 ModeVect BreakoutSettings::getAvailableModes() {
   ModeVect modes(getNumModes());
@@ -28,24 +28,15 @@
 #ifndef __BREAKOUT_HPP__
 #define __BREAKOUT_HPP__
 
-#include "ale/games/RomSettings.hpp"
+#include "ale/games/GameSpec.hpp"
 
 namespace ale {
 
 /* RL wrapper for Breakout */
-class BreakoutSettings : public RomSettings {
+class BreakoutSettings : public GameSpecSettings {
  public:
   BreakoutSettings();
 
-  // reset
-  void reset() override;
-
-  // is end of game
-  bool isTerminal() const override;
-
-  // get the most recently observed reward
-  reward_t getReward() const override;
-
   // the rom-name
   const char* rom() const override { return "breakout"; }
 
@@ -58,21 +49,6 @@ class BreakoutSettings : public RomSettings {
   // create a new instance of the rom
   RomSettings* clone() const override;
 
-  // is an action part of the minimal set?
-  bool isMinimal(const Action& a) const override;
-
-  // process the latest information from ALE
-  void step(const stella::System& system) override;
-
-  // saves the state of the rom settings
-  void saveState(stella::Serializer& ser) override;
-
-  // loads the state of the rom settings
-  void loadState(stella::Deserializer& ser) override;
-
-  // remaining lives
-  int lives() override { return isTerminal() ? 0 : m_lives; }
-
   // returns a list of mode that the game can be played in
   // in this game, there are 8 available modes
   ModeVect getAvailableModes() override;
@@ -85,13 +61,6 @@ class BreakoutSettings : public RomSettings {
   // returns a list of difficulties that the game can be played in
   // in this game, there are 2 available difficulties
   DifficultyVect getAvailableDifficulties() override;
-
- private:
-  bool m_terminal;
-  bool m_started;
-  reward_t m_reward;
-  reward_t m_score;
-  int m_lives;
 };
 
 }  // namespace ale
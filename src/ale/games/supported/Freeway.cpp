@@ -19,70 +19,27 @@
 namespace ale {
 using namespace stella;
 
-FreewaySettings::FreewaySettings() {
-  m_reward = 0;
-  m_score = 0;
-  m_terminal = false;
-}
-
-/* create a new instance of the rom */
-RomSettings* FreewaySettings::clone() const {
-  return new FreewaySettings(*this);
-}
-
-/* process the latest information from ALE */
-void FreewaySettings::step(const System& system) {
-  // update the reward
-  int score = getDecimalScore(103, -1, &system);
-  int reward = score - m_score;
-  if (reward < 0)
-    reward = 0;
-  if (reward > 1)
-    reward = 1;
-  m_reward = reward;
-  m_score = score;
-
-  // update terminal status
-  m_terminal = readRam(&system, 22) == 1;
-}
+namespace {
 
-/* is end of game */
-bool FreewaySettings::isTerminal() const { return m_terminal; };
+// One point per crossing, in BCD at 103; 22 is set to 1 when time runs out.
+constexpr GameSpec FreewaySpec = [] {
+  GameSpec spec;
+  spec.score = bcdScore(2, 103);
+  spec.minReward = 0;
+  spec.maxReward = 1;
+  spec.terminal = {{{ramEquals(22, 1)}}};
+  spec.minimalActions =
+      actionSet({PLAYER_A_NOOP, PLAYER_A_UP, PLAYER_A_DOWN});
+  return spec;
+}();
 
-/* get the most recently observed reward */
-reward_t FreewaySettings::getReward() const { return m_reward; }
+}  // namespace
 
-/* is an action part of the minimal set? */
-bool FreewaySettings::isMinimal(const Action& a) const {
-  switch (a) {
-    case PLAYER_A_NOOP:
-    case PLAYER_A_UP:
-    case PLAYER_A_DOWN:
-      return true;
-    default:
-      return false;
-  }
-}
+FreewaySettings::FreewaySettings() : GameSpecSettings(FreewaySpec) {}
 
-/* reset the state of the game */
-void FreewaySettings::reset() {
-  m_reward = 0;
-  m_score = 0;
-  m_terminal = false;
-}
-
-/* saves the state of the rom settings */
-void FreewaySettings::saveState(Serializer& ser) {
-  ser.putInt(m_reward);
-  ser.putInt(m_score);
-  ser.putBool(m_terminal);
-}
-
-// loads the state of the rom settings
-void FreewaySettings::loadState(Deserializer& ser) {
-  m_reward = ser.getInt();
-  m_score = ser.getInt();
-  m_terminal = ser.getBool();
+/* create a new instance of the rom */
+RomSettings* FreewaySettings::clone() const {
+  return new FreewaySettings(*this);
 }
 
 // returns a list of mode that the game can be played in
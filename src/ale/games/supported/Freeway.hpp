@@ -29,24 +29,15 @@
 #define __FREEWAY_HPP__
 
 #include "ale/environment/stella_environment_wrapper.hpp"
-#include "ale/games/RomSettings.hpp"
+#include "ale/games/GameSpec.hpp"
 
 namespace ale {
 
 /* RL wrapper for Freeway */
-class FreewaySettings : public RomSettings {
+class FreewaySettings : public GameSpecSettings {
  public:
   FreewaySettings();
 
-  // reset
-  void reset() override;
-
-  // is end of game
-  bool isTerminal() const override;
-
-  // get the most recently observed reward
-  reward_t getReward() const override;
-
   // the rom-name
   const char* rom() const override { return "freeway"; }
 
@@ -59,20 +50,6 @@ class FreewaySettings : public RomSettings {
   // create a new instance of the rom
   RomSettings* clone() const override;
 
-  // is an action part of the minimal set?
-  bool isMinimal(const Action& a) const override;
-
-  // process the latest information from ALE
-  void step(const stella::System& system) override;
-
-  // saves the state of the rom settings
-  void saveState(stella::Serializer& ser) override;
-
-  // loads the state of the rom settings
-  void loadState(stella::Deserializer& ser) override;
-
-  int lives() override { return 0; }
-
   // returns a list of mode that the game can be played in
   // in this game, there are 8 available modes
   ModeVect getAvailableModes() override;
@@ -85,11 +62,6 @@ class FreewaySettings : public RomSettings {
   // returns a list of difficulties that the game can be played in
   // in this game, there are 2 available difficulties
   DifficultyVect getAvailableDifficulties() override;
-
- private:
-  bool m_terminal;
-  reward_t m_reward;
-  reward_t m_score;
 };
 
 }  // namespace ale
@@ -32,88 +32,33 @@
 namespace ale {
 using namespace stella;
 
-FrostbiteSettings::FrostbiteSettings() { reset(); }
+namespace {
+
+// Score in BCD at 0xCA-0xC8; the low nibble of 0xCC counts the spare lives.
+// MGB: the maximum achievable life is 9. The system will actually let us set
+// the byte to higher values & properly decrement, but we do not gain lives
+// beyond 9.
+constexpr GameSpec FrostbiteSpec = [] {
+  GameSpec spec;
+  spec.score = bcdScore(6, 0xCA, 0xC9, 0xC8);
+  spec.lives.address = 0xCC;
+  spec.lives.mask = 0xF;
+  spec.lives.offset = 1;
+  spec.lives.initial = 4;
+  spec.terminal = {{{ramEquals(0xCC, 0, 0xF), ramNotEquals(0xF1, 0, 0x80)}}};
+  spec.minimalActions = ALL_ACTIONS;
+  return spec;
+}();
+
+}  // namespace
+
+FrostbiteSettings::FrostbiteSettings() : GameSpecSettings(FrostbiteSpec) {}
 
 /* create a new instance of the rom */
 RomSettings* FrostbiteSettings::clone() const {
   return new FrostbiteSettings(*this);
 }
 
-/* process the latest information from ALE */
-void FrostbiteSettings::step(const System& system) {
-  // update the reward
-  int score = getDecimalScore(0xCA, 0xC9, 0xC8, &system);
-  int reward = score - m_score;
-  m_reward = reward;
-  m_score = score;
-
-  // update terminal status
-  // MGB: the maximum achievable life is 9. The system will actually let us set the byte to
-  // higher values & properly decrement, but we do not gain lives beyond 9.
-  int lives_byte = (readRam(&system, 0xCC) & 0xF);
-  int flag = readRam(&system, 0xF1) & 0x80;
-  m_terminal = (lives_byte == 0 && flag != 0);
-
-  m_lives = lives_byte + 1;
-}
-
-/* is end of game */
-bool FrostbiteSettings::isTerminal() const { return m_terminal; };
-
-/* get the most recently observed reward */
-reward_t FrostbiteSettings::getReward() const { return m_reward; }
-
-/* is an action part of the minimal set? */
-bool FrostbiteSettings::isMinimal(const Action& a) const {
-  switch (a) {
-    case PLAYER_A_NOOP:
-    case PLAYER_A_FIRE:
-    case PLAYER_A_UP:
-    case PLAYER_A_RIGHT:
-    case PLAYER_A_LEFT:
-    case PLAYER_A_DOWN:
-    case PLAYER_A_UPRIGHT:
-    case PLAYER_A_UPLEFT:
-    case PLAYER_A_DOWNRIGHT:
-    case PLAYER_A_DOWNLEFT:
-    case PLAYER_A_UPFIRE:
-    case PLAYER_A_RIGHTFIRE:
-    case PLAYER_A_LEFTFIRE:
-    case PLAYER_A_DOWNFIRE:
-    case PLAYER_A_UPRIGHTFIRE:
-    case PLAYER_A_UPLEFTFIRE:
-    case PLAYER_A_DOWNRIGHTFIRE:
-    case PLAYER_A_DOWNLEFTFIRE:
-      return true;
-    default:
-      return false;
-  }
-}
-
-/* reset the state of the game */
-void FrostbiteSettings::reset() {
-  m_reward = 0;
-  m_score = 0;
-  m_terminal = false;
-  m_lives = 4;
-}
-
-/* saves the state of the rom settings */
-void FrostbiteSettings::saveState(Serializer& ser) {
-  ser.putInt(m_reward);
-  ser.putInt(m_score);
-  ser.putBool(m_terminal);
-  ser.putInt(m_lives);
-}
-
-// loads the state of the rom settings
-void FrostbiteSettings::loadState(Deserializer& ser) {
-  m_reward = ser.getInt();
-  m_score = ser.getInt();
-  m_terminal = ser.getBool();
-  m_lives = ser.getInt();
-}
-
 // returns a list of mode that the game can be played in
 ModeVect FrostbiteSettings::getAvailableModes() {
   return {0, 2};
@@ -32,81 +32,35 @@
 namespace ale {
 using namespace stella;
 
-GopherSettings::GopherSettings() { reset(); }
+namespace {
+
+// Score in BCD at 0xB2-0xB0. The low three bits of 0xB4 are the carrots
+// left, which are the lives.
+constexpr GameSpec GopherSpec = [] {
+  GameSpec spec;
+  spec.score = bcdScore(6, 0xB2, 0xB1, 0xB0);
+  spec.lives.address = 0xB4;
+  spec.lives.mask = 0x7;
+  spec.lives.countBits = true;
+  spec.lives.initial = 3;
+  spec.terminal = {{{ramEquals(0xB4, 0, 0x7)}}};
+  spec.minimalActions = actionSet(
+      {PLAYER_A_NOOP, PLAYER_A_FIRE, PLAYER_A_UP, PLAYER_A_RIGHT, PLAYER_A_LEFT,
+       PLAYER_A_UPFIRE, PLAYER_A_RIGHTFIRE, PLAYER_A_LEFTFIRE});
+  // Gopher requires the fire action to start the game
+  spec.startingActions = {PLAYER_A_FIRE};
+  return spec;
+}();
+
+}  // namespace
+
+GopherSettings::GopherSettings() : GameSpecSettings(GopherSpec) {}
 
 /* create a new instance of the rom */
 RomSettings* GopherSettings::clone() const {
   return new GopherSettings(*this);
 }
 
-/* process the latest information from ALE */
-void GopherSettings::step(const System& system) {
-  // update the reward
-  int score = getDecimalScore(0xB2, 0xB1, 0xB0, &system);
-  int reward = score - m_score;
-  m_reward = reward;
-  m_score = score;
-
-  // update terminal status
-  int carrot_bits = readRam(&system, 0xB4) & 0x7;
-  m_terminal = carrot_bits == 0;
-
-  // A very crude popcount
-  static int livesFromCarrots[] = {0, 1, 1, 2, 1, 2, 2, 3};
-  m_lives = livesFromCarrots[carrot_bits];
-}
-
-/* is end of game */
-bool GopherSettings::isTerminal() const { return m_terminal; };
-
-/* get the most recently observed reward */
-reward_t GopherSettings::getReward() const { return m_reward; }
-
-/* is an action part of the minimal set? */
-bool GopherSettings::isMinimal(const Action& a) const {
-  switch (a) {
-    case PLAYER_A_NOOP:
-    case PLAYER_A_FIRE:
-    case PLAYER_A_UP:
-    case PLAYER_A_RIGHT:
-    case PLAYER_A_LEFT:
-    case PLAYER_A_UPFIRE:
-    case PLAYER_A_RIGHTFIRE:
-    case PLAYER_A_LEFTFIRE:
-      return true;
-    default:
-      return false;
-  }
-}
-
-/* reset the state of the game */
-void GopherSettings::reset() {
-  m_reward = 0;
-  m_score = 0;
-  m_terminal = false;
-  m_lives = 3;
-}
-
-/* saves the state of the rom settings */
-void GopherSettings::saveState(Serializer& ser) {
-  ser.putInt(m_reward);
-  ser.putInt(m_score);
-  ser.putBool(m_terminal);
-  ser.putInt(m_lives);
-}
-
-// loads the state of the rom settings
-void GopherSettings::loadState(Deserializer& ser) {
-  m_reward = ser.getInt();
-  m_score = ser.getInt();
-  m_terminal = ser.getBool();
-  m_lives = ser.getInt();
-}
-
-ActionVect GopherSettings::getStartingActions() {
-  return {PLAYER_A_FIRE};
-}
-
 // returns a list of mode that the game can be played in
 ModeVect GopherSettings::getAvailableModes() {
   return {0, 2};
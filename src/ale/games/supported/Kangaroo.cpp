@@ -32,85 +32,32 @@
 namespace ale {
 using namespace stella;
 
-KangarooSettings::KangarooSettings() { reset(); }
+namespace {
+
+// Score in hundreds, in BCD at 0xA8 and 0xA7; the low bits of 0xAD count
+// the spare lives, and 0xAD is 0xFF once the game is over.
+constexpr GameSpec KangarooSpec = [] {
+  GameSpec spec;
+  spec.score = bcdScore(4, 0xA8, 0xA7);
+  spec.scoreMultiplier = 100;
+  spec.lives.address = 0xAD;
+  spec.lives.mask = 0x7;
+  spec.lives.offset = 1;
+  spec.lives.initial = 3;
+  spec.terminal = {{{ramEquals(0xAD, 0xFF)}}};
+  spec.minimalActions = ALL_ACTIONS;
+  return spec;
+}();
+
+}  // namespace
+
+KangarooSettings::KangarooSettings() : GameSpecSettings(KangarooSpec) {}
 
 /* create a new instance of the rom */
 RomSettings* KangarooSettings::clone() const {
   return new KangarooSettings(*this);
 }
 
-/* process the latest information from ALE */
-void KangarooSettings::step(const System& system) {
-  // update the reward
-  int score = getDecimalScore(0xA8, 0xA7, &system);
-  score *= 100;
-  int reward = score - m_score;
-  m_reward = reward;
-  m_score = score;
-
-  // update terminal status
-  int lives_byte = readRam(&system, 0xAD);
-  m_terminal = (lives_byte == 0xFF);
-  m_lives = (lives_byte & 0x7) + 1;
-}
-
-/* is end of game */
-bool KangarooSettings::isTerminal() const { return m_terminal; };
-
-/* get the most recently observed reward */
-reward_t KangarooSettings::getReward() const { return m_reward; }
-
-/* is an action part of the minimal set? */
-bool KangarooSettings::isMinimal(const Action& a) const {
-  switch (a) {
-    case PLAYER_A_NOOP:
-    case PLAYER_A_FIRE:
-    case PLAYER_A_UP:
-    case PLAYER_A_RIGHT:
-    case PLAYER_A_LEFT:
-    case PLAYER_A_DOWN:
-    case PLAYER_A_UPRIGHT:
-    case PLAYER_A_UPLEFT:
-    case PLAYER_A_DOWNRIGHT:
-    case PLAYER_A_DOWNLEFT:
-    case PLAYER_A_UPFIRE:
-    case PLAYER_A_RIGHTFIRE:
-    case PLAYER_A_LEFTFIRE:
-    case PLAYER_A_DOWNFIRE:
-    case PLAYER_A_UPRIGHTFIRE:
-    case PLAYER_A_UPLEFTFIRE:
-    case PLAYER_A_DOWNRIGHTFIRE:
-    case PLAYER_A_DOWNLEFTFIRE:
-      return true;
-    default:
-      return false;
-  }
-}
-
-/* reset the state of the game */
-void KangarooSettings::reset() {
-  m_reward = 0;
-  m_score = 0;
-  m_terminal = false;
-  m_lives = 3;
-}
-
-/* saves the state of the rom settings */
-void KangarooSettings::saveState(Serializer& ser) {
-  ser.putInt(m_reward);
-  ser.putInt(m_score);
-  ser.putBool(m_terminal);
-  ser.putInt(m_lives);
-}
-
-// loads the state of the rom settings
-void KangarooSettings::loadState(Deserializer& ser) {
-  m_reward = ser.getInt();
-  m_score = ser.getInt();
-  m_terminal = ser.getBool();
-  m_lives = ser.getInt();
-}
-
 // returns a list of mode that the game can be played in
 ModeVect KangarooSettings::getAvailableModes() {
   return {0, 1};
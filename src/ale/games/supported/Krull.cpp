@@ -27,89 +27,32 @@
 
 #include "ale/games/supported/Krull.hpp"
 
-#include "ale/games/RomUtils.hpp"
-
 namespace ale {
 using namespace stella;
 
-KrullSettings::KrullSettings() { reset(); }
+namespace {
 
-/* create a new instance of the rom */
-RomSettings* KrullSettings::clone() const {
-  return new KrullSettings(*this);
-}
+// Score in BCD at 0x9E-0x9C; the low bits of 0x9F count the spare lives.
+constexpr GameSpec KrullSpec = [] {
+  GameSpec spec;
+  spec.score = bcdScore(6, 0x9E, 0x9D, 0x9C);
+  spec.lives.address = 0x9F;
+  spec.lives.mask = 0x7;
+  spec.lives.offset = 1;
+  spec.lives.initial = 3;
+  spec.terminal = {
+      {{ramEquals(0x9F, 0), ramEquals(0xA2, 0x03), ramEquals(0x80, 0x80)}}};
+  spec.minimalActions = ALL_ACTIONS;
+  return spec;
+}();
 
-/* process the latest information from ALE */
-void KrullSettings::step(const System& system) {
-  // update the reward
-  int score = getDecimalScore(0x9E, 0x9D, 0x9C, &system);
-  int reward = score - m_score;
-  m_reward = reward;
-  m_score = score;
+}  // namespace
 
-  // update terminal status
-  int lives = readRam(&system, 0x9F);
-  int byte1 = readRam(&system, 0xA2);
-  int byte2 = readRam(&system, 0x80);
-  m_terminal = lives == 0 && byte1 == 0x03 && byte2 == 0x80;
-  m_lives = (lives & 0x7) + 1;
-}
-
-/* is end of game */
-bool KrullSettings::isTerminal() const { return m_terminal; };
+KrullSettings::KrullSettings() : GameSpecSettings(KrullSpec) {}
 
-/* get the most recently observed reward */
-reward_t KrullSettings::getReward() const { return m_reward; }
-
-/* is an action part of the minimal set? */
-bool KrullSettings::isMinimal(const Action& a) const {
-  switch (a) {
-    case PLAYER_A_NOOP:
-    case PLAYER_A_FIRE:
-    case PLAYER_A_UP:
-    case PLAYER_A_RIGHT:
-    case PLAYER_A_LEFT:
-    case PLAYER_A_DOWN:
-    case PLAYER_A_UPRIGHT:
-    case PLAYER_A_UPLEFT:
-    case PLAYER_A_DOWNRIGHT:
-    case PLAYER_A_DOWNLEFT:
-    case PLAYER_A_UPFIRE:
-    case PLAYER_A_RIGHTFIRE:
-    case PLAYER_A_LEFTFIRE:
-    case PLAYER_A_DOWNFIRE:
-    case PLAYER_A_UPRIGHTFIRE:
-    case PLAYER_A_UPLEFTFIRE:
-    case PLAYER_A_DOWNRIGHTFIRE:
-    case PLAYER_A_DOWNLEFTFIRE:
-      return true;
-    default:
-      return false;
-  }
-}
-
-/* reset the state of the game */
-void KrullSettings::reset() {
-  m_reward = 0;
-  m_score = 0;
-  m_terminal = false;
-  m_lives = 3;
-}
-
-/* saves the state of the rom settings */
-void KrullSettings::saveState(Serializer& ser) {
-  ser.putInt(m_reward);
-  ser.putInt(m_score);
-  ser.putBool(m_terminal);
-  ser.putInt(m_lives);
-}
-
-// loads the state of the rom settings
-void KrullSettings::loadState(Deserializer& ser) {
-  m_reward = ser.getInt();
-  m_score = ser.getInt();
-  m_terminal = ser.getBool();
-  m_lives = ser.getInt();
+/* create a new instance of the rom */
+RomSettings* KrullSettings::clone() const {
+  return new KrullSettings(*this);
 }
 
 }  // namespace ale
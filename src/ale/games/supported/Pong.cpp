@@ -17,69 +17,31 @@
 namespace ale {
 using namespace stella;
 
-PongSettings::PongSettings() { reset(); }
+namespace {
+
+// The CPU (or player B) and player A scores are binary counters at 13 and
+// 14; the game is over when either reaches 21.
+constexpr GameSpec PongSpec = [] {
+  GameSpec spec;
+  spec.score = binaryScore(14);
+  spec.opponentScore = binaryScore(13);
+  spec.players = 2;
+  spec.terminal = {{{ramEquals(13, 21)}, {ramEquals(14, 21)}}};
+  spec.minimalActions =
+      actionSet({PLAYER_A_NOOP, PLAYER_A_FIRE, PLAYER_A_RIGHT, PLAYER_A_LEFT,
+                 PLAYER_A_RIGHTFIRE, PLAYER_A_LEFTFIRE});
+  return spec;
+}();
+
+}  // namespace
+
+PongSettings::PongSettings() : GameSpecSettings(PongSpec) {}
 
 /* create a new instance of the rom */
 RomSettings* PongSettings::clone() const {
   return new PongSettings(*this);
 }
 
-/* process the latest information from ALE */
-void PongSettings::step(const System& system) {
-  // update the reward
-  int x = readRam(&system, 13); // cpu score
-  int y = readRam(&system, 14); // player score
-  reward_t score = y - x;
-  m_reward = score - m_score;
-  m_score = score;
-
-  // update terminal status
-  // (game over when a player reaches 21)
-  m_terminal = x == 21 || y == 21;
-}
-
-/* is end of game */
-bool PongSettings::isTerminal() const { return m_terminal; };
-
-/* get the most recently observed reward */
-reward_t PongSettings::getReward() const { return m_reward; }
-
-/* is an action part of the minimal set? */
-bool PongSettings::isMinimal(const Action& a) const {
-  switch (a) {
-    case PLAYER_A_NOOP:
-    case PLAYER_A_FIRE:
-    case PLAYER_A_RIGHT:
-    case PLAYER_A_LEFT:
-    case PLAYER_A_RIGHTFIRE:
-    case PLAYER_A_LEFTFIRE:
-      return true;
-    default:
-      return false;
-  }
-}
-
-/* reset the state of the game */
-void PongSettings::reset() {
-  m_reward = 0;
-  m_score = 0;
-  m_terminal = false;
-}
-
-/* saves the state of the rom settings */
-void PongSettings::saveState(Serializer& ser) {
-  ser.putInt(m_reward);
-  ser.putInt(m_score);
-  ser.putBool(m_terminal);
-}
-
-// loads the state of the rom settings
-void PongSettings::loadState(Deserializer& ser) {
-  m_reward = ser.getInt();
-  m_score = ser.getInt();
-  m_terminal = ser.getBool();
-}
-
 // returns a list of mode that the game can be played in
 ModeVect PongSettings::getAvailableModes() {
   ModeVect modes(getNumModes());
@@ -28,24 +28,15 @@
 #ifndef __PONG_HPP__
 #define __PONG_HPP__
 
-#include "ale/games/RomSettings.hpp"
+#include "ale/games/GameSpec.hpp"
 
 namespace ale {
 
 /* RL wrapper for Pong */
-class PongSettings : public RomSettings {
+class PongSettings : public GameSpecSettings {
  public:
   PongSettings();
 
-  // reset
-  void reset() override;
-
-  // is end of game
-  bool isTerminal() const override;
-
-  // get the most recently observed reward
-  reward_t getReward() const override;
-
   // the rom-name
   const char* rom() const override { return "pong"; }
 
@@ -58,20 +49,6 @@ class PongSettings : public RomSettings {
   // create a new instance of the rom
   RomSettings* clone() const override;
 
-  // is an action part of the minimal set?
-  bool isMinimal(const Action& a) const override;
-
-  // process the latest information from ALE
-  void step(const stella::System& system) override;
-
-  // saves the state of the rom settings
-  void saveState(stella::Serializer& ser) override;
-
-  // loads the state of the rom settings
-  void loadState(stella::Deserializer& ser) override;
-
-  int lives() override { return 0; }
-
   // returns a list of difficulties that the game can be played in
   // in this game, there are 2 available difficulties
   DifficultyVect getAvailableDifficulties() override;
@@ -84,11 +61,6 @@ class PongSettings : public RomSettings {
   // the given mode must be one returned by the previous function
   void setMode(game_mode_t, stella::System& system,
                std::unique_ptr<StellaEnvironmentWrapper> environment) override;
-
- private:
-  bool m_terminal;
-  reward_t m_reward;
-  reward_t m_score;
 };
 
 }  // namespace ale
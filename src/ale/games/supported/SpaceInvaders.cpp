@@ -34,79 +34,32 @@ using namespace stella;
 
 ActionVect SpaceInvadersSettings::actions;
 
-SpaceInvadersSettings::SpaceInvadersSettings() { reset(); }
+namespace {
+
+// Score in BCD at 0xE8 and 0xE6, rolling over at 10000; lives at 0xC9.
+// Bit 7 of 0x98 is set when the game is over.
+constexpr GameSpec SpaceInvadersSpec = [] {
+  GameSpec spec;
+  spec.score = bcdScore(4, 0xE8, 0xE6);
+  spec.scoreWrap = 10000;
+  spec.lives.address = 0xC9;
+  spec.lives.initial = 3;
+  spec.terminal = {{{ramNotEquals(0x98, 0, 0x80)}, {ramEquals(0xC9, 0)}}};
+  spec.minimalActions =
+      actionSet({PLAYER_A_NOOP, PLAYER_A_LEFT, PLAYER_A_RIGHT, PLAYER_A_FIRE,
+                 PLAYER_A_LEFTFIRE, PLAYER_A_RIGHTFIRE});
+  return spec;
+}();
+
+}  // namespace
+
+SpaceInvadersSettings::SpaceInvadersSettings() : GameSpecSettings(SpaceInvadersSpec) {}
 
 /* create a new instance of the rom */
 RomSettings* SpaceInvadersSettings::clone() const {
   return new SpaceInvadersSettings(*this);
 }
 
-/* process the latest information from ALE */
-void SpaceInvadersSettings::step(const System& system) {
-  // update the reward
-  int score = getDecimalScore(0xE8, 0xE6, &system);
-  // reward cannot get negative in this game. When it does, it means that the score has looped
-  // (overflow)
-  m_reward = score - m_score;
-  if (m_reward < 0) {
-    // 10000 is the highest possible score
-    const int maximumScore = 10000;
-    m_reward = (maximumScore - m_score) + score;
-  }
-  m_score = score;
-  m_lives = readRam(&system, 0xC9);
-
-  // update terminal status
-  // If bit 0x80 is on, then game is over
-  int some_byte = readRam(&system, 0x98);
-  m_terminal = (some_byte & 0x80) || m_lives == 0;
-}
-
-/* is end of game */
-bool SpaceInvadersSettings::isTerminal() const { return m_terminal; };
-
-/* get the most recently observed reward */
-reward_t SpaceInvadersSettings::getReward() const { return m_reward; }
-
-/* is an action part of the minimal set? */
-bool SpaceInvadersSettings::isMinimal(const Action& a) const {
-  switch (a) {
-    case PLAYER_A_NOOP:
-    case PLAYER_A_LEFT:
-    case PLAYER_A_RIGHT:
-    case PLAYER_A_FIRE:
-    case PLAYER_A_LEFTFIRE:
-    case PLAYER_A_RIGHTFIRE:
-      return true;
-    default:
-      return false;
-  }
-}
-
-/* reset the state of the game */
-void SpaceInvadersSettings::reset() {
-  m_reward = 0;
-  m_score = 0;
-  m_terminal = false;
-  m_lives = 3;
-}
-
-/* saves the state of the rom settings */
-void SpaceInvadersSettings::saveState(Serializer& ser) {
-  ser.putInt(m_reward);
-  ser.putInt(m_score);
-  ser.putBool(m_terminal);
-  ser.putInt(m_lives);
-}
-
-// loads the state of the rom settings
-void SpaceInvadersSettings::loadState(Deserializer& ser) {
-  m_reward = ser.getInt();
-  m_score = ser.getInt();
-  m_terminal = ser.getBool();
-  m_lives = ser.getInt();
-}
-
 // returns a list of mode that the game can be played in
 ModeVect SpaceInvadersSettings::getAvailableModes() {
   ModeVect modes(getNumModes());
@@ -28,24 +28,15 @@
 #ifndef __SPACEINVADERS_HPP__
 #define __SPACEINVADERS_HPP__
 
-#include "ale/games/RomSettings.hpp"
+#include "ale/games/GameSpec.hpp"
 
 namespace ale {
 
 // RL wrapper for SpaceInvaders
-class SpaceInvadersSettings : public RomSettings {
+class SpaceInvadersSettings : public GameSpecSettings {
  public:
   SpaceInvadersSettings();
 
-  // reset
-  void reset() override;
-
-  // is end of game
-  bool isTerminal() const override;
-
-  // get the most recently observed reward
-  reward_t getReward() const override;
-
   // the rom-name
   const char* rom() const override { return "space_invaders"; }
 
@@ -58,20 +49,6 @@ class SpaceInvadersSettings : public RomSettings {
   // create a new instance of the rom
   RomSettings* clone() const override;
 
-  // is an action part of the minimal set?
-  bool isMinimal(const Action& a) const override;
-
-  // process the latest information from ALE
-  void step(const stella::System& system) override;
-
-  // saves the state of the rom settings
-  void saveState(stella::Serializer& ser) override;
-
-  // loads the state of the rom settings
-  void loadState(stella::Deserializer& ser) override;
-
-  int lives() override { return isTerminal() ? 0 : m_lives; }
-
   // returns a list of mode that the game can be played in
   // in this game, there are 16 available modes
   ModeVect getAvailableModes() override;
@@ -86,11 +63,6 @@ class SpaceInvadersSettings : public RomSettings {
   DifficultyVect getAvailableDifficulties() override;
 
  private:
-  bool m_terminal;
-  reward_t m_reward;
-  reward_t m_score;
-  int m_lives;
-
   static ActionVect actions;
 };
 
@@ -48,6 +48,13 @@ class SurroundSettings : public RomSettings {
   // get the most recently observed reward
   reward_t getReward() const override;
 
+  // two players: player B's reward is the opposite of player A's
+  int numPlayers() const override { return 2; }
+  void getRewards(reward_t* rewards) const override {
+    rewards[0] = m_reward;
+    rewards[1] = -m_reward;
+  }
+
   // the rom-name
   const char* rom() const override { return "surround"; }
 
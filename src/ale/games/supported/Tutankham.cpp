@@ -32,78 +32,32 @@
 namespace ale {
 using namespace stella;
 
-TutankhamSettings::TutankhamSettings() { reset(); }
+namespace {
+
+// Score in BCD at 0x9C and 0x9A; lives in the low bits of 0x9E. Byte 0x81
+// is set to 0x84 when the game is loaded, but not reset.
+constexpr GameSpec TutankhamSpec = [] {
+  GameSpec spec;
+  spec.score = bcdScore(4, 0x9C, 0x9A);
+  spec.lives.address = 0x9E;
+  spec.lives.mask = 0x3;
+  spec.lives.initial = 3;
+  spec.terminal = {{{ramEquals(0x9E, 0), ramNotEquals(0x81, 0x84)}}};
+  spec.minimalActions = actionSet(
+      {PLAYER_A_NOOP, PLAYER_A_UP, PLAYER_A_RIGHT, PLAYER_A_LEFT, PLAYER_A_DOWN,
+       PLAYER_A_UPFIRE, PLAYER_A_RIGHTFIRE, PLAYER_A_LEFTFIRE});
+  return spec;
+}();
+
+}  // namespace
+
+TutankhamSettings::TutankhamSettings() : GameSpecSettings(TutankhamSpec) {}
 
 /* create a new instance of the rom */
 RomSettings* TutankhamSettings::clone() const {
   return new TutankhamSettings(*this);
 }
 
-/* process the latest information from ALE */
-void TutankhamSettings::step(const System& system) {
-  // update the reward
-  int score = getDecimalScore(0x9C, 0x9A, &system);
-  int reward = score - m_score;
-  m_reward = reward;
-  m_score = score;
-
-  // update terminal status
-  int lives_byte = readRam(&system, 0x9E);
-  // byte 0x81 is set to 0x84 when the game is loaded, but not reset
-  int some_byte = readRam(&system, 0x81);
-
-  m_terminal = lives_byte == 0 && some_byte != 0x84;
-
-  m_lives = (lives_byte & 0x3);
-}
-
-/* is end of game */
-bool TutankhamSettings::isTerminal() const { return m_terminal; };
-
-/* get the most recently observed reward */
-reward_t TutankhamSettings::getReward() const { return m_reward; }
-
-/* is an action part of the minimal set? */
-bool TutankhamSettings::isMinimal(const Action& a) const {
-  switch (a) {
-    case PLAYER_A_NOOP:
-    case PLAYER_A_UP:
-    case PLAYER_A_RIGHT:
-    case PLAYER_A_LEFT:
-    case PLAYER_A_DOWN:
-    case PLAYER_A_UPFIRE:
-    case PLAYER_A_RIGHTFIRE:
-    case PLAYER_A_LEFTFIRE:
-      return true;
-    default:
-      return false;
-  }
-}
-
-/* reset the state of the game */
-void TutankhamSettings::reset() {
-  m_reward = 0;
-  m_score = 0;
-  m_terminal = false;
-  m_lives = 3;
-}
-
-/* saves the state of the rom settings */
-void TutankhamSettings::saveState(Serializer& ser) {
-  ser.putInt(m_reward);
-  ser.putInt(m_score);
-  ser.putBool(m_terminal);
-  ser.putInt(m_lives);
-}
-
-// loads the state of the rom settings
-void TutankhamSettings::loadState(Deserializer& ser) {
-  m_reward = ser.getInt();
-  m_score = ser.getInt();
-  m_terminal = ser.getBool();
-  m_lives = ser.getInt();
-}
-
 // returns a list of mode that the game can be played in
 ModeVect TutankhamSettings::getAvailableModes() {
   return {0, 4, 8, 12};
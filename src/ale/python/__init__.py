@@ -46,14 +46,32 @@ except metadata.PackageNotFoundError:
 
 # Import native shared library
 from ale_py._ale_py import (  # noqa: E402
+    PERF_STATS,
     SDL_SUPPORT,
     Action,
+    ALEAsyncBatch,
+    ALEBatch,
+    ALEEnvPool,
     ALEInterface,
+    ALERolloutPool,
     ALEState,
     LoggerMode,
+    PerfStats,
 )
 
-__all__ = ["Action", "ALEInterface", "ALEState", "LoggerMode", "SDL_SUPPORT"]
+__all__ = [
+    "Action",
+    "ALEAsyncBatch",
+    "ALEBatch",
+    "ALEEnvPool",
+    "ALEInterface",
+    "ALERolloutPool",
+    "ALEState",
+    "LoggerMode",
+    "PerfStats",
+    "PERF_STATS",
+    "SDL_SUPPORT",
+]
 
 
 try:
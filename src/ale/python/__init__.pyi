@@ -1,5 +1,5 @@
 import os
-from typing import List, Optional, overload
+from typing import List, Optional, Tuple, overload
 
 import numpy as np
 import numpy.typing as npt
@@ -7,9 +7,14 @@ from ale_py import _ale_py
 
 __all__ = [
     "Action",
+    "ALEAsyncBatch",
+    "ALEBatch",
+    "ALEEnvPool",
     "ALEInterface",
     "ALEState",
     "LoggerMode",
+    "PerfStats",
+    "PERF_STATS",
     "SDL_SUPPORT",
 ]
 
@@ -99,34 +104,76 @@ class ALEState:
     __hash__ = None  # type: ignore
     pass
 
+class PerfStats:
+    enabled: bool
+    @property
+    def act_ns(self) -> int: ...
+    @property
+    def reset_ns(self) -> int: ...
+    @property
+    def hooks_ns(self) -> int: ...
+    @property
+    def emulate_ns(self) -> int: ...
+    @property
+    def rom_step_ns(self) -> int: ...
+    @property
+    def screen_ns(self) -> int: ...
+    @property
+    def ram_ns(self) -> int: ...
+    @property
+    def frames(self) -> int: ...
+    @property
+    def instructions(self) -> int: ...
+    @property
+    def tia_pokes(self) -> int: ...
+    @property
+    def tia_clocks(self) -> int: ...
+    pass
+
 class ALEInterface:
     def __init__(self) -> None: ...
     @overload
     def act(self, action: Action, paddle_strength: float = 1.0) -> int: ...
     @overload
     def act(self, action: int, paddle_strength: float = 1.0) -> int: ...
+    @overload
+    def act(
+        self, actions: npt.ArrayLike, paddle_strengths: npt.ArrayLike = ...
+    ) -> npt.NDArray[np.int32]: ...
     def cloneState(self, *, include_rng: bool = False) -> ALEState: ...
     def cloneSystemState(self) -> ALEState: ...
     def game_over(self, *, with_truncation: bool = True) -> bool: ...
     def game_truncated(self) -> bool: ...
+    def getAudio(self) -> npt.NDArray[np.uint8]: ...
+    def getAudioView(self) -> npt.NDArray[np.uint8]: ...
     def getAvailableDifficulties(self) -> List[int]: ...
     def getAvailableModes(self) -> List[int]: ...
     def getBool(self, key: str) -> bool: ...
+    def getCycleCount(self) -> int: ...
+    def getEmulatedFrameCount(self) -> int: ...
     def getEpisodeFrameNumber(self) -> int: ...
     def getFloat(self, key: str) -> float: ...
     def getFrameNumber(self) -> int: ...
+    def getInstructionCount(self) -> int: ...
     def getInt(self, key: str) -> int: ...
     def getLegalActionSet(self) -> List[Action]: ...
     def getMinimalActionSet(self) -> List[Action]: ...
+    def getMaxPlayers(self) -> int: ...
+    def getNumPlayers(self) -> int: ...
+    def getObservationGeneration(self) -> int: ...
+    def getPaletteRGB(self) -> npt.NDArray[np.uint8]: ...
+    def getPerfStats(self) -> PerfStats: ...
     @overload
     def getRAM(self) -> npt.NDArray[np.uint8]: ...
     @overload
     def getRAM(self, arg0: npt.NDArray[np.uint8]) -> None: ...
     def getRAMSize(self) -> int: ...
+    def getRAMView(self) -> npt.NDArray[np.uint8]: ...
     @overload
     def getScreen(self) -> npt.NDArray[np.uint8]: ...
     @overload
     def getScreen(self, array: npt.NDArray[np.uint8]) -> None: ...
+    def getScanlinesPerFrame(self) -> int: ...
     def getScreenDims(self) -> tuple: ...
     @overload
     def getScreenGrayscale(self) -> npt.NDArray[np.uint8]: ...
@@ -136,6 +183,7 @@ class ALEInterface:
     def getScreenRGB(self) -> npt.NDArray[np.uint8]: ...
     @overload
     def getScreenRGB(self, array: npt.NDArray[np.uint8]) -> None: ...
+    def getScreenView(self) -> npt.NDArray[np.uint8]: ...
     def getString(self, key: str) -> str: ...
     @staticmethod
     @overload
@@ -148,9 +196,20 @@ class ALEInterface:
     def loadROM(self, rom: os.PathLike) -> None: ...
     @overload
     def loadROM(self, rom: str) -> None: ...
+    def resetPerfStats(self) -> None: ...
     def reset_game(self) -> None: ...
     def restoreState(self, state: ALEState) -> None: ...
     def restoreSystemState(self, state: ALEState) -> None: ...
+    def rollout(
+        self,
+        state: ALEState,
+        actions: npt.ArrayLike,
+        *,
+        stop_on_terminal: bool = True,
+        clone_final_state: bool = True,
+        include_rng: bool = False,
+        paddle_strength: float = 1.0,
+    ) -> Tuple[npt.NDArray[np.int32], bool, Optional[ALEState]]: ...
     def saveScreenPNG(self, path: str) -> None: ...
     def setBool(self, key: str, value: bool) -> None: ...
     def setDifficulty(self, difficulty: int) -> None: ...
@@ -161,7 +220,85 @@ class ALEInterface:
     def setMode(self, mode: int) -> None: ...
     def setRAM(self, index: int, value: int) -> None: ...
     def setString(self, key: str, value: str) -> None: ...
+    def stateHash(self) -> int: ...
+    pass
+
+class ALEBatch:
+    def __init__(
+        self, envs: List[ALEInterface], obs_type: str = "rgb", autoreset: bool = False
+    ) -> None: ...
+    def __len__(self) -> int: ...
+    def getObservationShape(self) -> tuple: ...
+    def getPaletteRGB(self) -> npt.NDArray[np.uint8]: ...
+    def reset(self, out_obs: npt.NDArray[np.uint8]) -> None: ...
+    def step(
+        self,
+        actions: npt.ArrayLike,
+        out_obs: npt.NDArray[np.uint8],
+        out_rewards: npt.NDArray[np.int32],
+        out_dones: npt.NDArray[np.bool_],
+    ) -> None: ...
+    pass
+
+class ALEAsyncBatch:
+    def __init__(
+        self,
+        envs: List[ALEInterface],
+        obs_type: str = "rgb",
+        autoreset: bool = False,
+        num_threads: int = 0,
+    ) -> None: ...
+    def __len__(self) -> int: ...
+    def getObservationShape(self) -> tuple: ...
+    def getPaletteRGB(self) -> npt.NDArray[np.uint8]: ...
+    def reset(self) -> npt.NDArray[np.uint8]: ...
+    def step_async(self, actions: npt.ArrayLike) -> None: ...
+    def step_wait(
+        self,
+    ) -> Tuple[npt.NDArray[np.uint8], npt.NDArray[np.int32], npt.NDArray[np.bool_]]: ...
+    pass
+
+class ALEEnvPool:
+    def __init__(
+        self,
+        envs: List[ALEInterface],
+        batch_size: int = 0,
+        obs_type: str = "rgb",
+        autoreset: bool = True,
+        num_threads: int = 0,
+    ) -> None: ...
+    def __len__(self) -> int: ...
+    @property
+    def batch_size(self) -> int: ...
+    def getObservationShape(self) -> tuple: ...
+    def getPaletteRGB(self) -> npt.NDArray[np.uint8]: ...
+    def async_reset(self) -> None: ...
+    def send(self, actions: npt.ArrayLike, env_ids: npt.ArrayLike) -> None: ...
+    def recv(
+        self,
+    ) -> Tuple[
+        npt.NDArray[np.uint8],
+        npt.NDArray[np.int32],
+        npt.NDArray[np.bool_],
+        npt.NDArray[np.int32],
+    ]: ...
+    pass
+
+class ALERolloutPool:
+    def __init__(self, envs: List[ALEInterface], num_threads: int = 0) -> None: ...
+    def __len__(self) -> int: ...
+    def rollout(
+        self,
+        state: ALEState,
+        sequences: List[List[int]],
+        *,
+        stop_on_terminal: bool = True,
+        clone_final_state: bool = True,
+        include_rng: bool = False,
+        paddle_strength: float = 1.0,
+    ) -> List[Tuple[npt.NDArray[np.int32], bool, Optional[ALEState]]]: ...
     pass
 
+PERF_STATS: bool
 SDL_SUPPORT: bool
 __version__: str
@@ -160,6 +160,12 @@ ALEPythonInterface::getScreenGrayscale() {
   return buffer;
 }
 
+py::array_t<uint8_t, py::array::c_style> ALEPythonInterface::getPaletteRGB() {
+  std::vector<unsigned char> palette;
+  ALEInterface::getPaletteRGB(palette);
+  return paletteToArray(palette);
+}
+
 const py::array_t<uint8_t, py::array::c_style> ALEPythonInterface::getRAM() {
   const ALERAM& ram = ALEInterface::getRAM();
 
@@ -189,4 +195,350 @@ void ALEPythonInterface::getRAM(
   std::copy(ram.array(), ram.array() + ram.size(), dst);
 }
 
+py::array ALEPythonInterface::environmentView(
+    const uint8_t* data, const std::vector<py::ssize_t>& shape) const {
+  // The capsule shares ownership of the environment holding the data
+  py::capsule owner(new std::shared_ptr<StellaEnvironment>(environment),
+                    [](void* env) {
+                      delete static_cast<std::shared_ptr<StellaEnvironment>*>(env);
+                    });
+  py::array_t<uint8_t> view(shape, data, owner);
+  view.attr("flags").attr("writeable") = false;
+  return view;
+}
+
+py::array ALEPythonInterface::getScreenView() {
+  if (environment == nullptr) {
+    throw std::runtime_error("ROM not set");
+  }
+  const ALEScreen& screen = ALEInterface::getScreen();
+  return environmentView(screen.getArray(),
+                         {(py::ssize_t)screen.height(), (py::ssize_t)screen.width()});
+}
+
+py::array ALEPythonInterface::getRAMView() {
+  if (environment == nullptr) {
+    throw std::runtime_error("ROM not set");
+  }
+  const ALERAM& ram = ALEInterface::getRAM();
+  return environmentView(ram.array(), {(py::ssize_t)ram.size()});
+}
+
+py::array_t<uint8_t, py::array::c_style> ALEPythonInterface::getAudio() {
+  const std::vector<uint8_t>& audio = ALEInterface::getAudio();
+  return py::array_t<uint8_t, py::array::c_style>(audio.size(), audio.data());
+}
+
+py::array ALEPythonInterface::getAudioView() {
+  const std::vector<uint8_t>& audio = ALEInterface::getAudio();
+  return environmentView(audio.data(), {(py::ssize_t)audio.size()});
+}
+
+py::array_t<reward_t> ALEPythonInterface::act(
+    py::array_t<int32_t, py::array::c_style | py::array::forcecast> actions,
+    py::array_t<float, py::array::c_style | py::array::forcecast>
+        paddle_strengths) {
+  if (actions.ndim() != 1 || paddle_strengths.ndim() > 1) {
+    throw std::runtime_error("actions must be one-dimensional.");
+  }
+  const int32_t* action_data = actions.data();
+  ActionVect action_vect(actions.shape(0));
+  for (size_t i = 0; i < action_vect.size(); i++) {
+    action_vect[i] = toAction(action_data[i]);
+  }
+  std::vector<float> strengths(paddle_strengths.data(),
+                               paddle_strengths.data() + paddle_strengths.size());
+
+  const std::vector<reward_t> rewards = ALEInterface::act(action_vect, strengths);
+  py::array_t<reward_t> result(rewards.size());
+  std::copy(rewards.begin(), rewards.end(), result.mutable_data());
+  return result;
+}
+
+py::tuple ALEPythonInterface::rollout(
+    const ALEState& state,
+    py::array_t<int32_t, py::array::c_style | py::array::forcecast> actions,
+    bool stop_on_terminal, bool clone_final_state, bool include_rng,
+    float paddle_strength) {
+  if (actions.ndim() != 1) {
+    throw std::runtime_error("actions must be one-dimensional.");
+  }
+  const int32_t* action_data = actions.data();
+  ActionVect action_vect(actions.shape(0));
+  for (size_t t = 0; t < action_vect.size(); t++) {
+    action_vect[t] = toAction(action_data[t]);
+  }
+  RolloutOptions options = makeRolloutOptions(
+      stop_on_terminal, clone_final_state, include_rng, paddle_strength);
+
+  RolloutResult result;
+  {
+    py::gil_scoped_release release;
+    result = ALEInterface::rollout(state, action_vect, options);
+  }
+  return rolloutResultToPython(result, options);
+}
+
+RolloutOptions makeRolloutOptions(bool stop_on_terminal, bool clone_final_state,
+                                  bool include_rng, float paddle_strength) {
+  RolloutOptions options;
+  options.stop_on_terminal = stop_on_terminal;
+  options.clone_final_state = clone_final_state;
+  options.include_rng = include_rng;
+  options.paddle_strength = paddle_strength;
+  return options;
+}
+
+py::tuple rolloutResultToPython(RolloutResult& result,
+                                const RolloutOptions& options) {
+  py::array_t<reward_t> rewards(result.rewards.size(), result.rewards.data());
+  py::object state = py::none();
+  if (options.clone_final_state) {
+    state = py::cast(std::move(result.state));
+  }
+  return py::make_tuple(rewards, result.terminal, state);
+}
+
+ObsType parseObsType(const std::string& obs_type) {
+  if (obs_type == "rgb") return ObsType::RGB;
+  if (obs_type == "grayscale") return ObsType::Grayscale;
+  if (obs_type == "ram") return ObsType::RAM;
+  if (obs_type == "indexed") return ObsType::Indexed;
+  throw std::runtime_error("Invalid obs_type '" + obs_type +
+                           "', expecting one of rgb, grayscale, ram or indexed.");
+}
+
+py::array_t<uint8_t, py::array::c_style> paletteToArray(
+    const std::vector<uint8_t>& palette) {
+  py::array_t<uint8_t, py::array::c_style> array({256, 3});
+  std::copy(palette.begin(), palette.end(), array.mutable_data());
+  return array;
+}
+
+std::vector<ALEInterface*>
+unwrapInterfaces(const std::vector<py::object>& envs) {
+  std::vector<ALEInterface*> interfaces;
+  interfaces.reserve(envs.size());
+  for (const py::object& env : envs) {
+    interfaces.push_back(env.cast<ALEPythonInterface*>());
+  }
+  return interfaces;
+}
+
+Action toAction(int32_t action) {
+  if (action < 0 || action >= PLAYER_A_MAX) {
+    throw py::value_error("Invalid action " + std::to_string(action) +
+                          ", expecting an integer in [0, " +
+                          std::to_string(PLAYER_A_MAX) + ").");
+  }
+  return (Action)action;
+}
+
+void checkBatchShape(const py::array& array, size_t batch_size,
+                     const std::vector<size_t>& trailing, const char* name) {
+  bool valid = array.ndim() == (py::ssize_t)(trailing.size() + 1) &&
+               array.shape(0) == (py::ssize_t)batch_size;
+  for (size_t d = 0; valid && d < trailing.size(); d++) {
+    valid = array.shape(d + 1) == (py::ssize_t)trailing[d];
+  }
+
+  if (!valid) {
+    std::stringstream msg;
+    msg << "Invalid shape for " << name << ", expecting shape (" << batch_size;
+    for (size_t dim : trailing) msg << ", " << dim;
+    msg << (trailing.empty() ? ",)" : ")");
+    throw std::runtime_error(msg.str());
+  }
+}
+
+ALEPythonBatch::ALEPythonBatch(const std::vector<py::object>& envs,
+                               const std::string& obs_type, bool autoreset)
+    : ALEBatch(unwrapInterfaces(envs), parseObsType(obs_type), autoreset),
+      m_env_refs(envs),
+      m_actions(envs.size()) {}
+
+void ALEPythonBatch::step(
+    py::array_t<int32_t, py::array::c_style | py::array::forcecast> actions,
+    py::array_t<uint8_t, py::array::c_style>& obs,
+    py::array_t<reward_t, py::array::c_style>& rewards,
+    py::array_t<bool, py::array::c_style>& dones) {
+  checkBatchShape(actions, size(), {}, "actions");
+  checkBatchShape(obs, size(), observationShape(), "out_obs");
+  checkBatchShape(rewards, size(), {}, "out_rewards");
+  checkBatchShape(dones, size(), {}, "out_dones");
+
+  const int32_t* action_data = actions.data();
+  for (size_t i = 0; i < size(); i++) {
+    m_actions[i] = toAction(action_data[i]);
+  }
+  uint8_t* obs_data = obs.mutable_data();
+  reward_t* reward_data = rewards.mutable_data();
+  bool* done_data = dones.mutable_data();
+
+  py::gil_scoped_release release;
+  ALEBatch::step(m_actions.data(), obs_data, reward_data, done_data);
+}
+
+void ALEPythonBatch::reset(py::array_t<uint8_t, py::array::c_style>& obs) {
+  checkBatchShape(obs, size(), observationShape(), "out_obs");
+  uint8_t* obs_data = obs.mutable_data();
+
+  py::gil_scoped_release release;
+  ALEBatch::reset(obs_data);
+}
+
+py::tuple ALEPythonBatch::getObservationShape() const {
+  return py::tuple(py::cast(observationShape()));
+}
+
+py::array_t<uint8_t, py::array::c_style> ALEPythonBatch::getPaletteRGB() const {
+  return paletteToArray(palette());
+}
+
+ALEPythonAsyncBatch::ALEPythonAsyncBatch(const std::vector<py::object>& envs,
+                                         const std::string& obs_type,
+                                         bool autoreset, size_t num_threads)
+    : PythonEnvRefs(envs),
+      ALEAsyncBatch(unwrapInterfaces(envs), parseObsType(obs_type), autoreset,
+                    num_threads),
+      m_actions(envs.size()) {}
+
+py::array ALEPythonAsyncBatch::observationView(const uint8_t* obs,
+                                               py::handle owner) const {
+  std::vector<py::ssize_t> shape = {(py::ssize_t)size()};
+  for (size_t dim : batch().observationShape()) shape.push_back(dim);
+
+  py::array_t<uint8_t> view(shape, obs, owner);
+  view.attr("flags").attr("writeable") = false;
+  return view;
+}
+
+py::array ALEPythonAsyncBatch::reset(py::handle owner) {
+  Result result;
+  {
+    py::gil_scoped_release release;
+    result = ALEAsyncBatch::reset();
+  }
+  return observationView(result.obs, owner);
+}
+
+void ALEPythonAsyncBatch::stepAsync(
+    py::array_t<int32_t, py::array::c_style | py::array::forcecast> actions) {
+  checkBatchShape(actions, size(), {}, "actions");
+
+  const int32_t* action_data = actions.data();
+  for (size_t i = 0; i < size(); i++) {
+    m_actions[i] = toAction(action_data[i]);
+  }
+  ALEAsyncBatch::stepAsync(m_actions.data());
+}
+
+py::tuple ALEPythonAsyncBatch::stepWait(py::handle owner) {
+  Result result;
+  {
+    py::gil_scoped_release release;
+    result = ALEAsyncBatch::stepWait();
+  }
+
+  py::array_t<reward_t> rewards({(py::ssize_t)size()}, result.rewards, owner);
+  py::array_t<bool> dones({(py::ssize_t)size()}, result.dones, owner);
+  rewards.attr("flags").attr("writeable") = false;
+  dones.attr("flags").attr("writeable") = false;
+  return py::make_tuple(observationView(result.obs, owner), rewards, dones);
+}
+
+py::tuple ALEPythonAsyncBatch::getObservationShape() const {
+  return py::tuple(py::cast(batch().observationShape()));
+}
+
+py::array_t<uint8_t, py::array::c_style> ALEPythonAsyncBatch::getPaletteRGB() const {
+  return paletteToArray(batch().palette());
+}
+
+ALEPythonEnvPool::ALEPythonEnvPool(const std::vector<py::object>& envs,
+                                   size_t batch_size,
+                                   const std::string& obs_type, bool autoreset,
+                                   size_t num_threads)
+    : PythonEnvRefs(envs),
+      ALEEnvPool(unwrapInterfaces(envs), batch_size, parseObsType(obs_type),
+                 autoreset, num_threads) {}
+
+void ALEPythonEnvPool::send(
+    py::array_t<int32_t, py::array::c_style | py::array::forcecast> actions,
+    py::array_t<int32_t, py::array::c_style | py::array::forcecast> env_ids) {
+  if (actions.ndim() != 1 || env_ids.ndim() != 1 ||
+      actions.shape(0) != env_ids.shape(0)) {
+    throw std::runtime_error(
+        "actions and env_ids must be one-dimensional and of equal length.");
+  }
+
+  const int32_t* action_data = actions.data();
+  m_actions.resize(actions.shape(0));
+  for (size_t k = 0; k < m_actions.size(); k++) {
+    m_actions[k] = toAction(action_data[k]);
+  }
+  ALEEnvPool::send(m_actions.data(), env_ids.data(), m_actions.size());
+}
+
+py::tuple ALEPythonEnvPool::recv(py::handle owner) {
+  Result result;
+  {
+    py::gil_scoped_release release;
+    result = ALEEnvPool::recv();
+  }
+
+  std::vector<py::ssize_t> shape = {(py::ssize_t)result.size};
+  for (size_t dim : batch().observationShape()) shape.push_back(dim);
+
+  py::array_t<uint8_t> obs(shape, result.obs, owner);
+  py::array_t<reward_t> rewards({(py::ssize_t)result.size}, result.rewards, owner);
+  py::array_t<bool> dones({(py::ssize_t)result.size}, result.dones, owner);
+  py::array_t<int32_t> env_ids({(py::ssize_t)result.size}, result.env_ids, owner);
+  for (py::handle array : {obs, rewards, dones, env_ids}) {
+    array.attr("flags").attr("writeable") = false;
+  }
+  return py::make_tuple(obs, rewards, dones, env_ids);
+}
+
+py::tuple ALEPythonEnvPool::getObservationShape() const {
+  return py::tuple(py::cast(batch().observationShape()));
+}
+
+py::array_t<uint8_t, py::array::c_style> ALEPythonEnvPool::getPaletteRGB() const {
+  return paletteToArray(batch().palette());
+}
+
+ALEPythonRolloutPool::ALEPythonRolloutPool(const std::vector<py::object>& envs,
+                                           size_t num_threads)
+    : ALERolloutPool(unwrapInterfaces(envs), num_threads), m_env_refs(envs) {}
+
+py::list ALEPythonRolloutPool::rollout(
+    const ALEState& root, const std::vector<std::vector<int32_t>>& sequences,
+    bool stop_on_terminal, bool clone_final_state, bool include_rng,
+    float paddle_strength) {
+  std::vector<ActionVect> action_sequences;
+  action_sequences.reserve(sequences.size());
+  for (const std::vector<int32_t>& sequence : sequences) {
+    ActionVect actions(sequence.size());
+    for (size_t t = 0; t < sequence.size(); t++) {
+      actions[t] = toAction(sequence[t]);
+    }
+    action_sequences.push_back(std::move(actions));
+  }
+  RolloutOptions options = makeRolloutOptions(
+      stop_on_terminal, clone_final_state, include_rng, paddle_strength);
+
+  std::vector<RolloutResult> results;
+  {
+    py::gil_scoped_release release;
+    results = ALERolloutPool::rollout(root, action_sequences, options);
+  }
+
+  py::list out;
+  for (RolloutResult& result : results) {
+    out.append(rolloutResultToPython(result, options));
+  }
+  return out;
+}
+
 } // namespace ale
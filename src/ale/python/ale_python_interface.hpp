@@ -25,6 +25,10 @@
 #include <pybind11/stl/filesystem.h>
 
 #include "ale/ale_interface.hpp"
+#include "ale/ale_async_batch.hpp"
+#include "ale/ale_batch.hpp"
+#include "ale/ale_env_pool.hpp"
+#include "ale/ale_rollout_pool.hpp"
 #include "version.hpp"
 
 namespace py = pybind11;
@@ -44,17 +48,28 @@ class ALEPythonInterface : public ALEInterface {
   py::array_t<pixel_t, py::array::c_style> getScreenRGB();
   py::array_t<pixel_t, py::array::c_style> getScreenGrayscale();
 
+  // (256, 3) RGB colours of the palette indices returned by getScreen().
+  py::array_t<uint8_t, py::array::c_style> getPaletteRGB();
+
   inline reward_t act(unsigned int action) {
     return ALEInterface::act((Action)action);
   }
 
+  // One player A action per player, answering the reward of each player.
+  py::array_t<reward_t> act(
+      py::array_t<int32_t, py::array::c_style | py::array::forcecast> actions,
+      py::array_t<float, py::array::c_style | py::array::forcecast>
+          paddle_strengths);
+
   inline py::tuple getScreenDims() {
     const ALEScreen& screen = ALEInterface::getScreen();
     return py::make_tuple(screen.height(), screen.width());
   }
 
   // Implicitely cast std::string -> fs::path
+  // Environments may be loaded in parallel threads, so the GIL is released
   inline void loadROM(std::string rom_file) {
+    py::gil_scoped_release release;
     return ALEInterface::loadROM(rom_file);
   }
 
@@ -66,6 +81,149 @@ class ALEPythonInterface : public ALEInterface {
   inline uint32_t getRAMSize() { return ALEInterface::getRAM().size(); }
   const py::array_t<uint8_t, py::array::c_style> getRAM();
   void getRAM(py::array_t<uint8_t, py::array::c_style>& buffer);
+
+  // Read-only views of the current screen and RAM, without copying. They
+  // follow the environment as it steps: compare getObservationGeneration()
+  // with its value when the data was read to tell whether it has changed
+  // since. A view keeps the environment alive, so after loadROM() it still
+  // shows the last screen or RAM of the previous game.
+  py::array getScreenView();
+  py::array getRAMView();
+
+  // The captured audio samples (see ALEInterface::getAudio()), copied or
+  // as a read-only view like those above.
+  py::array_t<uint8_t, py::array::c_style> getAudio();
+  py::array getAudioView();
+
+  // Returns (rewards, terminal, state), state being None unless
+  // clone_final_state is set.
+  py::tuple rollout(const ALEState& state,
+                    py::array_t<int32_t, py::array::c_style | py::array::forcecast> actions,
+                    bool stop_on_terminal, bool clone_final_state,
+                    bool include_rng, float paddle_strength);
+
+ protected:
+  // Wraps data owned by the environment in a read-only array of the given
+  // shape, whose base holds a reference to the environment.
+  py::array environmentView(const uint8_t* data,
+                            const std::vector<py::ssize_t>& shape) const;
+};
+
+// Converts the obs_type names used by AtariEnv ("rgb", "grayscale", "ram",
+// "indexed").
+ObsType parseObsType(const std::string& obs_type);
+
+// Returns the native interfaces behind a list of Python ALEInterface objects.
+std::vector<ALEInterface*> unwrapInterfaces(const std::vector<py::object>& envs);
+
+// Builds the options shared by ALEInterface.rollout and ALERolloutPool.rollout.
+RolloutOptions makeRolloutOptions(bool stop_on_terminal, bool clone_final_state,
+                                  bool include_rng, float paddle_strength);
+
+// Converts a rollout result to the (rewards, terminal, state) tuple.
+py::tuple rolloutResultToPython(RolloutResult& result,
+                                const RolloutOptions& options);
+
+// Copies a palette of 256 RGB colours into a (256, 3) array.
+py::array_t<uint8_t, py::array::c_style> paletteToArray(
+    const std::vector<uint8_t>& palette);
+
+// Converts a player action given as an integer, raising ValueError unless it
+// is one of the 18 joystick actions.
+Action toAction(int32_t action);
+
+// Throws unless `array` has shape (batch_size, *trailing).
+void checkBatchShape(const py::array& array, size_t batch_size,
+                     const std::vector<size_t>& trailing, const char* name);
+
+class ALEPythonBatch : public ALEBatch {
+ public:
+  ALEPythonBatch(const std::vector<py::object>& envs,
+                 const std::string& obs_type, bool autoreset);
+
+  // Steps every environment with the GIL released. The output arrays must
+  // be C-contiguous, writeable and of the exact dtype (uint8, int32, bool);
+  // they are filled in place.
+  void step(py::array_t<int32_t, py::array::c_style | py::array::forcecast> actions,
+            py::array_t<uint8_t, py::array::c_style>& obs,
+            py::array_t<reward_t, py::array::c_style>& rewards,
+            py::array_t<bool, py::array::c_style>& dones);
+
+  void reset(py::array_t<uint8_t, py::array::c_style>& obs);
+
+  py::tuple getObservationShape() const;
+  py::array_t<uint8_t, py::array::c_style> getPaletteRGB() const;
+
+ protected:
+  // Keeps the Python environment objects alive as long as the batch.
+  std::vector<py::object> m_env_refs;
+  std::vector<Action> m_actions;
+};
+
+// Keeps the Python environment objects of a native batch or pool alive.
+// Inherited before the native class, so that the environments are only
+// released once its destructor has waited for the worker threads.
+struct PythonEnvRefs {
+  explicit PythonEnvRefs(const std::vector<py::object>& envs) : m_env_refs(envs) {}
+
+  std::vector<py::object> m_env_refs;
+};
+
+class ALEPythonAsyncBatch : private PythonEnvRefs, public ALEAsyncBatch {
+ public:
+  ALEPythonAsyncBatch(const std::vector<py::object>& envs,
+                      const std::string& obs_type, bool autoreset,
+                      size_t num_threads);
+
+  // The arrays returned below are read-only views of the internal double
+  // buffers, kept valid by `owner` (the Python batch object). They are
+  // overwritten by the second step_async() issued after they were returned.
+  py::array reset(py::handle owner);
+  void stepAsync(py::array_t<int32_t, py::array::c_style | py::array::forcecast> actions);
+  py::tuple stepWait(py::handle owner);
+
+  py::tuple getObservationShape() const;
+  py::array_t<uint8_t, py::array::c_style> getPaletteRGB() const;
+
+ protected:
+  py::array observationView(const uint8_t* obs, py::handle owner) const;
+
+  std::vector<Action> m_actions;
+};
+
+class ALEPythonEnvPool : private PythonEnvRefs, public ALEEnvPool {
+ public:
+  ALEPythonEnvPool(const std::vector<py::object>& envs, size_t batch_size,
+                   const std::string& obs_type, bool autoreset,
+                   size_t num_threads);
+
+  void send(py::array_t<int32_t, py::array::c_style | py::array::forcecast> actions,
+            py::array_t<int32_t, py::array::c_style | py::array::forcecast> env_ids);
+
+  // Returns read-only views (obs, rewards, dones, env_ids) of the output
+  // buffers, kept valid by `owner` and overwritten by the next recv().
+  py::tuple recv(py::handle owner);
+
+  py::tuple getObservationShape() const;
+  py::array_t<uint8_t, py::array::c_style> getPaletteRGB() const;
+
+ protected:
+  std::vector<Action> m_actions;
+};
+
+class ALEPythonRolloutPool : public ALERolloutPool {
+ public:
+  ALEPythonRolloutPool(const std::vector<py::object>& envs, size_t num_threads);
+
+  // Runs the rollouts with the GIL released and returns a list with one
+  // (rewards, terminal, state) tuple per action sequence.
+  py::list rollout(const ALEState& root,
+                   const std::vector<std::vector<int32_t>>& sequences,
+                   bool stop_on_terminal, bool clone_final_state,
+                   bool include_rng, float paddle_strength);
+
+ protected:
+  std::vector<py::object> m_env_refs;
 };
 
 } // namespace ale
@@ -77,6 +235,7 @@ PYBIND11_MODULE(_ale_py, m) {
 #else
   m.attr("SDL_SUPPORT") = py::bool_(false);
 #endif
+  m.attr("PERF_STATS") = py::bool_(ale::PerfStats::enabled);
 
   py::enum_<ale::Action>(m, "Action")
       .value("NOOP", ale::PLAYER_A_NOOP)
@@ -128,6 +287,77 @@ PYBIND11_MODULE(_ale_py, m) {
             return state;
           }));
 
+  py::class_<ale::PerfStats>(m, "PerfStats")
+      .def_readonly_static("enabled", &ale::PerfStats::enabled)
+      .def_readonly("act_ns", &ale::PerfStats::act_ns)
+      .def_readonly("reset_ns", &ale::PerfStats::reset_ns)
+      .def_readonly("hooks_ns", &ale::PerfStats::hooks_ns)
+      .def_readonly("emulate_ns", &ale::PerfStats::emulate_ns)
+      .def_readonly("rom_step_ns", &ale::PerfStats::rom_step_ns)
+      .def_readonly("screen_ns", &ale::PerfStats::screen_ns)
+      .def_readonly("ram_ns", &ale::PerfStats::ram_ns)
+      .def_readonly("frames", &ale::PerfStats::frames)
+      .def_readonly("instructions", &ale::PerfStats::instructions)
+      .def_readonly("tia_pokes", &ale::PerfStats::tia_pokes)
+      .def_readonly("tia_clocks", &ale::PerfStats::tia_clocks);
+
+  py::class_<ale::ALEPythonBatch>(m, "ALEBatch")
+      .def(py::init<const std::vector<py::object>&, const std::string&, bool>(),
+           py::arg("envs"), py::arg("obs_type") = "rgb",
+           py::arg("autoreset") = false)
+      .def("step", &ale::ALEPythonBatch::step, py::arg("actions"),
+           py::arg("out_obs").noconvert(), py::arg("out_rewards").noconvert(),
+           py::arg("out_dones").noconvert())
+      .def("reset", &ale::ALEPythonBatch::reset, py::arg("out_obs").noconvert())
+      .def("getObservationShape", &ale::ALEPythonBatch::getObservationShape)
+      .def("getPaletteRGB", &ale::ALEPythonBatch::getPaletteRGB)
+      .def("__len__", &ale::ALEPythonBatch::size);
+
+  py::class_<ale::ALEPythonAsyncBatch>(m, "ALEAsyncBatch")
+      .def(py::init<const std::vector<py::object>&, const std::string&, bool,
+                    size_t>(),
+           py::arg("envs"), py::arg("obs_type") = "rgb",
+           py::arg("autoreset") = false, py::arg("num_threads") = 0)
+      .def("reset", [](py::object self) {
+        return self.cast<ale::ALEPythonAsyncBatch&>().reset(self);
+      })
+      .def("step_async", &ale::ALEPythonAsyncBatch::stepAsync,
+           py::arg("actions"))
+      .def("step_wait", [](py::object self) {
+        return self.cast<ale::ALEPythonAsyncBatch&>().stepWait(self);
+      })
+      .def("getObservationShape",
+           &ale::ALEPythonAsyncBatch::getObservationShape)
+      .def("getPaletteRGB", &ale::ALEPythonAsyncBatch::getPaletteRGB)
+      .def("__len__", &ale::ALEPythonAsyncBatch::size);
+
+  py::class_<ale::ALEPythonEnvPool>(m, "ALEEnvPool")
+      .def(py::init<const std::vector<py::object>&, size_t, const std::string&,
+                    bool, size_t>(),
+           py::arg("envs"), py::arg("batch_size") = 0,
+           py::arg("obs_type") = "rgb", py::arg("autoreset") = true,
+           py::arg("num_threads") = 0)
+      .def("async_reset", &ale::ALEPythonEnvPool::asyncReset)
+      .def("send", &ale::ALEPythonEnvPool::send, py::arg("actions"),
+           py::arg("env_ids"))
+      .def("recv", [](py::object self) {
+        return self.cast<ale::ALEPythonEnvPool&>().recv(self);
+      })
+      .def_property_readonly("batch_size", &ale::ALEPythonEnvPool::batchSize)
+      .def("getObservationShape", &ale::ALEPythonEnvPool::getObservationShape)
+      .def("getPaletteRGB", &ale::ALEPythonEnvPool::getPaletteRGB)
+      .def("__len__", &ale::ALEPythonEnvPool::size);
+
+  py::class_<ale::ALEPythonRolloutPool>(m, "ALERolloutPool")
+      .def(py::init<const std::vector<py::object>&, size_t>(),
+           py::arg("envs"), py::arg("num_threads") = 0)
+      .def("rollout", &ale::ALEPythonRolloutPool::rollout, py::arg("state"),
+           py::arg("sequences"), py::kw_only(),
+           py::arg("stop_on_terminal") = true,
+           py::arg("clone_final_state") = true, py::arg("include_rng") = false,
+           py::arg("paddle_strength") = 1.0f)
+      .def("__len__", &ale::ALEPythonRolloutPool::size);
+
   py::class_<ale::ALEPythonInterface>(m, "ALEInterface")
       .def(py::init<>())
       .def("getString", &ale::ALEPythonInterface::getString)
@@ -139,7 +369,8 @@ PYBIND11_MODULE(_ale_py, m) {
       .def("setBool", &ale::ALEPythonInterface::setBool)
       .def("setFloat", &ale::ALEPythonInterface::setFloat)
       .def("loadROM", &ale::ALEPythonInterface::loadROM)
-      .def("loadROM", &ale::ALEInterface::loadROM)
+      .def("loadROM", &ale::ALEInterface::loadROM,
+           py::call_guard<py::gil_scoped_release>())
       .def_static("isSupportedROM", &ale::ALEPythonInterface::isSupportedROM)
       .def_static("isSupportedROM", &ale::ALEInterface::isSupportedROM)
       .def("act", (ale::reward_t(ale::ALEPythonInterface::*)(uint32_t)) &
@@ -150,6 +381,14 @@ PYBIND11_MODULE(_ale_py, m) {
                       ale::ALEInterface::act)
       .def("act", (ale::reward_t(ale::ALEInterface::*)(ale::Action, float)) &
                       ale::ALEInterface::act)
+      .def("act",
+           (py::array_t<ale::reward_t>(ale::ALEPythonInterface::*)(
+               py::array_t<int32_t, py::array::c_style | py::array::forcecast>,
+               py::array_t<float, py::array::c_style | py::array::forcecast>)) &
+               ale::ALEPythonInterface::act,
+           py::arg("actions"), py::arg("paddle_strengths") = py::array_t<float>())
+      .def("getMaxPlayers", &ale::ALEPythonInterface::getMaxPlayers)
+      .def("getNumPlayers", &ale::ALEPythonInterface::getNumPlayers)
       .def("game_over", &ale::ALEPythonInterface::game_over, py::kw_only(), py::arg("with_truncation") = py::bool_(true))
       .def("game_truncated", &ale::ALEPythonInterface::game_truncated)
       .def("reset_game", &ale::ALEPythonInterface::reset_game)
@@ -164,6 +403,13 @@ PYBIND11_MODULE(_ale_py, m) {
       .def("lives", &ale::ALEPythonInterface::lives)
       .def("getEpisodeFrameNumber",
            &ale::ALEPythonInterface::getEpisodeFrameNumber)
+      .def("getInstructionCount",
+           &ale::ALEPythonInterface::getInstructionCount)
+      .def("getCycleCount", &ale::ALEPythonInterface::getCycleCount)
+      .def("getEmulatedFrameCount",
+           &ale::ALEPythonInterface::getEmulatedFrameCount)
+      .def("getScanlinesPerFrame",
+           &ale::ALEPythonInterface::getScanlinesPerFrame)
       .def("getScreen", (void (ale::ALEPythonInterface::*)(
                             py::array_t<ale::pixel_t, py::array::c_style>&)) &
                             ale::ALEPythonInterface::getScreen)
@@ -185,6 +431,7 @@ PYBIND11_MODULE(_ale_py, m) {
            (py::array_t<ale::pixel_t, py::array::c_style>(
                ale::ALEPythonInterface::*)()) &
                ale::ALEPythonInterface::getScreenGrayscale)
+      .def("getPaletteRGB", &ale::ALEPythonInterface::getPaletteRGB)
       .def("getScreenDims", &ale::ALEPythonInterface::getScreenDims)
       .def("getRAMSize", &ale::ALEPythonInterface::getRAMSize)
       .def("getRAM", (const py::array_t<uint8_t, py::array::c_style> (
@@ -193,12 +440,26 @@ PYBIND11_MODULE(_ale_py, m) {
       .def("getRAM", (void (ale::ALEPythonInterface::*)(
                          py::array_t<uint8_t, py::array::c_style>&)) &
                          ale::ALEPythonInterface::getRAM)
+      .def("getScreenView", &ale::ALEPythonInterface::getScreenView)
+      .def("getRAMView", &ale::ALEPythonInterface::getRAMView)
+      .def("getAudio", &ale::ALEPythonInterface::getAudio)
+      .def("getAudioView", &ale::ALEPythonInterface::getAudioView)
+      .def("getObservationGeneration",
+           &ale::ALEPythonInterface::getObservationGeneration)
       .def("setRAM", &ale::ALEPythonInterface::setRAM)
       .def("cloneState", &ale::ALEPythonInterface::cloneState, py::kw_only(), py::arg("include_rng") = py::bool_(false))
       .def("restoreState", &ale::ALEPythonInterface::restoreState)
+      .def("stateHash", &ale::ALEPythonInterface::stateHash)
+      .def("rollout", &ale::ALEPythonInterface::rollout, py::arg("state"),
+           py::arg("actions"), py::kw_only(),
+           py::arg("stop_on_terminal") = true,
+           py::arg("clone_final_state") = true, py::arg("include_rng") = false,
+           py::arg("paddle_strength") = 1.0f)
       .def("cloneSystemState", &ale::ALEPythonInterface::cloneSystemState)
       .def("restoreSystemState", &ale::ALEPythonInterface::restoreSystemState)
       .def("saveScreenPNG", &ale::ALEPythonInterface::saveScreenPNG)
+      .def("getPerfStats", &ale::ALEPythonInterface::getPerfStats)
+      .def("resetPerfStats", &ale::ALEPythonInterface::resetPerfStats)
       .def_static("setLoggerMode", &ale::Logger::setMode);
 }
 
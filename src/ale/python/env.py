@@ -39,7 +39,7 @@ class AtariEnv(gymnasium.Env, utils.EzPickle):
         game: str,
         mode: int | None = None,
         difficulty: int | None = None,
-        obs_type: Literal["rgb", "grayscale", "ram"] = "rgb",
+        obs_type: Literal["rgb", "grayscale", "ram", "indexed"] = "rgb",
         frameskip: tuple[int, int] | int = 4,
         repeat_action_probability: float = 0.25,
         full_action_space: bool = False,
@@ -56,7 +56,7 @@ class AtariEnv(gymnasium.Env, utils.EzPickle):
           game: str => Game to initialize env with, in snake_case.
           mode: Optional[int] => Game mode, see Machado et al., 2018
           difficulty: Optional[int] => Game difficulty,see Machado et al., 2018
-          obs_type: str => Observation type in { 'rgb', 'grayscale', 'ram' }
+          obs_type: str => Observation type in { 'rgb', 'grayscale', 'ram', 'indexed' }
           frameskip: Union[tuple[int, int], int] =>
               Stochastic frameskip as tuple or fixed.
           repeat_action_probability: int =>
@@ -85,9 +85,9 @@ class AtariEnv(gymnasium.Env, utils.EzPickle):
             and Open Problems for General Agents`, Machado et al., 2018, JAIR
             URL: https://jair.org/index.php/jair/article/view/11182
         """
-        if obs_type not in {"rgb", "grayscale", "ram"}:
+        if obs_type not in {"rgb", "grayscale", "ram", "indexed"}:
             raise error.Error(
-                f"Invalid observation type: {obs_type}. Expecting: rgb, grayscale, ram."
+                f"Invalid observation type: {obs_type}. Expecting: rgb, grayscale, ram, indexed."
             )
 
         if type(frameskip) not in (int, tuple):
@@ -188,7 +188,7 @@ class AtariEnv(gymnasium.Env, utils.EzPickle):
             self.observation_space = spaces.Box(
                 low=0, high=255, dtype=np.uint8, shape=(self.ale.getRAMSize(),)
             )
-        elif self._obs_type == "rgb" or self._obs_type == "grayscale":
+        elif self._obs_type in {"rgb", "grayscale", "indexed"}:
             (screen_height, screen_width) = self.ale.getScreenDims()
             image_shape = (
                 screen_height,
@@ -202,6 +202,10 @@ class AtariEnv(gymnasium.Env, utils.EzPickle):
         else:
             raise error.Error(f"Unrecognized observation type: {self._obs_type}")
 
+        # RGB colours of the palette indices returned by `indexed` observations,
+        # as a (256, 3) array: `palette[obs]` gives the `rgb` observation.
+        self.palette = self.ale.getPaletteRGB()
+
     def seed_game(self, seed: int | None = None) -> tuple[int, int]:
         """Seeds the internal and ALE RNG."""
         ss = np.random.SeedSequence(seed)
@@ -335,6 +339,8 @@ class AtariEnv(gymnasium.Env, utils.EzPickle):
             return self.ale.getScreenRGB()
         elif self._obs_type == "grayscale":
             return self.ale.getScreenGrayscale()
+        elif self._obs_type == "indexed":
+            return self.ale.getScreen()
         else:
             raise error.Error(f"Unrecognized observation type: {self._obs_type}")
 
@@ -0,0 +1,43 @@
+/* *****************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2013 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details.
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ *  check.hpp
+ *
+ *  Minimal assertions for the C++ tests: a failed check is reported and
+ *  counted, and the test's main() returns checkFailures().
+ *
+ **************************************************************************** */
+
+#ifndef __ALE_TEST_CHECK_HPP__
+#define __ALE_TEST_CHECK_HPP__
+
+#include <iostream>
+
+namespace ale {
+namespace test {
+
+inline int& checkFailures() {
+  static int failures = 0;
+  return failures;
+}
+
+inline void check(bool ok, const char* expr, const char* file, int line) {
+  if (!ok) {
+    std::cerr << file << ":" << line << ": check failed: " << expr << std::endl;
+    checkFailures()++;
+  }
+}
+
+}  // namespace test
+}  // namespace ale
+
+#define ALE_CHECK(expr) ::ale::test::check((expr), #expr, __FILE__, __LINE__)
+
+#endif  // __ALE_TEST_CHECK_HPP__
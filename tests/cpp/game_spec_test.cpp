@@ -0,0 +1,138 @@
+/* *****************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2013 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details.
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ *  game_spec_test.cpp
+ *
+ *  Tests GameSpecSettings against RAM fixtures of the games it describes:
+ *  Breakout's lives and its started test, Pong's two game-over clauses and
+ *  zero-sum rewards, and the clipped rewards of Freeway.
+ *
+ **************************************************************************** */
+
+#include <cstdint>
+#include <cstring>
+
+#include "ale/emucore/Deserializer.hxx"
+#include "ale/emucore/Serializer.hxx"
+#include "ale/games/supported/Breakout.hpp"
+#include "ale/games/supported/Freeway.hpp"
+#include "ale/games/supported/Pong.hpp"
+#include "check.hpp"
+
+namespace {
+
+// Settings fed from a RAM fixture instead of a running console
+template <typename Settings>
+struct Fixture : Settings {
+  uint8_t ram[128];
+
+  // RAM left by the console at power-on, before the game has set it up
+  Fixture() { std::memset(ram, 0, sizeof(ram)); }
+
+  void step() { this->evaluate(ram); }
+};
+
+void testBreakout() {
+  Fixture<ale::BreakoutSettings> game;
+
+  // 57 starts at 0, which is only a game over once it has been 5
+  game.step();
+  ALE_CHECK(!game.isTerminal());
+  ALE_CHECK(game.lives() == 0);
+
+  game.ram[57] = 5;
+  game.step();
+  ALE_CHECK(!game.isTerminal());
+  ALE_CHECK(game.lives() == 5);
+
+  // Score 312: hundreds in the low nibble of 76, tens and units at 77
+  game.ram[76] = 0x03;
+  game.ram[77] = 0x12;
+  game.ram[57] = 3;
+  game.step();
+  ALE_CHECK(game.getReward() == 312);
+  ALE_CHECK(game.lives() == 3);
+
+  // The started flag survives saving and restoring the settings
+  ale::stella::Serializer ser;
+  game.saveState(ser);
+  game.reset();
+  ale::stella::Deserializer des(ser.get_str());
+  game.loadState(des);
+
+  game.ram[57] = 0;
+  game.step();
+  ALE_CHECK(game.isTerminal());
+  ALE_CHECK(game.lives() == 0);
+  ALE_CHECK(game.getReward() == 0);
+
+  // Resetting forgets that the game had started
+  game.reset();
+  game.step();
+  ALE_CHECK(!game.isTerminal());
+}
+
+void testPong() {
+  for (int address : {13, 14}) {
+    Fixture<ale::PongSettings> game;
+    game.step();
+    ALE_CHECK(!game.isTerminal());
+
+    // Player A scores at 14, the opponent at 13
+    game.ram[14] = 1;
+    game.step();
+    ale::reward_t rewards[2];
+    game.getRewards(rewards);
+    ALE_CHECK(rewards[0] == 1 && rewards[1] == -1);
+
+    // Either score reaching 21 ends the game
+    game.ram[address] = 20;
+    game.step();
+    ALE_CHECK(!game.isTerminal());
+    game.ram[address] = 21;
+    game.step();
+    ALE_CHECK(game.isTerminal());
+  }
+}
+
+void testFreeway() {
+  Fixture<ale::FreewaySettings> game;
+  game.step();
+
+  // Rewards are clipped to [0, 1], here when the score jumps by 9, and
+  // carries into the tens digit of the BCD score
+  game.ram[103] = 0x09;
+  game.step();
+  ALE_CHECK(game.getReward() == 1);
+  game.ram[103] = 0x10;
+  game.step();
+  ALE_CHECK(game.getReward() == 1);
+  game.step();
+  ALE_CHECK(game.getReward() == 0);
+
+  // A score going back to 0 is not a negative reward
+  game.ram[103] = 0x00;
+  game.step();
+  ALE_CHECK(game.getReward() == 0);
+  ALE_CHECK(!game.isTerminal());
+
+  game.ram[22] = 1;
+  game.step();
+  ALE_CHECK(game.isTerminal());
+}
+
+}  // namespace
+
+int main() {
+  testBreakout();
+  testPong();
+  testFreeway();
+  return ale::test::checkFailures();
+}
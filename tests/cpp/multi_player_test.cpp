@@ -0,0 +1,166 @@
+/* *****************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2013 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details.
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ *  multi_player_test.cpp
+ *
+ *  Tests the multi-player paths that the bundled single-player ROM does not
+ *  reach: the zero-sum rewards of two-player games, stepped through a small
+ *  generated ROM that Pong's settings are attached to by name, and the
+ *  paddles of players C and D on the right controller port.
+ *
+ **************************************************************************** */
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include "ale/ale_interface.hpp"
+#include "ale/emucore/Event.hxx"
+#include "ale/environment/ale_state.hpp"
+#include "check.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// A 2K ROM that clears RAM, then every frame adds one to Pong's player A
+// score (RAM 14), modulo 16, and leaves the opponent's score at 0.
+std::vector<uint8_t> scoringRom() {
+  const uint8_t code[] = {
+      0x78,              // F000 SEI
+      0xD8,              // F001 CLD
+      0xA2, 0xFF,        // F002 LDX #$FF
+      0x9A,              // F004 TXS
+      0xA9, 0x00,        // F005 LDA #0
+      0xA2, 0x80,        // F007 LDX #$80
+      0x95, 0x00,        // F009 STA $00,X
+      0xE8,              // F00B INX
+      0xD0, 0xFB,        // F00C BNE $F009
+      0xA9, 0x02,        // F00E LDA #2          ; frame: start VSYNC
+      0x85, 0x00,        // F010 STA VSYNC
+      0x85, 0x02,        // F012 STA WSYNC
+      0x85, 0x02,        // F014 STA WSYNC
+      0x85, 0x02,        // F016 STA WSYNC
+      0xA9, 0x00,        // F018 LDA #0
+      0x85, 0x00,        // F01A STA VSYNC
+      0xA5, 0x8E,        // F01C LDA $8E
+      0x18,              // F01E CLC
+      0x69, 0x01,        // F01F ADC #1
+      0x29, 0x0F,        // F021 AND #$0F
+      0x85, 0x8E,        // F023 STA $8E
+      0xA2, 0xC8,        // F025 LDX #200
+      0x85, 0x02,        // F027 STA WSYNC
+      0xCA,              // F029 DEX
+      0xD0, 0xFB,        // F02A BNE $F027
+      0x4C, 0x0E, 0xF0,  // F02C JMP $F00E
+  };
+
+  std::vector<uint8_t> rom(2048, 0xEA);
+  std::copy(std::begin(code), std::end(code), rom.begin());
+  rom[0x7FC] = 0x00;  // Reset vector
+  rom[0x7FD] = 0xF0;
+  rom[0x7FE] = 0x00;  // IRQ/BRK vector
+  rom[0x7FF] = 0xF0;
+  return rom;
+}
+
+void testZeroSumRewards() {
+  const fs::path dir = fs::temp_directory_path() / "ale-multi-player-test";
+  fs::create_directories(dir);
+  const fs::path rom_path = dir / "pong.bin";
+  {
+    const std::vector<uint8_t> rom = scoringRom();
+    std::ofstream out(rom_path, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(rom.data()), rom.size());
+  }
+
+  ale::ALEInterface multi, single;
+  for (ale::ALEInterface* ale : {&multi, &single}) {
+    ale->setInt("random_seed", 0);
+    ale->setFloat("repeat_action_probability", 0.0);
+    ale->loadROM(rom_path);
+  }
+  ALE_CHECK(multi.getMaxPlayers() == 2);
+  ALE_CHECK(multi.getNumPlayers() == 2);
+
+  int positive = 0, negative = 0;
+  for (int t = 0; t < 100; t++) {
+    const ale::ActionVect actions = {ale::PLAYER_A_NOOP, ale::PLAYER_A_FIRE};
+    const std::vector<ale::reward_t> rewards = multi.act(actions);
+    ALE_CHECK(rewards.size() == 2);
+    ALE_CHECK(rewards[1] == -rewards[0]);
+    ALE_CHECK(rewards[0] == single.act(ale::PLAYER_A_NOOP));
+    positive += rewards[0] > 0;
+    negative += rewards[0] < 0;
+  }
+  // One point per frame, and -15 when the score wraps around every 16 frames
+  ALE_CHECK(positive > 0 && negative > 0);
+  ALE_CHECK(!multi.game_over());
+
+  fs::remove_all(dir);
+}
+
+void testRightPortPaddles() {
+  ale::stella::Event event;
+  ale::ALEState state;
+  state.resetPaddles(&event);
+
+  // The right port stays disconnected until players C and D act
+  ALE_CHECK(event.get(ale::stella::Event::PaddleTwoResistance) == 0);
+  ALE_CHECK(event.get(ale::stella::Event::PaddleThreeResistance) == 0);
+
+  const int left = state.getLeftPaddle();
+  const int right = state.getRightPaddle();
+  const int c = state.getPaddleC();
+  const int d = state.getPaddleD();
+
+  state.applyActionPaddles(&event, ale::PLAYER_A_NOOP, 1.0,
+                           ale::PLAYER_B_NOOP, 1.0);
+  state.applyActionRightPaddles(&event, ale::PLAYER_A_RIGHT, 1.0,
+                                ale::PLAYER_A_LEFTFIRE, 0.5);
+
+  // C and D move in opposite directions, D at half the strength, and
+  // players A and B are unaffected
+  ALE_CHECK(state.getLeftPaddle() == left);
+  ALE_CHECK(state.getRightPaddle() == right);
+  ALE_CHECK(state.getPaddleC() < c);
+  ALE_CHECK(state.getPaddleD() > d);
+  ALE_CHECK((c - state.getPaddleC()) == 2 * (state.getPaddleD() - d));
+
+  ALE_CHECK(event.get(ale::stella::Event::PaddleTwoResistance) != 0);
+  ALE_CHECK(event.get(ale::stella::Event::PaddleThreeResistance) != 0);
+  ALE_CHECK(event.get(ale::stella::Event::PaddleTwoFire) == 0);
+  ALE_CHECK(event.get(ale::stella::Event::PaddleThreeFire) == 1);
+  ALE_CHECK(event.get(ale::stella::Event::PaddleZeroFire) == 0);
+  ALE_CHECK(event.get(ale::stella::Event::PaddleOneFire) == 0);
+
+  // Paddles stop at the end of their range
+  for (int i = 0; i < 100; i++) {
+    state.applyActionPaddles(&event, ale::PLAYER_A_NOOP, 1.0,
+                             ale::PLAYER_B_NOOP, 1.0);
+    state.applyActionRightPaddles(&event, ale::PLAYER_A_RIGHTFIRE, 1.0,
+                                  ale::PLAYER_A_LEFT, 1.0);
+  }
+  ALE_CHECK(state.getPaddleC() == PADDLE_MIN);
+  ALE_CHECK(state.getPaddleD() == PADDLE_MAX);
+  ALE_CHECK(event.get(ale::stella::Event::PaddleTwoFire) == 1);
+  ALE_CHECK(event.get(ale::stella::Event::PaddleThreeFire) == 0);
+}
+
+}  // namespace
+
+int main() {
+  ale::Logger::setMode(ale::Logger::Error);
+
+  testZeroSumRewards();
+  testRightPortPaddles();
+  return ale::test::checkFailures();
+}
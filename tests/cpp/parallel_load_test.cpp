@@ -0,0 +1,163 @@
+/* *****************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2013 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details.
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ *  parallel_load_test.cpp
+ *
+ *  Constructs and loads environments on many threads at once, while another
+ *  thread keeps changing the Logger's mode, and checks that they play like
+ *  environments built one after the other. Half of them load a generated
+ *  Supercharger (AR) cartridge, whose BIOS is patched for fastbios. Build
+ *  with -DCMAKE_CXX_FLAGS=-fsanitize=thread to check for data races.
+ *
+ *  Usage: ale-test-parallel_load <path to tetris.bin>
+ *
+ **************************************************************************** */
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ale/ale_interface.hpp"
+#include "check.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// A Supercharger tape image with one load of one page. The BIOS loads the
+// page into bank 0 and jumps to it with bank 0 mapped at $F000. The code
+// clears Pong's scores and mode (RAM 13, 14 and 0x16), then counts frames
+// in RAM 0.
+std::vector<uint8_t> superchargerRom() {
+  const uint8_t code[] = {
+      0xA9, 0x00,        // F000 LDA #0
+      0x85, 0x8D,        // F002 STA $8D
+      0x85, 0x8E,        // F004 STA $8E
+      0x85, 0x96,        // F006 STA $96
+      0xA9, 0x02,        // F008 LDA #2          ; frame: start VSYNC
+      0x85, 0x00,        // F00A STA VSYNC
+      0x85, 0x02,        // F00C STA WSYNC
+      0x85, 0x02,        // F00E STA WSYNC
+      0x85, 0x02,        // F010 STA WSYNC
+      0xA9, 0x00,        // F012 LDA #0
+      0x85, 0x00,        // F014 STA VSYNC
+      0xE6, 0x80,        // F016 INC $80
+      0xA2, 0xC8,        // F018 LDX #200
+      0x85, 0x02,        // F01A STA WSYNC
+      0xCA,              // F01C DEX
+      0xD0, 0xFB,        // F01D BNE $F01A
+      0x4C, 0x08, 0xF0,  // F01F JMP $F008
+  };
+
+  std::vector<uint8_t> rom(8448, 0);
+  std::copy(std::begin(code), std::end(code), rom.begin());
+
+  uint8_t* header = &rom[8192];
+  header[0] = 0x00;  // Start address
+  header[1] = 0xF0;
+  header[2] = 0x05;  // Bank 0 at $F000, ROM power off
+  header[3] = 1;     // Pages
+  header[5] = 0;     // Load number
+  uint8_t sum = 0;
+  for (int i = 0; i < 8; i++) sum += header[i];
+  header[4] = uint8_t(0x55 - sum);
+
+  header[16] = 0;  // Page 0 goes to bank 0, page 0
+  sum = 0;
+  for (int i = 0; i < 256; i++) sum += rom[i];
+  header[64] = uint8_t(0x55 - sum - header[16]);
+  return rom;
+}
+
+// What an environment looks like after a fixed run
+struct Run {
+  uint64_t hash = 0;
+  std::vector<uint8_t> ram;
+  std::vector<uint8_t> screen;
+  ale::reward_t reward = 0;
+};
+
+Run play(const fs::path& rom_path) {
+  ale::ALEInterface ale;
+  ale.setInt("random_seed", 0);
+  ale.setFloat("repeat_action_probability", 0.0);
+  ale.loadROM(rom_path);
+
+  Run run;
+  const ale::ActionVect actions = ale.getMinimalActionSet();
+  for (int t = 0; t < 100; t++) {
+    run.reward += ale.act(actions[t % actions.size()]);
+  }
+  run.hash = ale.stateHash();
+  const ale::ALERAM& ram = ale.getRAM();
+  run.ram.assign(ram.array(), ram.array() + ram.size());
+  ale.getScreenRGB(run.screen);
+  return run;
+}
+
+bool sameRun(const Run& a, const Run& b) {
+  return a.hash == b.hash && a.ram == b.ram && a.screen == b.screen &&
+         a.reward == b.reward;
+}
+
+void testParallelLoad(const fs::path& tetris_path) {
+  const fs::path dir = fs::temp_directory_path() / "ale-parallel-load-test";
+  fs::create_directories(dir);
+  // Pong's settings are attached by name
+  const fs::path ar_path = dir / "pong.bin";
+  {
+    const std::vector<uint8_t> rom = superchargerRom();
+    std::ofstream out(ar_path, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(rom.data()), rom.size());
+  }
+  const fs::path roms[] = {tetris_path, ar_path};
+
+  Run expected[2];
+  for (int r = 0; r < 2; r++) expected[r] = play(roms[r]);
+
+  const int kThreads = 16;
+  std::vector<Run> runs(kThreads);
+  std::vector<std::thread> threads;
+  std::atomic<bool> done(false);
+  std::thread logger([&done] {
+    for (int i = 0; !done.load(); i++) {
+      ale::Logger::setMode(i % 2 ? ale::Logger::Error : ale::Logger::Warning);
+    }
+    ale::Logger::setMode(ale::Logger::Error);
+  });
+  for (int i = 0; i < kThreads; i++) {
+    threads.emplace_back([&runs, &roms, i] { runs[i] = play(roms[i % 2]); });
+  }
+  for (std::thread& thread : threads) thread.join();
+  done = true;
+  logger.join();
+
+  for (int i = 0; i < kThreads; i++) {
+    ALE_CHECK(sameRun(runs[i], expected[i % 2]));
+  }
+
+  fs::remove_all(dir);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  ale::Logger::setMode(ale::Logger::Error);
+  if (argc != 2) {
+    std::cerr << "Usage: " << argv[0] << " <path to tetris.bin>" << std::endl;
+    return 1;
+  }
+  testParallelLoad(argv[1]);
+  return ale::test::checkFailures();
+}
@@ -0,0 +1,75 @@
+/* *****************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2013 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details.
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ *  phosphor_blend_test.cpp
+ *
+ *  Tests that the colour averaging tables are only built for environments
+ *  that blend a frame, are shared by environments with the same palette,
+ *  and are freed with the last of them.
+ *
+ *  Usage: ale-test-phosphor_blend <path to tetris.bin>
+ *
+ **************************************************************************** */
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ale/ale_interface.hpp"
+#include "ale/environment/phosphor_blend.hpp"
+#include "check.hpp"
+
+namespace {
+
+std::unique_ptr<ale::ALEInterface> makeEnvironment(const std::string& rom,
+                                                   bool color_averaging) {
+  auto ale = std::make_unique<ale::ALEInterface>();
+  ale->setInt("random_seed", 0);
+  ale->setBool("color_averaging", color_averaging);
+  ale->loadROM(rom);
+  ale->act(ale::PLAYER_A_NOOP);
+  return ale;
+}
+
+void testSharedTables(const std::string& rom) {
+  ALE_CHECK(ale::PhosphorBlend::tablesInUse() == 0);
+
+  auto plain = makeEnvironment(rom, false);
+  ALE_CHECK(ale::PhosphorBlend::tablesInUse() == 0);
+
+  auto first = makeEnvironment(rom, true);
+  auto second = makeEnvironment(rom, true);
+  ALE_CHECK(ale::PhosphorBlend::tablesInUse() == 1);
+
+  std::vector<unsigned char> first_screen, second_screen;
+  first->getScreenRGB(first_screen);
+  second->getScreenRGB(second_screen);
+  ALE_CHECK(first_screen == second_screen);
+
+  // The cache still holds the tables of the first environment, which it
+  // would not if the second had built its own
+  second.reset();
+  ALE_CHECK(ale::PhosphorBlend::tablesInUse() == 1);
+  first.reset();
+  ALE_CHECK(ale::PhosphorBlend::tablesInUse() == 0);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  ale::Logger::setMode(ale::Logger::Error);
+  if (argc != 2) {
+    std::cerr << "Usage: " << argv[0] << " <path to tetris.bin>" << std::endl;
+    return 1;
+  }
+  testSharedTables(argv[1]);
+  return ale::test::checkFailures();
+}
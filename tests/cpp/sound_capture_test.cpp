@@ -0,0 +1,167 @@
+/* *****************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2013 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details.
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ *  sound_capture_test.cpp
+ *
+ *  Tests that SoundCapture synthesizes what TIASound does for the same
+ *  register writes at the same samples. The bundled ROM is silent, so the
+ *  registers are written directly, with tones and noise on both channels.
+ *
+ **************************************************************************** */
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "ale/ale_interface.hpp"
+#include "ale/common/SoundCapture.hxx"
+#include "ale/emucore/Settings.hxx"
+#include "ale/emucore/TIASnd.hxx"
+#include "check.hpp"
+
+namespace {
+
+// The rate at which the system cycles of the NTSC console run
+const double CyclesPerSecond = 1193191.66666667;
+
+const int Rate = 31400;
+
+struct Write {
+  int cycle;
+  uint16_t addr;
+  uint8_t value;
+};
+
+// Writes to AUDC0/1, AUDF0/1 and AUDV0/1, each halfway between two samples
+// so that which sample they fall on does not depend on rounding
+std::vector<Write> writes() {
+  const int sample = 38;  // System cycles per sample, about
+  std::vector<Write> out = {
+      {sample * 10 + 19, 0x15, 0x04},    // AUDC0: pure tone
+      {sample * 10 + 19, 0x17, 0x0A},    // AUDF0
+      {sample * 10 + 19, 0x19, 0x0F},    // AUDV0: loudest
+      {sample * 700 + 19, 0x16, 0x08},   // AUDC1: white noise
+      {sample * 700 + 19, 0x18, 0x03},   // AUDF1
+      {sample * 700 + 19, 0x1A, 0x08},   // AUDV1
+      {sample * 1500 + 19, 0x15, 0x0C},  // AUDC0: lower pure tone
+      {sample * 2100 + 19, 0x19, 0x00},  // AUDV0: channel 0 off
+      {sample * 2800 + 19, 0x1A, 0x03},  // AUDV1: quieter noise
+  };
+  return out;
+}
+
+const int EndCycle = 38 * 3500 + 19;
+
+// Number of samples synthesized up to the given system cycle
+uint32_t samplesAt(int cycle) {
+  return (uint32_t)(cycle * (Rate / CyclesPerSecond));
+}
+
+// The samples TIASound produces for writes(), up to EndCycle
+std::vector<uint8_t> referenceSamples(int volume) {
+  ale::stella::TIASound tia(Rate, Rate, 1);
+  tia.clipVolume(true);
+  tia.volume(volume);
+
+  std::vector<uint8_t> out;
+  auto processTo = [&](int cycle) {
+    const size_t count = samplesAt(cycle) - out.size();
+    out.resize(out.size() + count);
+    tia.process(out.data() + out.size() - count, count);
+  };
+  for (const Write& w : writes()) {
+    processTo(w.cycle);
+    tia.set(w.addr, w.value);
+  }
+  processTo(EndCycle);
+  return out;
+}
+
+void configure(ale::ALEInterface& ale, int downsample, int samples) {
+  ale.setInt("sound_capture_rate", Rate);
+  ale.setInt("sound_capture_downsample", downsample);
+  ale.setInt("sound_capture_samples", samples);
+  ale.setInt("tiafreq", Rate);
+  ale.setBool("clipvol", true);
+  ale.setInt("volume", 80);
+}
+
+void testMatchesTIASound() {
+  const std::vector<uint8_t> expected = referenceSamples(80);
+  ALE_CHECK(expected.size() == samplesAt(EndCycle));
+
+  // The reference is not silence: both tones and the noise are audible
+  const auto [lo, hi] = std::minmax_element(expected.begin(), expected.end());
+  ALE_CHECK(*hi - *lo > 64);
+
+  // The ring buffer holds some silence before the samples, and the samples
+  // are synthesized as the registers are written, not in one go at the end
+  ale::ALEInterface ale;
+  const int size = expected.size() + 100;
+  configure(ale, 1, size);
+  ale::SoundCapture capture(ale.theSettings.get());
+  ALE_CHECK(capture.size() == (uint32_t)size);
+  ALE_CHECK(capture.sampleRate() == Rate);
+
+  for (const Write& w : writes()) {
+    capture.set(w.addr, w.value, w.cycle);
+  }
+  capture.update(EndCycle);
+
+  const uint8_t* samples = capture.samples();
+  ALE_CHECK(std::all_of(samples, samples + 100,
+                        [](uint8_t s) { return s == 128; }));
+  ALE_CHECK(std::equal(expected.begin(), expected.end(), samples + 100));
+
+  // Reading the samples more often gives the same samples
+  ale::SoundCapture polled(ale.theSettings.get());
+  int cycle = 0;
+  for (const Write& w : writes()) {
+    for (; cycle < w.cycle; cycle += 1000) polled.update(cycle);
+    polled.set(w.addr, w.value, w.cycle);
+  }
+  polled.update(EndCycle);
+  ALE_CHECK(std::equal(samples, samples + size, polled.samples()));
+}
+
+void testDownsample() {
+  const std::vector<uint8_t> full = referenceSamples(80);
+
+  // Each captured sample is the rounded average of 4 synthesized ones
+  const int downsample = 4;
+  std::vector<uint8_t> expected;
+  for (size_t i = 0; i + downsample <= full.size(); i += downsample) {
+    uint32_t sum = 0;
+    for (int j = 0; j < downsample; j++) sum += full[i + j];
+    expected.push_back((sum + downsample / 2) / downsample);
+  }
+
+  ale::ALEInterface ale;
+  configure(ale, downsample, expected.size());
+  ale::SoundCapture capture(ale.theSettings.get());
+  ALE_CHECK(capture.sampleRate() == Rate / (double)downsample);
+
+  for (const Write& w : writes()) {
+    capture.set(w.addr, w.value, w.cycle);
+  }
+  capture.update(EndCycle);
+
+  ALE_CHECK(std::equal(expected.begin(), expected.end(), capture.samples()));
+}
+
+}  // namespace
+
+int main() {
+  ale::Logger::setMode(ale::Logger::Error);
+
+  testMatchesTIASound();
+  testDownsample();
+  return ale::test::checkFailures();
+}
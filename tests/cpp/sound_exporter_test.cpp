@@ -0,0 +1,121 @@
+/* *****************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2013 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details.
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ *  sound_exporter_test.cpp
+ *
+ *  Tests that SoundExporter writes the same WAV file with and without its
+ *  background writer, and that the header is patched with the length of the
+ *  data written so far every 30 seconds of audio, before the exporter is
+ *  destroyed.
+ *
+ **************************************************************************** */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "ale/common/SoundExporter.hpp"
+#include "check.hpp"
+
+namespace fs = std::filesystem;
+using ale::sound::SoundExporter;
+
+namespace {
+
+// As in SoundExporter.cpp
+constexpr int kSampleRate = 60 * SoundExporter::SamplesPerFrame;
+constexpr int kHeaderSize = 44;
+
+std::vector<uint8_t> readFile(const fs::path& path) {
+  std::ifstream in(path, std::ios::binary);
+  return std::vector<uint8_t>(std::istreambuf_iterator<char>(in),
+                              std::istreambuf_iterator<char>());
+}
+
+uint32_t readInt(const std::vector<uint8_t>& bytes, size_t offset) {
+  uint32_t value = 0;
+  if (offset + 4 <= bytes.size()) std::memcpy(&value, &bytes[offset], 4);
+  return value;
+}
+
+// Whether the RIFF and data chunk sizes in the header are those of the given
+// number of samples
+bool headerHolds(const std::vector<uint8_t>& file, uint32_t samples) {
+  return std::memcmp(file.data(), "RIFF", 4) == 0 &&
+         readInt(file, 4) == 36 + samples &&
+         readInt(file, 24) == uint32_t(kSampleRate) &&
+         std::memcmp(file.data() + 36, "data", 4) == 0 &&
+         readInt(file, 40) == samples;
+}
+
+// Streams the samples one frame at a time, checking the header on disk
+// after 32 seconds, and returns the finished file.
+std::vector<uint8_t> exportSamples(const fs::path& path,
+                                   std::vector<uint8_t> samples,
+                                   bool background_writer) {
+  auto exporter =
+      std::make_unique<SoundExporter>(path.string(), 1, background_writer);
+
+  const size_t mid_run = size_t(kSampleRate) * 32;
+  for (size_t i = 0; i < samples.size(); i += SoundExporter::SamplesPerFrame) {
+    const size_t len =
+        std::min<size_t>(SoundExporter::SamplesPerFrame, samples.size() - i);
+    exporter->addSamples(&samples[i], int(len));
+
+    if (i + len == mid_run) {
+      // Handing over the 32nd second waited for the 31st to be written. The
+      // header was patched after 30 seconds and is not due again before 60.
+      const std::vector<uint8_t> file = readFile(path);
+      ALE_CHECK(file.size() >= kHeaderSize + size_t(kSampleRate) * 31);
+      ALE_CHECK(headerHolds(file, kSampleRate * 30));
+    }
+  }
+
+  exporter.reset();
+  return readFile(path);
+}
+
+void testBackgroundWriterMatchesInline() {
+  const fs::path dir = fs::temp_directory_path() / "ale-sound-exporter-test";
+  fs::create_directories(dir);
+
+  // 40 and a half seconds of noise, which does not end on a buffer boundary
+  std::vector<uint8_t> samples(size_t(kSampleRate) * 81 / 2);
+  std::mt19937 rng(0);
+  for (uint8_t& s : samples) s = uint8_t(rng());
+
+  const std::vector<uint8_t> inline_file =
+      exportSamples(dir / "inline.wav", samples, false);
+  const std::vector<uint8_t> background_file =
+      exportSamples(dir / "background.wav", samples, true);
+
+  ALE_CHECK(inline_file.size() == kHeaderSize + samples.size());
+  ALE_CHECK(headerHolds(inline_file, uint32_t(samples.size())));
+  ALE_CHECK(std::equal(samples.begin(), samples.end(),
+                       inline_file.begin() + kHeaderSize,
+                       inline_file.end()));
+  ALE_CHECK(background_file == inline_file);
+
+  fs::remove_all(dir);
+}
+
+}  // namespace
+
+int main() {
+  testBackgroundWriterMatchesInline();
+  return ale::test::checkFailures();
+}
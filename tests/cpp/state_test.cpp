@@ -0,0 +1,190 @@
+/* *****************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2013 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details.
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ *  state_test.cpp
+ *
+ *  Tests the format version of serialized states, and the reset cache on a
+ *  generated ROM that does not clear its RAM, where a cached reset is not
+ *  the same as a cold one (see "Reset Cache" in docs/env-spec.md). Also
+ *  checks that hashing or rolling out states needs a ROM.
+ *
+ **************************************************************************** */
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "ale/ale_interface.hpp"
+#include "ale/emucore/Serializer.hxx"
+#include "ale/environment/ale_state.hpp"
+#include "check.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// A 2K ROM that only clears Pong's scores (RAM 13 and 14) and mode (RAM
+// 0x16), keeping the rest of the RIOT RAM, stores the power-on timer in RAM 1
+// and adds one to RAM 0 every frame.
+std::vector<uint8_t> powerOnRamRom() {
+  const uint8_t code[] = {
+      0x78,              // F000 SEI
+      0xD8,              // F001 CLD
+      0xA2, 0xFF,        // F002 LDX #$FF
+      0x9A,              // F004 TXS
+      0xA9, 0x00,        // F005 LDA #0
+      0x85, 0x8D,        // F007 STA $8D
+      0x85, 0x8E,        // F009 STA $8E
+      0x85, 0x96,        // F00B STA $96
+      0xAD, 0x84, 0x02,  // F00D LDA INTIM
+      0x85, 0x81,        // F010 STA $81
+      0xA9, 0x02,        // F012 LDA #2          ; frame: start VSYNC
+      0x85, 0x00,        // F014 STA VSYNC
+      0x85, 0x02,        // F016 STA WSYNC
+      0x85, 0x02,        // F018 STA WSYNC
+      0x85, 0x02,        // F01A STA WSYNC
+      0xA9, 0x00,        // F01C LDA #0
+      0x85, 0x00,        // F01E STA VSYNC
+      0xE6, 0x80,        // F020 INC $80
+      0xA2, 0xC8,        // F022 LDX #200
+      0x85, 0x02,        // F024 STA WSYNC
+      0xCA,              // F026 DEX
+      0xD0, 0xFB,        // F027 BNE $F024
+      0x4C, 0x12, 0xF0,  // F029 JMP $F012
+  };
+
+  std::vector<uint8_t> rom(2048, 0xEA);
+  std::copy(std::begin(code), std::end(code), rom.begin());
+  rom[0x7FC] = 0x00;  // Reset vector
+  rom[0x7FD] = 0xF0;
+  rom[0x7FE] = 0x00;  // IRQ/BRK vector
+  rom[0x7FF] = 0xF0;
+  return rom;
+}
+
+// Steps both environments with no-ops, checking that their RAM stays equal
+bool stepEqually(ale::ALEInterface& a, ale::ALEInterface& b, int steps) {
+  bool equal = true;
+  for (int t = 0; t < steps; t++) {
+    a.act(ale::PLAYER_A_NOOP);
+    b.act(ale::PLAYER_A_NOOP);
+    equal = equal && a.getRAM().equals(b.getRAM());
+  }
+  return equal;
+}
+
+void testResetCacheKeepsPowerOnRam() {
+  const fs::path dir = fs::temp_directory_path() / "ale-state-test";
+  fs::create_directories(dir);
+  // Pong's settings are attached by name
+  const fs::path rom_path = dir / "pong.bin";
+  {
+    const std::vector<uint8_t> rom = powerOnRamRom();
+    std::ofstream out(rom_path, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(rom.data()), rom.size());
+  }
+
+  ale::ALEInterface cached, cold;
+  for (ale::ALEInterface* ale : {&cached, &cold}) {
+    ale->setInt("random_seed", 0);
+    ale->setFloat("repeat_action_probability", 0.0);
+  }
+  cached.setBool("reset_cache", true);
+  cached.loadROM(rom_path);
+  cold.loadROM(rom_path);
+
+  // The first reset is recorded, and is a cold reset
+  const ale::ALERAM first = cached.getRAM();
+  ALE_CHECK(first.equals(cold.getRAM()));
+  ALE_CHECK(stepEqually(cached, cold, 50));
+
+  // A cold reset keeps the RIOT RAM the last episode left, so the frame
+  // count in RAM 0 goes on, while a cached reset restores the RAM of the
+  // recorded one. Frame counters continue the same way.
+  cached.reset_game();
+  cold.reset_game();
+  ALE_CHECK(cached.getRAM().equals(first));
+  ALE_CHECK(cold.getRAM().get(0) != first.get(0));
+  ALE_CHECK(cached.getFrameNumber() == cold.getFrameNumber());
+  ALE_CHECK(cached.getEpisodeFrameNumber() == cold.getEpisodeFrameNumber());
+
+  // The console RNG was advanced as by a cold reset, so the next cold reset
+  // of another difficulty draws the same timer with or without the cache
+  cached.setDifficulty(1);
+  cold.setDifficulty(1);
+  cached.reset_game();
+  cold.reset_game();
+  ALE_CHECK(cached.getRAM().get(1) == cold.getRAM().get(1));
+  ALE_CHECK(cached.getRAM().get(1) != first.get(1));
+
+  fs::remove_all(dir);
+}
+
+void testStateFormatVersion() {
+  ale::ALEState state;
+  const std::string serialized = state.serialize();
+  ale::ALEState restored(serialized);
+  ALE_CHECK(restored.serialize() == serialized);
+
+  // States of earlier versions start with the left paddle resistance
+  ale::stella::Serializer old;
+  old.putInt(PADDLE_DEFAULT_VALUE);
+  old.putInt(PADDLE_DEFAULT_VALUE);
+  bool threw = false;
+  try {
+    ale::ALEState unversioned(old.get_str());
+  } catch (const std::runtime_error&) {
+    threw = true;
+  }
+  ALE_CHECK(threw);
+
+  // A future format version is refused too
+  std::string future = serialized;
+  future[4] = 2;
+  threw = false;
+  try {
+    ale::ALEState newer(future);
+  } catch (const std::runtime_error&) {
+    threw = true;
+  }
+  ALE_CHECK(threw);
+}
+
+void testWithoutRom() {
+  ale::ALEInterface ale;
+  bool threw = false;
+  try {
+    ale.stateHash();
+  } catch (const std::runtime_error&) {
+    threw = true;
+  }
+  ALE_CHECK(threw);
+
+  threw = false;
+  try {
+    ale.rollout(ale::ALEState(), ale::ActionVect{ale::PLAYER_A_NOOP});
+  } catch (const std::runtime_error&) {
+    threw = true;
+  }
+  ALE_CHECK(threw);
+}
+
+}  // namespace
+
+int main() {
+  ale::Logger::setMode(ale::Logger::Error);
+  testStateFormatVersion();
+  testResetCacheKeepsPowerOnRam();
+  testWithoutRom();
+  return ale::test::checkFailures();
+}
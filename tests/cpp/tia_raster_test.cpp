@@ -0,0 +1,134 @@
+/* *****************************************************************************
+ * A.L.E (Arcade Learning Environment)
+ * Copyright (c) 2009-2013 by Yavar Naddaf, Joel Veness, Marc G. Bellemare and
+ *   the Reinforcement Learning and Artificial Intelligence Laboratory
+ * Released under the GNU General Public License; see License.txt for details.
+ *
+ * Based on: Stella  --  "An Atari 2600 VCS Emulator"
+ * Copyright (c) 1995-2007 by Bradford W. Mott and the Stella team
+ *
+ * *****************************************************************************
+ *  tia_raster_test.cpp
+ *
+ *  Tests that the rasterizer picked for this CPU (AVX2 or SSSE3 on x86)
+ *  draws the same pixels and sets the same collisions as the scalar one,
+ *  on randomized scanline states and stretches.
+ *
+ **************************************************************************** */
+
+#include <cstdint>
+#include <cstring>
+#include <random>
+
+#include "ale/emucore/TIARaster.hxx"
+#include "check.hpp"
+
+using ale::stella::TIARasterizer;
+using ale::stella::TIARasterState;
+
+namespace {
+
+// A random scanline state, with the tables it points to
+struct RandomScanline {
+  uint32_t pfMask[160];
+  uint8_t p0Mask[160], p1Mask[160];
+  uint8_t m0Mask[160], m1Mask[160], blMask[160];
+  uint8_t colorIndex[2][64];
+  uint16_t collisionTable[64];
+  TIARasterState state;
+
+  explicit RandomScanline(std::mt19937& rng) {
+    auto bits = [&](int n) { return (uint32_t)(rng() & ((1u << n) - 1)); };
+    // Each object covers a random share of the pixels, so that objects
+    // overlap on some pixels and not on others
+    auto cover = [&](uint8_t* mask) {
+      const uint32_t density = bits(2);
+      for (int x = 0; x < 160; x++)
+        mask[x] = (bits(2) < density) ? (uint8_t)(1 << bits(3)) : 0;
+    };
+
+    for (int x = 0; x < 160; x++)
+      pfMask[x] = bits(1) ? (1u << bits(5)) : 0;
+    cover(p0Mask);
+    cover(p1Mask);
+    cover(m0Mask);
+    cover(m1Mask);
+    cover(blMask);
+
+    for (int half = 0; half < 2; half++)
+      for (int e = 0; e < 64; e++) colorIndex[half][e] = (uint8_t)bits(2);
+
+    // As in the TIA, each entry of the collision table is the union of the
+    // collision bits of the pairs of objects it contains
+    uint16_t pairBits[6][6];
+    for (int i = 0; i < 6; i++)
+      for (int j = i + 1; j < 6; j++) pairBits[i][j] = (uint16_t)bits(15);
+    for (int e = 0; e < 64; e++) {
+      collisionTable[e] = 0;
+      for (int i = 0; i < 6; i++)
+        for (int j = i + 1; j < 6; j++)
+          if ((e & (1 << i)) && (e & (1 << j)))
+            collisionTable[e] |= pairBits[i][j];
+    }
+
+    state.pfMask = pfMask;
+    state.pf = (uint32_t)rng();
+    state.p0Mask = p0Mask;
+    state.p1Mask = p1Mask;
+    state.grp0 = (uint8_t)bits(8);
+    state.grp1 = (uint8_t)bits(8);
+    state.m0Mask = m0Mask;
+    state.m1Mask = m1Mask;
+    state.blMask = blMask;
+    state.enabledObjects = (uint8_t)(bits(6) & 0x1a);  // M0, M1 and BL bits
+    state.colorIndex[0] = colorIndex[0];
+    state.colorIndex[1] = colorIndex[1];
+    for (int i = 0; i < 4; i++) state.colors[i] = (uint8_t)bits(8);
+    state.collisionTable = collisionTable;
+  }
+};
+
+void testMatchesScalar() {
+  const TIARasterizer scalar = ale::stella::tiaScalarRasterizer();
+  const TIARasterizer dispatched = ale::stella::tiaRasterizer();
+
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+  // Otherwise this would only compare the scalar rasterizer with itself
+  if (__builtin_cpu_supports("ssse3")) ALE_CHECK(dispatched != scalar);
+#endif
+
+  std::mt19937 rng(0);
+  int mismatches = 0;
+  for (int t = 0; t < 20000 && mismatches < 10; t++) {
+    const RandomScanline scanline(rng);
+
+    // Stretches of every length, some crossing the middle of the screen
+    // where the colour index table changes
+    const uint32_t hpos = rng() % 160;
+    const uint32_t count = 1 + rng() % (160 - hpos);
+
+    uint8_t expected[160 + 1], actual[160 + 1];
+    std::memset(expected, 0xAA, sizeof(expected));
+    std::memset(actual, 0xAA, sizeof(actual));
+    const uint16_t expectedCollision =
+        scalar(scanline.state, hpos, count, expected);
+    const uint16_t actualCollision =
+        dispatched(scanline.state, hpos, count, actual);
+
+    // Pixels past the stretch are left alone
+    const bool ok = (actualCollision == expectedCollision) &&
+                    std::memcmp(actual, expected, count + 1) == 0 &&
+                    dispatched(scanline.state, hpos, count, nullptr) ==
+                        expectedCollision;
+    ALE_CHECK(ok);
+    mismatches += !ok;
+  }
+}
+
+}  // namespace
+
+int main() {
+  testMatchesScalar();
+  return ale::test::checkFailures();
+}
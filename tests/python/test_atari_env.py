@@ -267,6 +267,22 @@ def test_gym_img_rgb_obs(tetris_env):
     assert obs.shape[-1] == 3
 
 
+@pytest.mark.parametrize("tetris_env", [{"obs_type": "indexed"}], indirect=True)
+def test_gym_img_indexed_obs(tetris_env):
+    tetris_env.reset()
+    obs, _, _, _, _ = tetris_env.step(0)
+    space = tetris_env.observation_space
+
+    assert isinstance(space, gymnasium.spaces.Box)
+    assert len(space.shape) == 2
+    assert space.dtype == np.uint8
+    assert obs.shape == space.shape
+
+    assert tetris_env.unwrapped.palette.shape == (256, 3)
+    rgb = tetris_env.unwrapped.ale.getScreenRGB()
+    assert (tetris_env.unwrapped.palette[obs] == rgb).all()
+
+
 @pytest.mark.parametrize("tetris_env", [{"full_action_space": True}], indirect=True)
 def test_gym_keys_to_action(tetris_env):
     keys_full_action_space = {
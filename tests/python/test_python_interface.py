@@ -1,6 +1,7 @@
 import os
 import pickle
 import tempfile
+from concurrent.futures import ThreadPoolExecutor
 
 import ale_py
 import numpy as np
@@ -168,6 +169,34 @@ def test_get_episode_frame_number(tetris):
     assert tetris.getEpisodeFrameNumber() == 10
 
 
+def test_emulation_counters(tetris):
+    instructions = tetris.getInstructionCount()
+    cycles = tetris.getCycleCount()
+    frames = tetris.getEmulatedFrameCount()
+    assert instructions > 0 and cycles > instructions
+
+    for _ in range(10):
+        tetris.act(0)
+    assert tetris.getEmulatedFrameCount() == frames + 10
+    assert tetris.getInstructionCount() > instructions
+    assert tetris.getCycleCount() > cycles
+    assert 200 <= tetris.getScanlinesPerFrame() <= 320
+
+
+def test_perf_stats(tetris):
+    tetris.resetPerfStats()
+    for _ in range(10):
+        tetris.act(0)
+    stats = tetris.getPerfStats()
+    assert stats.enabled == ale_py.PERF_STATS
+    if ale_py.PERF_STATS:
+        assert stats.frames == 10
+        assert stats.act_ns >= stats.emulate_ns > 0
+        assert stats.tia_clocks > 0
+    else:
+        assert stats.frames == 0 and stats.act_ns == 0
+
+
 def test_get_screen_dims(tetris):
     dims = tetris.getScreenDims()
     assert isinstance(dims, tuple)
@@ -213,6 +242,88 @@ def test_get_screen_grayscale(tetris):
     assert (preallocate == screen).all()
 
 
+def test_screen_and_ram_views(tetris, test_rom_path):
+    screen, ram = tetris.getScreenView(), tetris.getRAMView()
+    assert not screen.flags.writeable and not ram.flags.writeable
+    with pytest.raises(ValueError):
+        screen[0, 0] = 1
+
+    generation = tetris.getObservationGeneration()
+    for _ in range(10):
+        tetris.act(0)
+    assert tetris.getObservationGeneration() != generation
+    assert (screen == tetris.getScreen()).all()
+    assert (ram == tetris.getRAM()).all()
+
+    # The views keep the previous game's environment alive
+    last = screen.copy()
+    generation = tetris.getObservationGeneration()
+    tetris.loadROM(test_rom_path)
+    assert tetris.getObservationGeneration() != generation
+    assert (screen == last).all()
+
+
+def test_audio_capture(ale, test_rom_path):
+    ale.loadROM(test_rom_path)
+    assert ale.getAudio().shape == (0,)
+
+    # By default the samples of one act(), at 31400 Hz
+    ale.setBool("sound_capture", True)
+    ale.setInt("frame_skip", 4)
+    ale.loadROM(test_rom_path)
+    audio = ale.getAudioView()
+    assert audio.shape == (4 * 524,) and audio.dtype == np.uint8
+    assert not audio.flags.writeable
+
+    for _ in range(10):
+        ale.act(0)
+    assert (audio == ale.getAudio()).all()
+    # Tetris is silent
+    assert (audio == 128).all()
+
+    ale.setInt("sound_capture_downsample", 2)
+    ale.loadROM(test_rom_path)
+    assert ale.getAudio().shape == (4 * 262,)
+
+
+def test_concurrent_construction(test_rom_path):
+    def play(seed):
+        ale = ale_py.ALEInterface()
+        ale.setInt("random_seed", seed)
+        ale.setBool("color_averaging", seed % 2 == 0)
+        ale.loadROM(test_rom_path)
+        actions = ale.getMinimalActionSet()
+        for i in range(100):
+            ale.act(actions[(seed * 7 + i) % len(actions)])
+        return ale.stateHash(), ale.getScreen(), ale.getRAM()
+
+    # Environments built in parallel threads play as ones built one by one
+    seeds = range(64)
+    expected = [play(seed) for seed in seeds]
+    with ThreadPoolExecutor(max_workers=16) as pool:
+        results = list(pool.map(play, seeds))
+
+    for (state, screen, ram), (expected_state, expected_screen, expected_ram) in zip(
+        results, expected
+    ):
+        assert state == expected_state
+        assert (screen == expected_screen).all()
+        assert (ram == expected_ram).all()
+
+
+def test_get_palette_rgb(tetris, test_rom_path):
+    for _ in range(10):
+        tetris.act(0)
+
+    palette = tetris.getPaletteRGB()
+    assert palette.shape == (256, 3) and palette.dtype == np.uint8
+    assert (palette[tetris.getScreen()] == tetris.getScreenRGB()).all()
+
+    _, batch = make_tetris_batch(test_rom_path, 2, "indexed")
+    assert batch.getObservationShape() == tetris.getScreenDims()
+    assert (batch.getPaletteRGB() == palette).all()
+
+
 def test_save_screen_png(tetris):
     for _ in range(10):
         tetris.act(0)
@@ -409,3 +520,376 @@ def test_set_logger(ale):
     ale.setLoggerMode(ale_py.LoggerMode.Info)
     ale.setLoggerMode(ale_py.LoggerMode.Warning)
     ale.setLoggerMode(ale_py.LoggerMode.Error)
+
+
+def make_tetris_batch(test_rom_path, num_envs, obs_type="rgb"):
+    envs = []
+    for _ in range(num_envs):
+        env = ale_py.ALEInterface()
+        env.setInt("random_seed", 0)
+        env.loadROM(test_rom_path)
+        envs.append(env)
+    return envs, ale_py.ALEBatch(envs, obs_type)
+
+
+@pytest.mark.parametrize(
+    "obs_type, getter",
+    [
+        ("rgb", "getScreenRGB"),
+        ("grayscale", "getScreenGrayscale"),
+        ("ram", "getRAM"),
+        ("indexed", "getScreen"),
+    ],
+)
+def test_batch_step(test_rom_path, obs_type, getter):
+    envs, batch = make_tetris_batch(test_rom_path, 3, obs_type)
+    reference = ale_py.ALEInterface()
+    reference.setInt("random_seed", 0)
+    reference.loadROM(test_rom_path)
+    assert len(batch) == 3
+
+    obs = np.zeros((3,) + batch.getObservationShape(), dtype=np.uint8)
+    rewards = np.zeros(3, dtype=np.int32)
+    dones = np.zeros(3, dtype=np.bool_)
+    batch.reset(obs)
+    reference.reset_game()
+    for env_obs in obs:
+        assert (env_obs == getattr(reference, getter)()).all()
+
+    for t in range(50):
+        action = t % 5
+        batch.step(np.full(3, action), obs, rewards, dones)
+        reward = reference.act(action)
+        for i in range(3):
+            assert (obs[i] == getattr(reference, getter)()).all()
+            assert rewards[i] == reward
+            assert dones[i] == reference.game_over()
+
+
+def test_batch_invalid_buffers(test_rom_path):
+    envs, batch = make_tetris_batch(test_rom_path, 2)
+    obs = np.zeros((2,) + batch.getObservationShape(), dtype=np.uint8)
+    rewards = np.zeros(2, dtype=np.int32)
+    dones = np.zeros(2, dtype=np.bool_)
+
+    with pytest.raises(RuntimeError):
+        batch.step(np.zeros(3), obs, rewards, dones)
+    with pytest.raises(RuntimeError):
+        batch.step(np.zeros(2), obs[:1], rewards, dones)
+    with pytest.raises(TypeError):
+        batch.step(np.zeros(2), obs, rewards.astype(np.float32), dones)
+    with pytest.raises(ValueError):
+        batch.step(np.array([0, 18]), obs, rewards, dones)
+    with pytest.raises(ValueError):
+        batch.step(np.array([-1, 0]), obs, rewards, dones)
+    with pytest.raises(RuntimeError):
+        ale_py.ALEBatch(envs, "pixels")
+
+
+def test_async_batch_step(test_rom_path):
+    envs, batch = make_tetris_batch(test_rom_path, 4)
+    async_envs, _ = make_tetris_batch(test_rom_path, 4)
+    async_batch = ale_py.ALEAsyncBatch(async_envs, "rgb", num_threads=2)
+    assert len(async_batch) == 4
+    assert async_batch.getObservationShape() == batch.getObservationShape()
+
+    obs = np.zeros((4,) + batch.getObservationShape(), dtype=np.uint8)
+    rewards = np.zeros(4, dtype=np.int32)
+    dones = np.zeros(4, dtype=np.bool_)
+    batch.reset(obs)
+    async_obs = async_batch.reset()
+    assert (async_obs == obs).all()
+    assert not async_obs.flags.writeable
+
+    with pytest.raises(RuntimeError):
+        async_batch.step_wait()
+
+    for t in range(50):
+        actions = np.full(4, t % 5)
+        async_batch.step_async(actions)
+        with pytest.raises(RuntimeError):
+            async_batch.step_async(actions)
+        batch.step(actions, obs, rewards, dones)
+        async_obs, async_rewards, async_dones = async_batch.step_wait()
+        assert (async_obs == obs).all()
+        assert (async_rewards == rewards).all()
+        assert (async_dones == dones).all()
+
+    with pytest.raises(RuntimeError):
+        ale_py.ALEAsyncBatch([envs[0], envs[0]])
+
+
+def test_async_batch_dropped_while_pending(test_rom_path):
+    # The batch holds the only references to its environments, and must wait
+    # for the pending step before releasing them
+    async_batch = ale_py.ALEAsyncBatch(make_tetris_batch(test_rom_path, 4)[0])
+    async_batch.reset()
+    async_batch.step_async(np.zeros(4, dtype=np.int32))
+    del async_batch
+
+
+def test_env_pool(test_rom_path):
+    envs, _ = make_tetris_batch(test_rom_path, 6, "ram")
+    references = make_tetris_batch(test_rom_path, 6, "ram")[0]
+    pool = ale_py.ALEEnvPool(envs, batch_size=2, obs_type="ram", num_threads=3)
+    assert len(pool) == 6
+    assert pool.batch_size == 2
+
+    pool.async_reset()
+    for reference in references:
+        reference.reset_game()
+
+    seen = set()
+    for t in range(60):
+        obs, rewards, dones, env_ids = pool.recv()
+        assert len(env_ids) == 2
+        assert not obs.flags.writeable
+        for k, env_id in enumerate(env_ids):
+            reference = references[env_id]
+            assert (obs[k] == reference.getRAM()).all()
+            assert dones[k] == reference.game_over()
+            seen.add(int(env_id))
+
+        with pytest.raises(RuntimeError):
+            pool.send(np.zeros(1), np.array([env_ids[0] + 6]))
+        actions = np.full(2, t % 5)
+        for env_id, action in zip(env_ids, actions):
+            if references[env_id].game_over():
+                references[env_id].reset_game()
+            else:
+                references[env_id].act(action)
+        pool.send(actions, env_ids)
+    assert seen == set(range(6))
+
+    with pytest.raises(RuntimeError):
+        ale_py.ALEEnvPool([envs[0], envs[0]])
+
+
+def test_env_pool_dropped_in_flight(test_rom_path):
+    # The pool holds the only references to its environments, and must
+    # finish the environments in flight before releasing them
+    pool = ale_py.ALEEnvPool(make_tetris_batch(test_rom_path, 4)[0], batch_size=1)
+    pool.async_reset()
+    del pool
+
+
+def test_state_hash(test_rom_path):
+    envs = []
+    for _ in range(2):
+        env = ale_py.ALEInterface()
+        env.setInt("random_seed", 0)
+        env.setFloat("repeat_action_probability", 0.0)
+        env.loadROM(test_rom_path)
+        envs.append(env)
+    ale, other = envs
+
+    assert ale.stateHash() == other.stateHash()
+    actions = ale.getMinimalActionSet()
+    for t in range(200):
+        ale.act(actions[t % len(actions)])
+        other.act(actions[t % len(actions)])
+        assert ale.stateHash() == other.stateHash()
+
+    state = ale.cloneState()
+    state_hash = ale.stateHash()
+    assert 0 <= state_hash < 2**64
+    ale.act(actions[1])
+    assert ale.stateHash() != state_hash
+    ale.restoreState(state)
+    assert ale.stateHash() == state_hash
+
+
+def test_state_hash_sticky_actions(test_rom_path):
+    ale = ale_py.ALEInterface()
+    ale.setInt("random_seed", 0)
+    ale.setFloat("repeat_action_probability", 0.25)
+    ale.loadROM(test_rom_path)
+
+    # The restored state is the same, but the action that may be repeated
+    # next is not
+    state = ale.cloneState()
+    state_hash = ale.stateHash()
+    for _ in range(10):
+        ale.act(ale_py.Action.FIRE)
+    ale.restoreState(state)
+    assert ale.stateHash() != state_hash
+
+
+def test_skip_idle_loops(test_rom_path):
+    envs = []
+    for skip in (True, False):
+        env = ale_py.ALEInterface()
+        env.setBool("skip_idle_loops", skip)
+        env.setInt("random_seed", 0)
+        env.setFloat("repeat_action_probability", 0.0)
+        env.loadROM(test_rom_path)
+        envs.append(env)
+    fast, exact = envs
+
+    actions = fast.getMinimalActionSet()
+    for t in range(500):
+        action = actions[(t * 7) % len(actions)]
+        assert fast.act(action) == exact.act(action)
+        assert fast.stateHash() == exact.stateHash()
+        assert fast.getCycleCount() == exact.getCycleCount()
+        assert fast.getInstructionCount() == exact.getInstructionCount()
+        assert np.array_equal(fast.getScreen(), exact.getScreen())
+        if fast.game_over():
+            fast.reset_game()
+            exact.reset_game()
+
+def test_rollout(test_rom_path):
+    envs = []
+    for _ in range(4):
+        env = ale_py.ALEInterface()
+        env.setInt("random_seed", 0)
+        env.setFloat("repeat_action_probability", 0.0)
+        env.loadROM(test_rom_path)
+        envs.append(env)
+    ale = envs[0]
+
+    actions = ale.getMinimalActionSet()
+    for _ in range(50):
+        ale.act(actions[1])
+    root = ale.cloneState()
+
+    rng = np.random.default_rng(0)
+    sequences = [
+        [int(a) for a in rng.choice(actions, size=rng.integers(10, 2000))]
+        for _ in range(8)
+    ]
+
+    expected = []
+    for sequence in sequences:
+        ale.restoreState(root)
+        rewards = []
+        for action in sequence:
+            if ale.game_over():
+                break
+            rewards.append(ale.act(action))
+        expected.append((rewards, ale.game_over(), ale.cloneState()))
+
+    rewards, terminal, state = ale.rollout(root, sequences[0])
+    assert list(rewards) == expected[0][0]
+    assert terminal == expected[0][1]
+    assert state == expected[0][2]
+    _, _, state = ale.rollout(root, sequences[0], clone_final_state=False)
+    assert state is None
+
+    pool = ale_py.ALERolloutPool(envs[1:], num_threads=3)
+    assert len(pool) == 3
+    results = pool.rollout(root, sequences)
+    assert len(results) == len(sequences)
+    for (rewards, terminal, state), reference in zip(results, expected):
+        assert list(rewards) == reference[0]
+        assert terminal == reference[1]
+        assert state == reference[2]
+
+    with pytest.raises(RuntimeError):
+        ale_py.ALERolloutPool([envs[1], envs[1]])
+
+
+def test_reset_cache(test_rom_path):
+    cached = ale_py.ALEInterface()
+    cold = ale_py.ALEInterface()
+    for ale in (cached, cold):
+        ale.setInt("random_seed", 0)
+        ale.setFloat("repeat_action_probability", 0.0)
+        ale.setBool("color_averaging", True)
+    cached.setBool("reset_cache", True)
+    cached.loadROM(test_rom_path)
+    cold.loadROM(test_rom_path)
+
+    actions = cold.getMinimalActionSet()
+    rng = np.random.default_rng(0)
+    for episode in range(3):
+        cached.reset_game()
+        cold.reset_game()
+        for t in range(rng.integers(100, 300)):
+            assert (cached.getScreenRGB() == cold.getScreenRGB()).all()
+            assert (cached.getRAM() == cold.getRAM()).all()
+            assert cached.getFrameNumber() == cold.getFrameNumber()
+            assert cached.getEpisodeFrameNumber() == cold.getEpisodeFrameNumber()
+
+            action = actions[rng.integers(len(actions))]
+            assert cached.act(action) == cold.act(action)
+            assert cached.game_over() == cold.game_over()
+
+
+def test_noop_starts(test_rom_path):
+    ale = ale_py.ALEInterface()
+    ale.setInt("random_seed", 0)
+    ale.setInt("noop_max", 30)
+    ale.loadROM(test_rom_path)
+
+    episode_frames = set()
+    for _ in range(20):
+        ale.reset_game()
+        assert 0 <= ale.getEpisodeFrameNumber() <= 30
+        episode_frames.add(ale.getEpisodeFrameNumber())
+    assert len(episode_frames) > 1
+
+
+def test_start_state_bank(test_rom_path):
+    ale = ale_py.ALEInterface()
+    ale.setInt("random_seed", 0)
+    ale.setInt("noop_max", 30)
+    ale.setInt("num_start_states", 4)
+    ale.loadROM(test_rom_path)
+
+    rams = set()
+    frame_number = ale.getFrameNumber()
+    for _ in range(30):
+        ale.reset_game()
+        assert ale.getEpisodeFrameNumber() <= 30
+        assert ale.getFrameNumber() >= frame_number
+        frame_number = ale.getFrameNumber()
+        rams.add(ale.getRAM().tobytes())
+        for _ in range(10):
+            ale.act(0)
+    assert len(rams) <= 4
+
+
+@pytest.mark.skipif(not os.path.exists("/proc/self/statm"), reason="Needs /proc")
+def test_env_memory_footprint(test_rom_path):
+    def rss():
+        with open("/proc/self/statm") as f:
+            return int(f.read().split()[1]) * os.sysconf("SC_PAGE_SIZE")
+
+    def make_env():
+        ale = ale_py.ALEInterface()
+        ale.setBool("color_averaging", True)
+        ale.loadROM(test_rom_path)
+        ale.act(0)
+        return ale
+
+    # The first environment builds the tables shared by all of them
+    envs = [make_env()]
+    before = rss()
+    envs += [make_env() for _ in range(100)]
+    per_env = (rss() - before) / 100
+    assert per_env < 256 * 1024
+
+
+def test_multi_player_act(test_rom_path):
+    single = ale_py.ALEInterface()
+    multi = ale_py.ALEInterface()
+    for ale in (single, multi):
+        ale.setInt("random_seed", 7)
+        ale.loadROM(test_rom_path)
+
+    assert multi.getMaxPlayers() == 2
+    assert multi.getNumPlayers() == 1
+    actions = single.getMinimalActionSet()
+    for i in range(200):
+        action = actions[i % len(actions)]
+        rewards = multi.act([action, ale_py.Action.NOOP])
+        assert rewards.shape == (2,)
+        assert rewards[0] == single.act(action)
+        assert rewards[1] == 0
+    assert single.stateHash() == multi.stateHash()
+
+    with pytest.raises(RuntimeError):
+        multi.act([0, 0, 0])
+    with pytest.raises(RuntimeError):
+        multi.act([0, 0], [1.0])